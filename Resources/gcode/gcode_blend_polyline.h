@@ -0,0 +1,96 @@
+/*
+ * gcode_blend_polyline.h - data file containing gcode
+ *
+ * Polyline corners under G64 P - sharp, shallow and XZ corners at several
+ * feeds, for the posix-sim golden check of the inserted blend arcs. $jt is
+ * lowered so the corners are slow enough to be worth blending, and put back
+ * at the end. A G64 with a negative P or Q is refused with its move, so the
+ * G0 home runs from the end of N79
+ */
+
+const char PROGMEM gcode_file[] = "\
+$jt=0.5 (slow cornering, so blending pays)\n\
+N2 G21 G90 G17 (mm, absolute, XY plane)\n\
+N3 G64 P0.05 Q0 (blend polyline corners to within 0.05 mm - no merging)\n\
+N4 G0 X10 Y10 Z0\n\
+N5 F1500\n\
+N6 (square - 90 degree corners)\n\
+N7 G1 X60 Y10\n\
+N8 G1 X60 Y60\n\
+N9 G1 X10 Y60\n\
+N10 G1 X10 Y10\n\
+N11 (zig-zag - 45 and 135 degree corners)\n\
+N12 G1 X20 Y90\n\
+N13 G1 X30 Y70\n\
+N14 G1 X40 Y90\n\
+N15 G1 X50 Y70\n\
+N16 G1 X60 Y90\n\
+N17 G1 X70 Y70\n\
+N18 G1 X80 Y90\n\
+N19 G1 X90 Y70\n\
+N20 (five point star - 36 degree corners)\n\
+N21 G1 X150.0000 Y100.0000\n\
+N22 G1 X126.4886 Y27.6393\n\
+N23 G1 X188.0423 Y72.3607\n\
+N24 G1 X111.9577 Y72.3607\n\
+N25 G1 X173.5114 Y27.6393\n\
+N26 G1 X150.0000 Y100.0000\n\
+N27 (polygon of short segments - shallow corners)\n\
+N28 G1 X300.0000 Y60.0000\n\
+N29 G1 X299.3923 Y66.9459\n\
+N30 G1 X297.5877 Y73.6808\n\
+N31 G1 X294.6410 Y80.0000\n\
+N32 G1 X290.6418 Y85.7115\n\
+N33 G1 X285.7115 Y90.6418\n\
+N34 G1 X280.0000 Y94.6410\n\
+N35 G1 X273.6808 Y97.5877\n\
+N36 G1 X266.9459 Y99.3923\n\
+N37 G1 X260.0000 Y100.0000\n\
+N38 G1 X253.0541 Y99.3923\n\
+N39 G1 X246.3192 Y97.5877\n\
+N40 G1 X240.0000 Y94.6410\n\
+N41 G1 X234.2885 Y90.6418\n\
+N42 G1 X229.3582 Y85.7115\n\
+N43 G1 X225.3590 Y80.0000\n\
+N44 G1 X222.4123 Y73.6808\n\
+N45 G1 X220.6077 Y66.9459\n\
+N46 G1 X220.0000 Y60.0000\n\
+N47 G1 X220.6077 Y53.0541\n\
+N48 G1 X222.4123 Y46.3192\n\
+N49 G1 X225.3590 Y40.0000\n\
+N50 G1 X229.3582 Y34.2885\n\
+N51 G1 X234.2885 Y29.3582\n\
+N52 G1 X240.0000 Y25.3590\n\
+N53 G1 X246.3192 Y22.4123\n\
+N54 G1 X253.0541 Y20.6077\n\
+N55 G1 X260.0000 Y20.0000\n\
+N56 G1 X266.9459 Y20.6077\n\
+N57 G1 X273.6808 Y22.4123\n\
+N58 G1 X280.0000 Y25.3590\n\
+N59 G1 X285.7115 Y29.3582\n\
+N60 G1 X290.6418 Y34.2885\n\
+N61 G1 X294.6410 Y40.0000\n\
+N62 G1 X297.5877 Y46.3192\n\
+N63 G1 X299.3923 Y53.0541\n\
+N64 G1 X300.0000 Y60.0000\n\
+N65 (slow feed and a tighter tolerance)\n\
+N66 G64 P0.01 Q0 F600\n\
+N67 G1 X320 Y20\n\
+N68 G1 X340 Y40\n\
+N69 G1 X320 Y60\n\
+N70 G1 X340 Y80\n\
+N71 (corners in the XZ plane)\n\
+N72 G64 P0.05 Q0 F1000\n\
+N73 G1 X350 Z-5\n\
+N74 G1 X360 Z0\n\
+N75 G1 X370 Z-5\n\
+N76 G1 X380 Z0\n\
+N77 (back to exact path - no blends)\n\
+N78 G61\n\
+N79 G1 X380 Y10\n\
+N80 G64 P-1 G1 X300 Y10 (negative P - the whole block is refused)\n\
+N81 G64 Q-1 G1 X300 Y20 (negative Q - refused too)\n\
+N82 G0 X0 Y0 Z0\n\
+N83 M2\n\
+$jt=1.5 (back to the settings_test.h cornering)\n\
+";
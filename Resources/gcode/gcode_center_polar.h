@@ -0,0 +1,27 @@
+/*
+ * gcode_center_polar.h - data file containing gcode
+ *
+ * Lines on a polar machine that pass close to the center, where the bed turns fastest.
+ * Each is queued in pieces and only the piece nearest the center is slowed, more the
+ * closer it passes. The last line passes more than a radian (57.3 mm) away and isn't
+ * split. The arc is slowed to the bed's peak turn along it
+ */
+
+const char PROGMEM gcode_file[] = "\
+$kty=4\n\
+N1 G21 G90 G17 (mm, absolute, XY plane)\n\
+N2 F1500\n\
+N3 G1 X50 Y0 (leave the center along the bed angle)\n\
+N4 G1 X-50 Y2\n\
+N5 G1 X50 Y2 (2 mm from the center)\n\
+N6 G1 X50 Y-0.5\n\
+N7 G1 X-50 Y-0.5 (0.5 mm from the center)\n\
+N8 G1 X-50 Y50\n\
+N9 G1 X46 Y-40 (2.3 mm from the center, diagonally)\n\
+N10 G1 X50 Y60\n\
+N11 G1 X-50 Y60 (60 mm from the center - not split)\n\
+N12 G1 X20 Y5\n\
+N13 G2 X-20 Y5 I-20 J20 (arc 3.3 mm from the center)\n\
+N14 G0 X50 Y0\n\
+N15 M2\n\
+";
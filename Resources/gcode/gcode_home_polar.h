@@ -0,0 +1,25 @@
+/*
+ * gcode_home_polar.h - data file containing gcode
+ *
+ * Homes a polar machine from the origin, where it powers up. The homing moves
+ * start at the center, so they must not be reach tested. At the center the bed
+ * keeps its angle, and the tool can only leave along it - down -Y, where the Y
+ * search left it. Once homed a line through the center is refused with an error,
+ * and the moves after it still run
+ */
+
+const char PROGMEM gcode_file[] = "\
+$kty=4\n\
+N1 G21 G90 G17 (mm, absolute, XY plane)\n\
+N2 G28.2 X0 Y0 (home from the origin)\n\
+N3 F1500\n\
+N4 G1 X0 Y-50 (leave the center along the bed angle)\n\
+N5 G1 X150 Y100\n\
+N6 G1 X250 Y50\n\
+N7 G2 X300 Y100 I0 J50\n\
+N8 G1 X100 Y150\n\
+N9 G1 X-100 Y-150 (through the center - refused)\n\
+N10 G1 X50 Y150\n\
+N11 G0 X100 Y0\n\
+N12 M2\n\
+";
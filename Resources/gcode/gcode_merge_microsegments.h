@@ -0,0 +1,1492 @@
+/*
+ * gcode_merge_microsegments.h - data file containing gcode
+ *
+ * Dense runs of short, nearly collinear lines under G64 Q - straight, diagonal
+ * and gently curved - for the posix-sim golden check of collinear merging
+ */
+
+const char PROGMEM gcode_file[] = "\
+N1 G21 G90 G17 (mm, absolute, XY plane)\n\
+N2 G64 Q0.01 (merge collinear lines within 0.01 mm - no blending)\n\
+N3 G0 X10 Y20 Z0\n\
+N4 F1200\n\
+N5 (60 mm along X in 0.1 mm lines, a few microns of CAM noise)\n\
+N6 G1 X10.1000 Y20.0020\n\
+N7 G1 X10.2000 Y19.9990\n\
+N8 G1 X10.3000 Y20.0030\n\
+N9 G1 X10.4000 Y19.9980\n\
+N10 G1 X10.5000 Y20.0010\n\
+N11 G1 X10.6000 Y19.9970\n\
+N12 G1 X10.7000 Y20.0000\n\
+N13 G1 X10.8000 Y20.0000\n\
+N14 G1 X10.9000 Y20.0020\n\
+N15 G1 X11.0000 Y19.9990\n\
+N16 G1 X11.1000 Y20.0030\n\
+N17 G1 X11.2000 Y19.9980\n\
+N18 G1 X11.3000 Y20.0010\n\
+N19 G1 X11.4000 Y19.9970\n\
+N20 G1 X11.5000 Y20.0000\n\
+N21 G1 X11.6000 Y20.0000\n\
+N22 G1 X11.7000 Y20.0020\n\
+N23 G1 X11.8000 Y19.9990\n\
+N24 G1 X11.9000 Y20.0030\n\
+N25 G1 X12.0000 Y19.9980\n\
+N26 G1 X12.1000 Y20.0010\n\
+N27 G1 X12.2000 Y19.9970\n\
+N28 G1 X12.3000 Y20.0000\n\
+N29 G1 X12.4000 Y20.0000\n\
+N30 G1 X12.5000 Y20.0020\n\
+N31 G1 X12.6000 Y19.9990\n\
+N32 G1 X12.7000 Y20.0030\n\
+N33 G1 X12.8000 Y19.9980\n\
+N34 G1 X12.9000 Y20.0010\n\
+N35 G1 X13.0000 Y19.9970\n\
+N36 G1 X13.1000 Y20.0000\n\
+N37 G1 X13.2000 Y20.0000\n\
+N38 G1 X13.3000 Y20.0020\n\
+N39 G1 X13.4000 Y19.9990\n\
+N40 G1 X13.5000 Y20.0030\n\
+N41 G1 X13.6000 Y19.9980\n\
+N42 G1 X13.7000 Y20.0010\n\
+N43 G1 X13.8000 Y19.9970\n\
+N44 G1 X13.9000 Y20.0000\n\
+N45 G1 X14.0000 Y20.0000\n\
+N46 G1 X14.1000 Y20.0020\n\
+N47 G1 X14.2000 Y19.9990\n\
+N48 G1 X14.3000 Y20.0030\n\
+N49 G1 X14.4000 Y19.9980\n\
+N50 G1 X14.5000 Y20.0010\n\
+N51 G1 X14.6000 Y19.9970\n\
+N52 G1 X14.7000 Y20.0000\n\
+N53 G1 X14.8000 Y20.0000\n\
+N54 G1 X14.9000 Y20.0020\n\
+N55 G1 X15.0000 Y19.9990\n\
+N56 G1 X15.1000 Y20.0030\n\
+N57 G1 X15.2000 Y19.9980\n\
+N58 G1 X15.3000 Y20.0010\n\
+N59 G1 X15.4000 Y19.9970\n\
+N60 G1 X15.5000 Y20.0000\n\
+N61 G1 X15.6000 Y20.0000\n\
+N62 G1 X15.7000 Y20.0020\n\
+N63 G1 X15.8000 Y19.9990\n\
+N64 G1 X15.9000 Y20.0030\n\
+N65 G1 X16.0000 Y19.9980\n\
+N66 G1 X16.1000 Y20.0010\n\
+N67 G1 X16.2000 Y19.9970\n\
+N68 G1 X16.3000 Y20.0000\n\
+N69 G1 X16.4000 Y20.0000\n\
+N70 G1 X16.5000 Y20.0020\n\
+N71 G1 X16.6000 Y19.9990\n\
+N72 G1 X16.7000 Y20.0030\n\
+N73 G1 X16.8000 Y19.9980\n\
+N74 G1 X16.9000 Y20.0010\n\
+N75 G1 X17.0000 Y19.9970\n\
+N76 G1 X17.1000 Y20.0000\n\
+N77 G1 X17.2000 Y20.0000\n\
+N78 G1 X17.3000 Y20.0020\n\
+N79 G1 X17.4000 Y19.9990\n\
+N80 G1 X17.5000 Y20.0030\n\
+N81 G1 X17.6000 Y19.9980\n\
+N82 G1 X17.7000 Y20.0010\n\
+N83 G1 X17.8000 Y19.9970\n\
+N84 G1 X17.9000 Y20.0000\n\
+N85 G1 X18.0000 Y20.0000\n\
+N86 G1 X18.1000 Y20.0020\n\
+N87 G1 X18.2000 Y19.9990\n\
+N88 G1 X18.3000 Y20.0030\n\
+N89 G1 X18.4000 Y19.9980\n\
+N90 G1 X18.5000 Y20.0010\n\
+N91 G1 X18.6000 Y19.9970\n\
+N92 G1 X18.7000 Y20.0000\n\
+N93 G1 X18.8000 Y20.0000\n\
+N94 G1 X18.9000 Y20.0020\n\
+N95 G1 X19.0000 Y19.9990\n\
+N96 G1 X19.1000 Y20.0030\n\
+N97 G1 X19.2000 Y19.9980\n\
+N98 G1 X19.3000 Y20.0010\n\
+N99 G1 X19.4000 Y19.9970\n\
+N100 G1 X19.5000 Y20.0000\n\
+N101 G1 X19.6000 Y20.0000\n\
+N102 G1 X19.7000 Y20.0020\n\
+N103 G1 X19.8000 Y19.9990\n\
+N104 G1 X19.9000 Y20.0030\n\
+N105 G1 X20.0000 Y19.9980\n\
+N106 G1 X20.1000 Y20.0010\n\
+N107 G1 X20.2000 Y19.9970\n\
+N108 G1 X20.3000 Y20.0000\n\
+N109 G1 X20.4000 Y20.0000\n\
+N110 G1 X20.5000 Y20.0020\n\
+N111 G1 X20.6000 Y19.9990\n\
+N112 G1 X20.7000 Y20.0030\n\
+N113 G1 X20.8000 Y19.9980\n\
+N114 G1 X20.9000 Y20.0010\n\
+N115 G1 X21.0000 Y19.9970\n\
+N116 G1 X21.1000 Y20.0000\n\
+N117 G1 X21.2000 Y20.0000\n\
+N118 G1 X21.3000 Y20.0020\n\
+N119 G1 X21.4000 Y19.9990\n\
+N120 G1 X21.5000 Y20.0030\n\
+N121 G1 X21.6000 Y19.9980\n\
+N122 G1 X21.7000 Y20.0010\n\
+N123 G1 X21.8000 Y19.9970\n\
+N124 G1 X21.9000 Y20.0000\n\
+N125 G1 X22.0000 Y20.0000\n\
+N126 G1 X22.1000 Y20.0020\n\
+N127 G1 X22.2000 Y19.9990\n\
+N128 G1 X22.3000 Y20.0030\n\
+N129 G1 X22.4000 Y19.9980\n\
+N130 G1 X22.5000 Y20.0010\n\
+N131 G1 X22.6000 Y19.9970\n\
+N132 G1 X22.7000 Y20.0000\n\
+N133 G1 X22.8000 Y20.0000\n\
+N134 G1 X22.9000 Y20.0020\n\
+N135 G1 X23.0000 Y19.9990\n\
+N136 G1 X23.1000 Y20.0030\n\
+N137 G1 X23.2000 Y19.9980\n\
+N138 G1 X23.3000 Y20.0010\n\
+N139 G1 X23.4000 Y19.9970\n\
+N140 G1 X23.5000 Y20.0000\n\
+N141 G1 X23.6000 Y20.0000\n\
+N142 G1 X23.7000 Y20.0020\n\
+N143 G1 X23.8000 Y19.9990\n\
+N144 G1 X23.9000 Y20.0030\n\
+N145 G1 X24.0000 Y19.9980\n\
+N146 G1 X24.1000 Y20.0010\n\
+N147 G1 X24.2000 Y19.9970\n\
+N148 G1 X24.3000 Y20.0000\n\
+N149 G1 X24.4000 Y20.0000\n\
+N150 G1 X24.5000 Y20.0020\n\
+N151 G1 X24.6000 Y19.9990\n\
+N152 G1 X24.7000 Y20.0030\n\
+N153 G1 X24.8000 Y19.9980\n\
+N154 G1 X24.9000 Y20.0010\n\
+N155 G1 X25.0000 Y19.9970\n\
+N156 G1 X25.1000 Y20.0000\n\
+N157 G1 X25.2000 Y20.0000\n\
+N158 G1 X25.3000 Y20.0020\n\
+N159 G1 X25.4000 Y19.9990\n\
+N160 G1 X25.5000 Y20.0030\n\
+N161 G1 X25.6000 Y19.9980\n\
+N162 G1 X25.7000 Y20.0010\n\
+N163 G1 X25.8000 Y19.9970\n\
+N164 G1 X25.9000 Y20.0000\n\
+N165 G1 X26.0000 Y20.0000\n\
+N166 G1 X26.1000 Y20.0020\n\
+N167 G1 X26.2000 Y19.9990\n\
+N168 G1 X26.3000 Y20.0030\n\
+N169 G1 X26.4000 Y19.9980\n\
+N170 G1 X26.5000 Y20.0010\n\
+N171 G1 X26.6000 Y19.9970\n\
+N172 G1 X26.7000 Y20.0000\n\
+N173 G1 X26.8000 Y20.0000\n\
+N174 G1 X26.9000 Y20.0020\n\
+N175 G1 X27.0000 Y19.9990\n\
+N176 G1 X27.1000 Y20.0030\n\
+N177 G1 X27.2000 Y19.9980\n\
+N178 G1 X27.3000 Y20.0010\n\
+N179 G1 X27.4000 Y19.9970\n\
+N180 G1 X27.5000 Y20.0000\n\
+N181 G1 X27.6000 Y20.0000\n\
+N182 G1 X27.7000 Y20.0020\n\
+N183 G1 X27.8000 Y19.9990\n\
+N184 G1 X27.9000 Y20.0030\n\
+N185 G1 X28.0000 Y19.9980\n\
+N186 G1 X28.1000 Y20.0010\n\
+N187 G1 X28.2000 Y19.9970\n\
+N188 G1 X28.3000 Y20.0000\n\
+N189 G1 X28.4000 Y20.0000\n\
+N190 G1 X28.5000 Y20.0020\n\
+N191 G1 X28.6000 Y19.9990\n\
+N192 G1 X28.7000 Y20.0030\n\
+N193 G1 X28.8000 Y19.9980\n\
+N194 G1 X28.9000 Y20.0010\n\
+N195 G1 X29.0000 Y19.9970\n\
+N196 G1 X29.1000 Y20.0000\n\
+N197 G1 X29.2000 Y20.0000\n\
+N198 G1 X29.3000 Y20.0020\n\
+N199 G1 X29.4000 Y19.9990\n\
+N200 G1 X29.5000 Y20.0030\n\
+N201 G1 X29.6000 Y19.9980\n\
+N202 G1 X29.7000 Y20.0010\n\
+N203 G1 X29.8000 Y19.9970\n\
+N204 G1 X29.9000 Y20.0000\n\
+N205 G1 X30.0000 Y20.0000\n\
+N206 G1 X30.1000 Y20.0020\n\
+N207 G1 X30.2000 Y19.9990\n\
+N208 G1 X30.3000 Y20.0030\n\
+N209 G1 X30.4000 Y19.9980\n\
+N210 G1 X30.5000 Y20.0010\n\
+N211 G1 X30.6000 Y19.9970\n\
+N212 G1 X30.7000 Y20.0000\n\
+N213 G1 X30.8000 Y20.0000\n\
+N214 G1 X30.9000 Y20.0020\n\
+N215 G1 X31.0000 Y19.9990\n\
+N216 G1 X31.1000 Y20.0030\n\
+N217 G1 X31.2000 Y19.9980\n\
+N218 G1 X31.3000 Y20.0010\n\
+N219 G1 X31.4000 Y19.9970\n\
+N220 G1 X31.5000 Y20.0000\n\
+N221 G1 X31.6000 Y20.0000\n\
+N222 G1 X31.7000 Y20.0020\n\
+N223 G1 X31.8000 Y19.9990\n\
+N224 G1 X31.9000 Y20.0030\n\
+N225 G1 X32.0000 Y19.9980\n\
+N226 G1 X32.1000 Y20.0010\n\
+N227 G1 X32.2000 Y19.9970\n\
+N228 G1 X32.3000 Y20.0000\n\
+N229 G1 X32.4000 Y20.0000\n\
+N230 G1 X32.5000 Y20.0020\n\
+N231 G1 X32.6000 Y19.9990\n\
+N232 G1 X32.7000 Y20.0030\n\
+N233 G1 X32.8000 Y19.9980\n\
+N234 G1 X32.9000 Y20.0010\n\
+N235 G1 X33.0000 Y19.9970\n\
+N236 G1 X33.1000 Y20.0000\n\
+N237 G1 X33.2000 Y20.0000\n\
+N238 G1 X33.3000 Y20.0020\n\
+N239 G1 X33.4000 Y19.9990\n\
+N240 G1 X33.5000 Y20.0030\n\
+N241 G1 X33.6000 Y19.9980\n\
+N242 G1 X33.7000 Y20.0010\n\
+N243 G1 X33.8000 Y19.9970\n\
+N244 G1 X33.9000 Y20.0000\n\
+N245 G1 X34.0000 Y20.0000\n\
+N246 G1 X34.1000 Y20.0020\n\
+N247 G1 X34.2000 Y19.9990\n\
+N248 G1 X34.3000 Y20.0030\n\
+N249 G1 X34.4000 Y19.9980\n\
+N250 G1 X34.5000 Y20.0010\n\
+N251 G1 X34.6000 Y19.9970\n\
+N252 G1 X34.7000 Y20.0000\n\
+N253 G1 X34.8000 Y20.0000\n\
+N254 G1 X34.9000 Y20.0020\n\
+N255 G1 X35.0000 Y19.9990\n\
+N256 G1 X35.1000 Y20.0030\n\
+N257 G1 X35.2000 Y19.9980\n\
+N258 G1 X35.3000 Y20.0010\n\
+N259 G1 X35.4000 Y19.9970\n\
+N260 G1 X35.5000 Y20.0000\n\
+N261 G1 X35.6000 Y20.0000\n\
+N262 G1 X35.7000 Y20.0020\n\
+N263 G1 X35.8000 Y19.9990\n\
+N264 G1 X35.9000 Y20.0030\n\
+N265 G1 X36.0000 Y19.9980\n\
+N266 G1 X36.1000 Y20.0010\n\
+N267 G1 X36.2000 Y19.9970\n\
+N268 G1 X36.3000 Y20.0000\n\
+N269 G1 X36.4000 Y20.0000\n\
+N270 G1 X36.5000 Y20.0020\n\
+N271 G1 X36.6000 Y19.9990\n\
+N272 G1 X36.7000 Y20.0030\n\
+N273 G1 X36.8000 Y19.9980\n\
+N274 G1 X36.9000 Y20.0010\n\
+N275 G1 X37.0000 Y19.9970\n\
+N276 G1 X37.1000 Y20.0000\n\
+N277 G1 X37.2000 Y20.0000\n\
+N278 G1 X37.3000 Y20.0020\n\
+N279 G1 X37.4000 Y19.9990\n\
+N280 G1 X37.5000 Y20.0030\n\
+N281 G1 X37.6000 Y19.9980\n\
+N282 G1 X37.7000 Y20.0010\n\
+N283 G1 X37.8000 Y19.9970\n\
+N284 G1 X37.9000 Y20.0000\n\
+N285 G1 X38.0000 Y20.0000\n\
+N286 G1 X38.1000 Y20.0020\n\
+N287 G1 X38.2000 Y19.9990\n\
+N288 G1 X38.3000 Y20.0030\n\
+N289 G1 X38.4000 Y19.9980\n\
+N290 G1 X38.5000 Y20.0010\n\
+N291 G1 X38.6000 Y19.9970\n\
+N292 G1 X38.7000 Y20.0000\n\
+N293 G1 X38.8000 Y20.0000\n\
+N294 G1 X38.9000 Y20.0020\n\
+N295 G1 X39.0000 Y19.9990\n\
+N296 G1 X39.1000 Y20.0030\n\
+N297 G1 X39.2000 Y19.9980\n\
+N298 G1 X39.3000 Y20.0010\n\
+N299 G1 X39.4000 Y19.9970\n\
+N300 G1 X39.5000 Y20.0000\n\
+N301 G1 X39.6000 Y20.0000\n\
+N302 G1 X39.7000 Y20.0020\n\
+N303 G1 X39.8000 Y19.9990\n\
+N304 G1 X39.9000 Y20.0030\n\
+N305 G1 X40.0000 Y19.9980\n\
+N306 G1 X40.1000 Y20.0010\n\
+N307 G1 X40.2000 Y19.9970\n\
+N308 G1 X40.3000 Y20.0000\n\
+N309 G1 X40.4000 Y20.0000\n\
+N310 G1 X40.5000 Y20.0020\n\
+N311 G1 X40.6000 Y19.9990\n\
+N312 G1 X40.7000 Y20.0030\n\
+N313 G1 X40.8000 Y19.9980\n\
+N314 G1 X40.9000 Y20.0010\n\
+N315 G1 X41.0000 Y19.9970\n\
+N316 G1 X41.1000 Y20.0000\n\
+N317 G1 X41.2000 Y20.0000\n\
+N318 G1 X41.3000 Y20.0020\n\
+N319 G1 X41.4000 Y19.9990\n\
+N320 G1 X41.5000 Y20.0030\n\
+N321 G1 X41.6000 Y19.9980\n\
+N322 G1 X41.7000 Y20.0010\n\
+N323 G1 X41.8000 Y19.9970\n\
+N324 G1 X41.9000 Y20.0000\n\
+N325 G1 X42.0000 Y20.0000\n\
+N326 G1 X42.1000 Y20.0020\n\
+N327 G1 X42.2000 Y19.9990\n\
+N328 G1 X42.3000 Y20.0030\n\
+N329 G1 X42.4000 Y19.9980\n\
+N330 G1 X42.5000 Y20.0010\n\
+N331 G1 X42.6000 Y19.9970\n\
+N332 G1 X42.7000 Y20.0000\n\
+N333 G1 X42.8000 Y20.0000\n\
+N334 G1 X42.9000 Y20.0020\n\
+N335 G1 X43.0000 Y19.9990\n\
+N336 G1 X43.1000 Y20.0030\n\
+N337 G1 X43.2000 Y19.9980\n\
+N338 G1 X43.3000 Y20.0010\n\
+N339 G1 X43.4000 Y19.9970\n\
+N340 G1 X43.5000 Y20.0000\n\
+N341 G1 X43.6000 Y20.0000\n\
+N342 G1 X43.7000 Y20.0020\n\
+N343 G1 X43.8000 Y19.9990\n\
+N344 G1 X43.9000 Y20.0030\n\
+N345 G1 X44.0000 Y19.9980\n\
+N346 G1 X44.1000 Y20.0010\n\
+N347 G1 X44.2000 Y19.9970\n\
+N348 G1 X44.3000 Y20.0000\n\
+N349 G1 X44.4000 Y20.0000\n\
+N350 G1 X44.5000 Y20.0020\n\
+N351 G1 X44.6000 Y19.9990\n\
+N352 G1 X44.7000 Y20.0030\n\
+N353 G1 X44.8000 Y19.9980\n\
+N354 G1 X44.9000 Y20.0010\n\
+N355 G1 X45.0000 Y19.9970\n\
+N356 G1 X45.1000 Y20.0000\n\
+N357 G1 X45.2000 Y20.0000\n\
+N358 G1 X45.3000 Y20.0020\n\
+N359 G1 X45.4000 Y19.9990\n\
+N360 G1 X45.5000 Y20.0030\n\
+N361 G1 X45.6000 Y19.9980\n\
+N362 G1 X45.7000 Y20.0010\n\
+N363 G1 X45.8000 Y19.9970\n\
+N364 G1 X45.9000 Y20.0000\n\
+N365 G1 X46.0000 Y20.0000\n\
+N366 G1 X46.1000 Y20.0020\n\
+N367 G1 X46.2000 Y19.9990\n\
+N368 G1 X46.3000 Y20.0030\n\
+N369 G1 X46.4000 Y19.9980\n\
+N370 G1 X46.5000 Y20.0010\n\
+N371 G1 X46.6000 Y19.9970\n\
+N372 G1 X46.7000 Y20.0000\n\
+N373 G1 X46.8000 Y20.0000\n\
+N374 G1 X46.9000 Y20.0020\n\
+N375 G1 X47.0000 Y19.9990\n\
+N376 G1 X47.1000 Y20.0030\n\
+N377 G1 X47.2000 Y19.9980\n\
+N378 G1 X47.3000 Y20.0010\n\
+N379 G1 X47.4000 Y19.9970\n\
+N380 G1 X47.5000 Y20.0000\n\
+N381 G1 X47.6000 Y20.0000\n\
+N382 G1 X47.7000 Y20.0020\n\
+N383 G1 X47.8000 Y19.9990\n\
+N384 G1 X47.9000 Y20.0030\n\
+N385 G1 X48.0000 Y19.9980\n\
+N386 G1 X48.1000 Y20.0010\n\
+N387 G1 X48.2000 Y19.9970\n\
+N388 G1 X48.3000 Y20.0000\n\
+N389 G1 X48.4000 Y20.0000\n\
+N390 G1 X48.5000 Y20.0020\n\
+N391 G1 X48.6000 Y19.9990\n\
+N392 G1 X48.7000 Y20.0030\n\
+N393 G1 X48.8000 Y19.9980\n\
+N394 G1 X48.9000 Y20.0010\n\
+N395 G1 X49.0000 Y19.9970\n\
+N396 G1 X49.1000 Y20.0000\n\
+N397 G1 X49.2000 Y20.0000\n\
+N398 G1 X49.3000 Y20.0020\n\
+N399 G1 X49.4000 Y19.9990\n\
+N400 G1 X49.5000 Y20.0030\n\
+N401 G1 X49.6000 Y19.9980\n\
+N402 G1 X49.7000 Y20.0010\n\
+N403 G1 X49.8000 Y19.9970\n\
+N404 G1 X49.9000 Y20.0000\n\
+N405 G1 X50.0000 Y20.0000\n\
+N406 G1 X50.1000 Y20.0020\n\
+N407 G1 X50.2000 Y19.9990\n\
+N408 G1 X50.3000 Y20.0030\n\
+N409 G1 X50.4000 Y19.9980\n\
+N410 G1 X50.5000 Y20.0010\n\
+N411 G1 X50.6000 Y19.9970\n\
+N412 G1 X50.7000 Y20.0000\n\
+N413 G1 X50.8000 Y20.0000\n\
+N414 G1 X50.9000 Y20.0020\n\
+N415 G1 X51.0000 Y19.9990\n\
+N416 G1 X51.1000 Y20.0030\n\
+N417 G1 X51.2000 Y19.9980\n\
+N418 G1 X51.3000 Y20.0010\n\
+N419 G1 X51.4000 Y19.9970\n\
+N420 G1 X51.5000 Y20.0000\n\
+N421 G1 X51.6000 Y20.0000\n\
+N422 G1 X51.7000 Y20.0020\n\
+N423 G1 X51.8000 Y19.9990\n\
+N424 G1 X51.9000 Y20.0030\n\
+N425 G1 X52.0000 Y19.9980\n\
+N426 G1 X52.1000 Y20.0010\n\
+N427 G1 X52.2000 Y19.9970\n\
+N428 G1 X52.3000 Y20.0000\n\
+N429 G1 X52.4000 Y20.0000\n\
+N430 G1 X52.5000 Y20.0020\n\
+N431 G1 X52.6000 Y19.9990\n\
+N432 G1 X52.7000 Y20.0030\n\
+N433 G1 X52.8000 Y19.9980\n\
+N434 G1 X52.9000 Y20.0010\n\
+N435 G1 X53.0000 Y19.9970\n\
+N436 G1 X53.1000 Y20.0000\n\
+N437 G1 X53.2000 Y20.0000\n\
+N438 G1 X53.3000 Y20.0020\n\
+N439 G1 X53.4000 Y19.9990\n\
+N440 G1 X53.5000 Y20.0030\n\
+N441 G1 X53.6000 Y19.9980\n\
+N442 G1 X53.7000 Y20.0010\n\
+N443 G1 X53.8000 Y19.9970\n\
+N444 G1 X53.9000 Y20.0000\n\
+N445 G1 X54.0000 Y20.0000\n\
+N446 G1 X54.1000 Y20.0020\n\
+N447 G1 X54.2000 Y19.9990\n\
+N448 G1 X54.3000 Y20.0030\n\
+N449 G1 X54.4000 Y19.9980\n\
+N450 G1 X54.5000 Y20.0010\n\
+N451 G1 X54.6000 Y19.9970\n\
+N452 G1 X54.7000 Y20.0000\n\
+N453 G1 X54.8000 Y20.0000\n\
+N454 G1 X54.9000 Y20.0020\n\
+N455 G1 X55.0000 Y19.9990\n\
+N456 G1 X55.1000 Y20.0030\n\
+N457 G1 X55.2000 Y19.9980\n\
+N458 G1 X55.3000 Y20.0010\n\
+N459 G1 X55.4000 Y19.9970\n\
+N460 G1 X55.5000 Y20.0000\n\
+N461 G1 X55.6000 Y20.0000\n\
+N462 G1 X55.7000 Y20.0020\n\
+N463 G1 X55.8000 Y19.9990\n\
+N464 G1 X55.9000 Y20.0030\n\
+N465 G1 X56.0000 Y19.9980\n\
+N466 G1 X56.1000 Y20.0010\n\
+N467 G1 X56.2000 Y19.9970\n\
+N468 G1 X56.3000 Y20.0000\n\
+N469 G1 X56.4000 Y20.0000\n\
+N470 G1 X56.5000 Y20.0020\n\
+N471 G1 X56.6000 Y19.9990\n\
+N472 G1 X56.7000 Y20.0030\n\
+N473 G1 X56.8000 Y19.9980\n\
+N474 G1 X56.9000 Y20.0010\n\
+N475 G1 X57.0000 Y19.9970\n\
+N476 G1 X57.1000 Y20.0000\n\
+N477 G1 X57.2000 Y20.0000\n\
+N478 G1 X57.3000 Y20.0020\n\
+N479 G1 X57.4000 Y19.9990\n\
+N480 G1 X57.5000 Y20.0030\n\
+N481 G1 X57.6000 Y19.9980\n\
+N482 G1 X57.7000 Y20.0010\n\
+N483 G1 X57.8000 Y19.9970\n\
+N484 G1 X57.9000 Y20.0000\n\
+N485 G1 X58.0000 Y20.0000\n\
+N486 G1 X58.1000 Y20.0020\n\
+N487 G1 X58.2000 Y19.9990\n\
+N488 G1 X58.3000 Y20.0030\n\
+N489 G1 X58.4000 Y19.9980\n\
+N490 G1 X58.5000 Y20.0010\n\
+N491 G1 X58.6000 Y19.9970\n\
+N492 G1 X58.7000 Y20.0000\n\
+N493 G1 X58.8000 Y20.0000\n\
+N494 G1 X58.9000 Y20.0020\n\
+N495 G1 X59.0000 Y19.9990\n\
+N496 G1 X59.1000 Y20.0030\n\
+N497 G1 X59.2000 Y19.9980\n\
+N498 G1 X59.3000 Y20.0010\n\
+N499 G1 X59.4000 Y19.9970\n\
+N500 G1 X59.5000 Y20.0000\n\
+N501 G1 X59.6000 Y20.0000\n\
+N502 G1 X59.7000 Y20.0020\n\
+N503 G1 X59.8000 Y19.9990\n\
+N504 G1 X59.9000 Y20.0030\n\
+N505 G1 X60.0000 Y19.9980\n\
+N506 G1 X60.1000 Y20.0010\n\
+N507 G1 X60.2000 Y19.9970\n\
+N508 G1 X60.3000 Y20.0000\n\
+N509 G1 X60.4000 Y20.0000\n\
+N510 G1 X60.5000 Y20.0020\n\
+N511 G1 X60.6000 Y19.9990\n\
+N512 G1 X60.7000 Y20.0030\n\
+N513 G1 X60.8000 Y19.9980\n\
+N514 G1 X60.9000 Y20.0010\n\
+N515 G1 X61.0000 Y19.9970\n\
+N516 G1 X61.1000 Y20.0000\n\
+N517 G1 X61.2000 Y20.0000\n\
+N518 G1 X61.3000 Y20.0020\n\
+N519 G1 X61.4000 Y19.9990\n\
+N520 G1 X61.5000 Y20.0030\n\
+N521 G1 X61.6000 Y19.9980\n\
+N522 G1 X61.7000 Y20.0010\n\
+N523 G1 X61.8000 Y19.9970\n\
+N524 G1 X61.9000 Y20.0000\n\
+N525 G1 X62.0000 Y20.0000\n\
+N526 G1 X62.1000 Y20.0020\n\
+N527 G1 X62.2000 Y19.9990\n\
+N528 G1 X62.3000 Y20.0030\n\
+N529 G1 X62.4000 Y19.9980\n\
+N530 G1 X62.5000 Y20.0010\n\
+N531 G1 X62.6000 Y19.9970\n\
+N532 G1 X62.7000 Y20.0000\n\
+N533 G1 X62.8000 Y20.0000\n\
+N534 G1 X62.9000 Y20.0020\n\
+N535 G1 X63.0000 Y19.9990\n\
+N536 G1 X63.1000 Y20.0030\n\
+N537 G1 X63.2000 Y19.9980\n\
+N538 G1 X63.3000 Y20.0010\n\
+N539 G1 X63.4000 Y19.9970\n\
+N540 G1 X63.5000 Y20.0000\n\
+N541 G1 X63.6000 Y20.0000\n\
+N542 G1 X63.7000 Y20.0020\n\
+N543 G1 X63.8000 Y19.9990\n\
+N544 G1 X63.9000 Y20.0030\n\
+N545 G1 X64.0000 Y19.9980\n\
+N546 G1 X64.1000 Y20.0010\n\
+N547 G1 X64.2000 Y19.9970\n\
+N548 G1 X64.3000 Y20.0000\n\
+N549 G1 X64.4000 Y20.0000\n\
+N550 G1 X64.5000 Y20.0020\n\
+N551 G1 X64.6000 Y19.9990\n\
+N552 G1 X64.7000 Y20.0030\n\
+N553 G1 X64.8000 Y19.9980\n\
+N554 G1 X64.9000 Y20.0010\n\
+N555 G1 X65.0000 Y19.9970\n\
+N556 G1 X65.1000 Y20.0000\n\
+N557 G1 X65.2000 Y20.0000\n\
+N558 G1 X65.3000 Y20.0020\n\
+N559 G1 X65.4000 Y19.9990\n\
+N560 G1 X65.5000 Y20.0030\n\
+N561 G1 X65.6000 Y19.9980\n\
+N562 G1 X65.7000 Y20.0010\n\
+N563 G1 X65.8000 Y19.9970\n\
+N564 G1 X65.9000 Y20.0000\n\
+N565 G1 X66.0000 Y20.0000\n\
+N566 G1 X66.1000 Y20.0020\n\
+N567 G1 X66.2000 Y19.9990\n\
+N568 G1 X66.3000 Y20.0030\n\
+N569 G1 X66.4000 Y19.9980\n\
+N570 G1 X66.5000 Y20.0010\n\
+N571 G1 X66.6000 Y19.9970\n\
+N572 G1 X66.7000 Y20.0000\n\
+N573 G1 X66.8000 Y20.0000\n\
+N574 G1 X66.9000 Y20.0020\n\
+N575 G1 X67.0000 Y19.9990\n\
+N576 G1 X67.1000 Y20.0030\n\
+N577 G1 X67.2000 Y19.9980\n\
+N578 G1 X67.3000 Y20.0010\n\
+N579 G1 X67.4000 Y19.9970\n\
+N580 G1 X67.5000 Y20.0000\n\
+N581 G1 X67.6000 Y20.0000\n\
+N582 G1 X67.7000 Y20.0020\n\
+N583 G1 X67.8000 Y19.9990\n\
+N584 G1 X67.9000 Y20.0030\n\
+N585 G1 X68.0000 Y19.9980\n\
+N586 G1 X68.1000 Y20.0010\n\
+N587 G1 X68.2000 Y19.9970\n\
+N588 G1 X68.3000 Y20.0000\n\
+N589 G1 X68.4000 Y20.0000\n\
+N590 G1 X68.5000 Y20.0020\n\
+N591 G1 X68.6000 Y19.9990\n\
+N592 G1 X68.7000 Y20.0030\n\
+N593 G1 X68.8000 Y19.9980\n\
+N594 G1 X68.9000 Y20.0010\n\
+N595 G1 X69.0000 Y19.9970\n\
+N596 G1 X69.1000 Y20.0000\n\
+N597 G1 X69.2000 Y20.0000\n\
+N598 G1 X69.3000 Y20.0020\n\
+N599 G1 X69.4000 Y19.9990\n\
+N600 G1 X69.5000 Y20.0030\n\
+N601 G1 X69.6000 Y19.9980\n\
+N602 G1 X69.7000 Y20.0010\n\
+N603 G1 X69.8000 Y19.9970\n\
+N604 G1 X69.9000 Y20.0000\n\
+N605 G1 X70.0000 Y20.0000\n\
+N606 (40 mm diagonal in 0.1 mm lines)\n\
+N607 G1 X70.0707 Y20.0727\n\
+N608 G1 X70.1414 Y20.1404\n\
+N609 G1 X70.2121 Y20.2151\n\
+N610 G1 X70.2828 Y20.2808\n\
+N611 G1 X70.3536 Y20.3546\n\
+N612 G1 X70.4243 Y20.4213\n\
+N613 G1 X70.4950 Y20.4950\n\
+N614 G1 X70.5657 Y20.5657\n\
+N615 G1 X70.6364 Y20.6384\n\
+N616 G1 X70.7071 Y20.7061\n\
+N617 G1 X70.7778 Y20.7808\n\
+N618 G1 X70.8485 Y20.8465\n\
+N619 G1 X70.9192 Y20.9202\n\
+N620 G1 X70.9899 Y20.9869\n\
+N621 G1 X71.0607 Y21.0607\n\
+N622 G1 X71.1314 Y21.1314\n\
+N623 G1 X71.2021 Y21.2041\n\
+N624 G1 X71.2728 Y21.2718\n\
+N625 G1 X71.3435 Y21.3465\n\
+N626 G1 X71.4142 Y21.4122\n\
+N627 G1 X71.4849 Y21.4859\n\
+N628 G1 X71.5556 Y21.5526\n\
+N629 G1 X71.6263 Y21.6263\n\
+N630 G1 X71.6971 Y21.6971\n\
+N631 G1 X71.7678 Y21.7698\n\
+N632 G1 X71.8385 Y21.8375\n\
+N633 G1 X71.9092 Y21.9122\n\
+N634 G1 X71.9799 Y21.9779\n\
+N635 G1 X72.0506 Y22.0516\n\
+N636 G1 X72.1213 Y22.1183\n\
+N637 G1 X72.1920 Y22.1920\n\
+N638 G1 X72.2627 Y22.2627\n\
+N639 G1 X72.3335 Y22.3355\n\
+N640 G1 X72.4042 Y22.4032\n\
+N641 G1 X72.4749 Y22.4779\n\
+N642 G1 X72.5456 Y22.5436\n\
+N643 G1 X72.6163 Y22.6173\n\
+N644 G1 X72.6870 Y22.6840\n\
+N645 G1 X72.7577 Y22.7577\n\
+N646 G1 X72.8284 Y22.8284\n\
+N647 G1 X72.8991 Y22.9011\n\
+N648 G1 X72.9698 Y22.9688\n\
+N649 G1 X73.0406 Y23.0436\n\
+N650 G1 X73.1113 Y23.1093\n\
+N651 G1 X73.1820 Y23.1830\n\
+N652 G1 X73.2527 Y23.2497\n\
+N653 G1 X73.3234 Y23.3234\n\
+N654 G1 X73.3941 Y23.3941\n\
+N655 G1 X73.4648 Y23.4668\n\
+N656 G1 X73.5355 Y23.5345\n\
+N657 G1 X73.6062 Y23.6092\n\
+N658 G1 X73.6770 Y23.6750\n\
+N659 G1 X73.7477 Y23.7487\n\
+N660 G1 X73.8184 Y23.8154\n\
+N661 G1 X73.8891 Y23.8891\n\
+N662 G1 X73.9598 Y23.9598\n\
+N663 G1 X74.0305 Y24.0325\n\
+N664 G1 X74.1012 Y24.1002\n\
+N665 G1 X74.1719 Y24.1749\n\
+N666 G1 X74.2426 Y24.2406\n\
+N667 G1 X74.3134 Y24.3144\n\
+N668 G1 X74.3841 Y24.3811\n\
+N669 G1 X74.4548 Y24.4548\n\
+N670 G1 X74.5255 Y24.5255\n\
+N671 G1 X74.5962 Y24.5982\n\
+N672 G1 X74.6669 Y24.6659\n\
+N673 G1 X74.7376 Y24.7406\n\
+N674 G1 X74.8083 Y24.8063\n\
+N675 G1 X74.8790 Y24.8800\n\
+N676 G1 X74.9497 Y24.9467\n\
+N677 G1 X75.0205 Y25.0205\n\
+N678 G1 X75.0912 Y25.0912\n\
+N679 G1 X75.1619 Y25.1639\n\
+N680 G1 X75.2326 Y25.2316\n\
+N681 G1 X75.3033 Y25.3063\n\
+N682 G1 X75.3740 Y25.3720\n\
+N683 G1 X75.4447 Y25.4457\n\
+N684 G1 X75.5154 Y25.5124\n\
+N685 G1 X75.5861 Y25.5861\n\
+N686 G1 X75.6569 Y25.6569\n\
+N687 G1 X75.7276 Y25.7296\n\
+N688 G1 X75.7983 Y25.7973\n\
+N689 G1 X75.8690 Y25.8720\n\
+N690 G1 X75.9397 Y25.9377\n\
+N691 G1 X76.0104 Y26.0114\n\
+N692 G1 X76.0811 Y26.0781\n\
+N693 G1 X76.1518 Y26.1518\n\
+N694 G1 X76.2225 Y26.2225\n\
+N695 G1 X76.2933 Y26.2953\n\
+N696 G1 X76.3640 Y26.3630\n\
+N697 G1 X76.4347 Y26.4377\n\
+N698 G1 X76.5054 Y26.5034\n\
+N699 G1 X76.5761 Y26.5771\n\
+N700 G1 X76.6468 Y26.6438\n\
+N701 G1 X76.7175 Y26.7175\n\
+N702 G1 X76.7882 Y26.7882\n\
+N703 G1 X76.8589 Y26.8609\n\
+N704 G1 X76.9296 Y26.9286\n\
+N705 G1 X77.0004 Y27.0034\n\
+N706 G1 X77.0711 Y27.0691\n\
+N707 G1 X77.1418 Y27.1428\n\
+N708 G1 X77.2125 Y27.2095\n\
+N709 G1 X77.2832 Y27.2832\n\
+N710 G1 X77.3539 Y27.3539\n\
+N711 G1 X77.4246 Y27.4266\n\
+N712 G1 X77.4953 Y27.4943\n\
+N713 G1 X77.5660 Y27.5690\n\
+N714 G1 X77.6368 Y27.6348\n\
+N715 G1 X77.7075 Y27.7085\n\
+N716 G1 X77.7782 Y27.7752\n\
+N717 G1 X77.8489 Y27.8489\n\
+N718 G1 X77.9196 Y27.9196\n\
+N719 G1 X77.9903 Y27.9923\n\
+N720 G1 X78.0610 Y28.0600\n\
+N721 G1 X78.1317 Y28.1347\n\
+N722 G1 X78.2024 Y28.2004\n\
+N723 G1 X78.2731 Y28.2741\n\
+N724 G1 X78.3439 Y28.3409\n\
+N725 G1 X78.4146 Y28.4146\n\
+N726 G1 X78.4853 Y28.4853\n\
+N727 G1 X78.5560 Y28.5580\n\
+N728 G1 X78.6267 Y28.6257\n\
+N729 G1 X78.6974 Y28.7004\n\
+N730 G1 X78.7681 Y28.7661\n\
+N731 G1 X78.8388 Y28.8398\n\
+N732 G1 X78.9095 Y28.9065\n\
+N733 G1 X78.9803 Y28.9803\n\
+N734 G1 X79.0510 Y29.0510\n\
+N735 G1 X79.1217 Y29.1237\n\
+N736 G1 X79.1924 Y29.1914\n\
+N737 G1 X79.2631 Y29.2661\n\
+N738 G1 X79.3338 Y29.3318\n\
+N739 G1 X79.4045 Y29.4055\n\
+N740 G1 X79.4752 Y29.4722\n\
+N741 G1 X79.5459 Y29.5459\n\
+N742 G1 X79.6167 Y29.6167\n\
+N743 G1 X79.6874 Y29.6894\n\
+N744 G1 X79.7581 Y29.7571\n\
+N745 G1 X79.8288 Y29.8318\n\
+N746 G1 X79.8995 Y29.8975\n\
+N747 G1 X79.9702 Y29.9712\n\
+N748 G1 X80.0409 Y30.0379\n\
+N749 G1 X80.1116 Y30.1116\n\
+N750 G1 X80.1823 Y30.1823\n\
+N751 G1 X80.2530 Y30.2550\n\
+N752 G1 X80.3238 Y30.3228\n\
+N753 G1 X80.3945 Y30.3975\n\
+N754 G1 X80.4652 Y30.4632\n\
+N755 G1 X80.5359 Y30.5369\n\
+N756 G1 X80.6066 Y30.6036\n\
+N757 G1 X80.6773 Y30.6773\n\
+N758 G1 X80.7480 Y30.7480\n\
+N759 G1 X80.8187 Y30.8207\n\
+N760 G1 X80.8894 Y30.8884\n\
+N761 G1 X80.9602 Y30.9632\n\
+N762 G1 X81.0309 Y31.0289\n\
+N763 G1 X81.1016 Y31.1026\n\
+N764 G1 X81.1723 Y31.1693\n\
+N765 G1 X81.2430 Y31.2430\n\
+N766 G1 X81.3137 Y31.3137\n\
+N767 G1 X81.3844 Y31.3864\n\
+N768 G1 X81.4551 Y31.4541\n\
+N769 G1 X81.5258 Y31.5288\n\
+N770 G1 X81.5966 Y31.5946\n\
+N771 G1 X81.6673 Y31.6683\n\
+N772 G1 X81.7380 Y31.7350\n\
+N773 G1 X81.8087 Y31.8087\n\
+N774 G1 X81.8794 Y31.8794\n\
+N775 G1 X81.9501 Y31.9521\n\
+N776 G1 X82.0208 Y32.0198\n\
+N777 G1 X82.0915 Y32.0945\n\
+N778 G1 X82.1622 Y32.1602\n\
+N779 G1 X82.2329 Y32.2339\n\
+N780 G1 X82.3037 Y32.3007\n\
+N781 G1 X82.3744 Y32.3744\n\
+N782 G1 X82.4451 Y32.4451\n\
+N783 G1 X82.5158 Y32.5178\n\
+N784 G1 X82.5865 Y32.5855\n\
+N785 G1 X82.6572 Y32.6602\n\
+N786 G1 X82.7279 Y32.7259\n\
+N787 G1 X82.7986 Y32.7996\n\
+N788 G1 X82.8693 Y32.8663\n\
+N789 G1 X82.9401 Y32.9401\n\
+N790 G1 X83.0108 Y33.0108\n\
+N791 G1 X83.0815 Y33.0835\n\
+N792 G1 X83.1522 Y33.1512\n\
+N793 G1 X83.2229 Y33.2259\n\
+N794 G1 X83.2936 Y33.2916\n\
+N795 G1 X83.3643 Y33.3653\n\
+N796 G1 X83.4350 Y33.4320\n\
+N797 G1 X83.5057 Y33.5057\n\
+N798 G1 X83.5765 Y33.5765\n\
+N799 G1 X83.6472 Y33.6492\n\
+N800 G1 X83.7179 Y33.7169\n\
+N801 G1 X83.7886 Y33.7916\n\
+N802 G1 X83.8593 Y33.8573\n\
+N803 G1 X83.9300 Y33.9310\n\
+N804 G1 X84.0007 Y33.9977\n\
+N805 G1 X84.0714 Y34.0714\n\
+N806 G1 X84.1421 Y34.1421\n\
+N807 G1 X84.2128 Y34.2148\n\
+N808 G1 X84.2836 Y34.2826\n\
+N809 G1 X84.3543 Y34.3573\n\
+N810 G1 X84.4250 Y34.4230\n\
+N811 G1 X84.4957 Y34.4967\n\
+N812 G1 X84.5664 Y34.5634\n\
+N813 G1 X84.6371 Y34.6371\n\
+N814 G1 X84.7078 Y34.7078\n\
+N815 G1 X84.7785 Y34.7805\n\
+N816 G1 X84.8492 Y34.8482\n\
+N817 G1 X84.9200 Y34.9230\n\
+N818 G1 X84.9907 Y34.9887\n\
+N819 G1 X85.0614 Y35.0624\n\
+N820 G1 X85.1321 Y35.1291\n\
+N821 G1 X85.2028 Y35.2028\n\
+N822 G1 X85.2735 Y35.2735\n\
+N823 G1 X85.3442 Y35.3462\n\
+N824 G1 X85.4149 Y35.4139\n\
+N825 G1 X85.4856 Y35.4886\n\
+N826 G1 X85.5563 Y35.5543\n\
+N827 G1 X85.6271 Y35.6281\n\
+N828 G1 X85.6978 Y35.6948\n\
+N829 G1 X85.7685 Y35.7685\n\
+N830 G1 X85.8392 Y35.8392\n\
+N831 G1 X85.9099 Y35.9119\n\
+N832 G1 X85.9806 Y35.9796\n\
+N833 G1 X86.0513 Y36.0543\n\
+N834 G1 X86.1220 Y36.1200\n\
+N835 G1 X86.1927 Y36.1937\n\
+N836 G1 X86.2635 Y36.2605\n\
+N837 G1 X86.3342 Y36.3342\n\
+N838 G1 X86.4049 Y36.4049\n\
+N839 G1 X86.4756 Y36.4776\n\
+N840 G1 X86.5463 Y36.5453\n\
+N841 G1 X86.6170 Y36.6200\n\
+N842 G1 X86.6877 Y36.6857\n\
+N843 G1 X86.7584 Y36.7594\n\
+N844 G1 X86.8291 Y36.8261\n\
+N845 G1 X86.8999 Y36.8999\n\
+N846 G1 X86.9706 Y36.9706\n\
+N847 G1 X87.0413 Y37.0433\n\
+N848 G1 X87.1120 Y37.1110\n\
+N849 G1 X87.1827 Y37.1857\n\
+N850 G1 X87.2534 Y37.2514\n\
+N851 G1 X87.3241 Y37.3251\n\
+N852 G1 X87.3948 Y37.3918\n\
+N853 G1 X87.4655 Y37.4655\n\
+N854 G1 X87.5362 Y37.5362\n\
+N855 G1 X87.6070 Y37.6090\n\
+N856 G1 X87.6777 Y37.6767\n\
+N857 G1 X87.7484 Y37.7514\n\
+N858 G1 X87.8191 Y37.8171\n\
+N859 G1 X87.8898 Y37.8908\n\
+N860 G1 X87.9605 Y37.9575\n\
+N861 G1 X88.0312 Y38.0312\n\
+N862 G1 X88.1019 Y38.1019\n\
+N863 G1 X88.1726 Y38.1746\n\
+N864 G1 X88.2434 Y38.2424\n\
+N865 G1 X88.3141 Y38.3171\n\
+N866 G1 X88.3848 Y38.3828\n\
+N867 G1 X88.4555 Y38.4565\n\
+N868 G1 X88.5262 Y38.5232\n\
+N869 G1 X88.5969 Y38.5969\n\
+N870 G1 X88.6676 Y38.6676\n\
+N871 G1 X88.7383 Y38.7403\n\
+N872 G1 X88.8090 Y38.8080\n\
+N873 G1 X88.8798 Y38.8828\n\
+N874 G1 X88.9505 Y38.9485\n\
+N875 G1 X89.0212 Y39.0222\n\
+N876 G1 X89.0919 Y39.0889\n\
+N877 G1 X89.1626 Y39.1626\n\
+N878 G1 X89.2333 Y39.2333\n\
+N879 G1 X89.3040 Y39.3060\n\
+N880 G1 X89.3747 Y39.3737\n\
+N881 G1 X89.4454 Y39.4484\n\
+N882 G1 X89.5161 Y39.5141\n\
+N883 G1 X89.5869 Y39.5879\n\
+N884 G1 X89.6576 Y39.6546\n\
+N885 G1 X89.7283 Y39.7283\n\
+N886 G1 X89.7990 Y39.7990\n\
+N887 G1 X89.8697 Y39.8717\n\
+N888 G1 X89.9404 Y39.9394\n\
+N889 G1 X90.0111 Y40.0141\n\
+N890 G1 X90.0818 Y40.0798\n\
+N891 G1 X90.1525 Y40.1535\n\
+N892 G1 X90.2233 Y40.2203\n\
+N893 G1 X90.2940 Y40.2940\n\
+N894 G1 X90.3647 Y40.3647\n\
+N895 G1 X90.4354 Y40.4374\n\
+N896 G1 X90.5061 Y40.5051\n\
+N897 G1 X90.5768 Y40.5798\n\
+N898 G1 X90.6475 Y40.6455\n\
+N899 G1 X90.7182 Y40.7192\n\
+N900 G1 X90.7889 Y40.7859\n\
+N901 G1 X90.8597 Y40.8597\n\
+N902 G1 X90.9304 Y40.9304\n\
+N903 G1 X91.0011 Y41.0031\n\
+N904 G1 X91.0718 Y41.0708\n\
+N905 G1 X91.1425 Y41.1455\n\
+N906 G1 X91.2132 Y41.2112\n\
+N907 G1 X91.2839 Y41.2849\n\
+N908 G1 X91.3546 Y41.3516\n\
+N909 G1 X91.4253 Y41.4253\n\
+N910 G1 X91.4960 Y41.4960\n\
+N911 G1 X91.5668 Y41.5688\n\
+N912 G1 X91.6375 Y41.6365\n\
+N913 G1 X91.7082 Y41.7112\n\
+N914 G1 X91.7789 Y41.7769\n\
+N915 G1 X91.8496 Y41.8506\n\
+N916 G1 X91.9203 Y41.9173\n\
+N917 G1 X91.9910 Y41.9910\n\
+N918 G1 X92.0617 Y42.0617\n\
+N919 G1 X92.1324 Y42.1344\n\
+N920 G1 X92.2032 Y42.2022\n\
+N921 G1 X92.2739 Y42.2769\n\
+N922 G1 X92.3446 Y42.3426\n\
+N923 G1 X92.4153 Y42.4163\n\
+N924 G1 X92.4860 Y42.4830\n\
+N925 G1 X92.5567 Y42.5567\n\
+N926 G1 X92.6274 Y42.6274\n\
+N927 G1 X92.6981 Y42.7001\n\
+N928 G1 X92.7688 Y42.7678\n\
+N929 G1 X92.8395 Y42.8425\n\
+N930 G1 X92.9103 Y42.9083\n\
+N931 G1 X92.9810 Y42.9820\n\
+N932 G1 X93.0517 Y43.0487\n\
+N933 G1 X93.1224 Y43.1224\n\
+N934 G1 X93.1931 Y43.1931\n\
+N935 G1 X93.2638 Y43.2658\n\
+N936 G1 X93.3345 Y43.3335\n\
+N937 G1 X93.4052 Y43.4082\n\
+N938 G1 X93.4759 Y43.4739\n\
+N939 G1 X93.5467 Y43.5477\n\
+N940 G1 X93.6174 Y43.6144\n\
+N941 G1 X93.6881 Y43.6881\n\
+N942 G1 X93.7588 Y43.7588\n\
+N943 G1 X93.8295 Y43.8315\n\
+N944 G1 X93.9002 Y43.8992\n\
+N945 G1 X93.9709 Y43.9739\n\
+N946 G1 X94.0416 Y44.0396\n\
+N947 G1 X94.1123 Y44.1133\n\
+N948 G1 X94.1831 Y44.1801\n\
+N949 G1 X94.2538 Y44.2538\n\
+N950 G1 X94.3245 Y44.3245\n\
+N951 G1 X94.3952 Y44.3972\n\
+N952 G1 X94.4659 Y44.4649\n\
+N953 G1 X94.5366 Y44.5396\n\
+N954 G1 X94.6073 Y44.6053\n\
+N955 G1 X94.6780 Y44.6790\n\
+N956 G1 X94.7487 Y44.7457\n\
+N957 G1 X94.8194 Y44.8194\n\
+N958 G1 X94.8902 Y44.8902\n\
+N959 G1 X94.9609 Y44.9629\n\
+N960 G1 X95.0316 Y45.0306\n\
+N961 G1 X95.1023 Y45.1053\n\
+N962 G1 X95.1730 Y45.1710\n\
+N963 G1 X95.2437 Y45.2447\n\
+N964 G1 X95.3144 Y45.3114\n\
+N965 G1 X95.3851 Y45.3851\n\
+N966 G1 X95.4558 Y45.4558\n\
+N967 G1 X95.5266 Y45.5286\n\
+N968 G1 X95.5973 Y45.5963\n\
+N969 G1 X95.6680 Y45.6710\n\
+N970 G1 X95.7387 Y45.7367\n\
+N971 G1 X95.8094 Y45.8104\n\
+N972 G1 X95.8801 Y45.8771\n\
+N973 G1 X95.9508 Y45.9508\n\
+N974 G1 X96.0215 Y46.0215\n\
+N975 G1 X96.0922 Y46.0942\n\
+N976 G1 X96.1630 Y46.1620\n\
+N977 G1 X96.2337 Y46.2367\n\
+N978 G1 X96.3044 Y46.3024\n\
+N979 G1 X96.3751 Y46.3761\n\
+N980 G1 X96.4458 Y46.4428\n\
+N981 G1 X96.5165 Y46.5165\n\
+N982 G1 X96.5872 Y46.5872\n\
+N983 G1 X96.6579 Y46.6599\n\
+N984 G1 X96.7286 Y46.7276\n\
+N985 G1 X96.7993 Y46.8023\n\
+N986 G1 X96.8701 Y46.8681\n\
+N987 G1 X96.9408 Y46.9418\n\
+N988 G1 X97.0115 Y47.0085\n\
+N989 G1 X97.0822 Y47.0822\n\
+N990 G1 X97.1529 Y47.1529\n\
+N991 G1 X97.2236 Y47.2256\n\
+N992 G1 X97.2943 Y47.2933\n\
+N993 G1 X97.3650 Y47.3680\n\
+N994 G1 X97.4357 Y47.4337\n\
+N995 G1 X97.5065 Y47.5075\n\
+N996 G1 X97.5772 Y47.5742\n\
+N997 G1 X97.6479 Y47.6479\n\
+N998 G1 X97.7186 Y47.7186\n\
+N999 G1 X97.7893 Y47.7913\n\
+N1000 G1 X97.8600 Y47.8590\n\
+N1001 G1 X97.9307 Y47.9337\n\
+N1002 G1 X98.0014 Y47.9994\n\
+N1003 G1 X98.0721 Y48.0731\n\
+N1004 G1 X98.1428 Y48.1398\n\
+N1005 G1 X98.2136 Y48.2136\n\
+N1006 G1 X98.2843 Y48.2843\n\
+N1007 (shallow curve - radius 200 mm in 0.2 mm chords)\n\
+N1008 G1 X98.4843 Y48.2842\n\
+N1009 G1 X98.6843 Y48.2839\n\
+N1010 G1 X98.8843 Y48.2834\n\
+N1011 G1 X99.0843 Y48.2827\n\
+N1012 G1 X99.2843 Y48.2818\n\
+N1013 G1 X99.4843 Y48.2807\n\
+N1014 G1 X99.6843 Y48.2794\n\
+N1015 G1 X99.8843 Y48.2779\n\
+N1016 G1 X100.0842 Y48.2762\n\
+N1017 G1 X100.2842 Y48.2743\n\
+N1018 G1 X100.4842 Y48.2722\n\
+N1019 G1 X100.6842 Y48.2699\n\
+N1020 G1 X100.8842 Y48.2674\n\
+N1021 G1 X101.0842 Y48.2647\n\
+N1022 G1 X101.2842 Y48.2618\n\
+N1023 G1 X101.4841 Y48.2587\n\
+N1024 G1 X101.6841 Y48.2554\n\
+N1025 G1 X101.8841 Y48.2519\n\
+N1026 G1 X102.0840 Y48.2482\n\
+N1027 G1 X102.2840 Y48.2443\n\
+N1028 G1 X102.4840 Y48.2402\n\
+N1029 G1 X102.6839 Y48.2359\n\
+N1030 G1 X102.8839 Y48.2314\n\
+N1031 G1 X103.0838 Y48.2267\n\
+N1032 G1 X103.2838 Y48.2218\n\
+N1033 G1 X103.4837 Y48.2167\n\
+N1034 G1 X103.6836 Y48.2114\n\
+N1035 G1 X103.8835 Y48.2059\n\
+N1036 G1 X104.0835 Y48.2002\n\
+N1037 G1 X104.2834 Y48.1943\n\
+N1038 G1 X104.4833 Y48.1882\n\
+N1039 G1 X104.6832 Y48.1819\n\
+N1040 G1 X104.8831 Y48.1754\n\
+N1041 G1 X105.0830 Y48.1687\n\
+N1042 G1 X105.2828 Y48.1618\n\
+N1043 G1 X105.4827 Y48.1547\n\
+N1044 G1 X105.6826 Y48.1474\n\
+N1045 G1 X105.8824 Y48.1399\n\
+N1046 G1 X106.0823 Y48.1322\n\
+N1047 G1 X106.2821 Y48.1243\n\
+N1048 G1 X106.4820 Y48.1162\n\
+N1049 G1 X106.6818 Y48.1079\n\
+N1050 G1 X106.8816 Y48.0994\n\
+N1051 G1 X107.0814 Y48.0907\n\
+N1052 G1 X107.2812 Y48.0818\n\
+N1053 G1 X107.4810 Y48.0727\n\
+N1054 G1 X107.6808 Y48.0634\n\
+N1055 G1 X107.8806 Y48.0539\n\
+N1056 G1 X108.0804 Y48.0442\n\
+N1057 G1 X108.2801 Y48.0343\n\
+N1058 G1 X108.4799 Y48.0242\n\
+N1059 G1 X108.6796 Y48.0139\n\
+N1060 G1 X108.8793 Y48.0034\n\
+N1061 G1 X109.0790 Y47.9927\n\
+N1062 G1 X109.2787 Y47.9818\n\
+N1063 G1 X109.4784 Y47.9708\n\
+N1064 G1 X109.6781 Y47.9595\n\
+N1065 G1 X109.8778 Y47.9480\n\
+N1066 G1 X110.0774 Y47.9363\n\
+N1067 G1 X110.2771 Y47.9244\n\
+N1068 G1 X110.4767 Y47.9123\n\
+N1069 G1 X110.6763 Y47.9000\n\
+N1070 G1 X110.8759 Y47.8875\n\
+N1071 G1 X111.0755 Y47.8748\n\
+N1072 G1 X111.2751 Y47.8619\n\
+N1073 G1 X111.4747 Y47.8488\n\
+N1074 G1 X111.6742 Y47.8355\n\
+N1075 G1 X111.8738 Y47.8220\n\
+N1076 G1 X112.0733 Y47.8084\n\
+N1077 G1 X112.2728 Y47.7945\n\
+N1078 G1 X112.4723 Y47.7804\n\
+N1079 G1 X112.6718 Y47.7661\n\
+N1080 G1 X112.8713 Y47.7516\n\
+N1081 G1 X113.0708 Y47.7369\n\
+N1082 G1 X113.2702 Y47.7220\n\
+N1083 G1 X113.4696 Y47.7069\n\
+N1084 G1 X113.6691 Y47.6917\n\
+N1085 G1 X113.8685 Y47.6762\n\
+N1086 G1 X114.0678 Y47.6605\n\
+N1087 G1 X114.2672 Y47.6446\n\
+N1088 G1 X114.4666 Y47.6285\n\
+N1089 G1 X114.6659 Y47.6122\n\
+N1090 G1 X114.8652 Y47.5958\n\
+N1091 G1 X115.0645 Y47.5791\n\
+N1092 G1 X115.2638 Y47.5622\n\
+N1093 G1 X115.4631 Y47.5451\n\
+N1094 G1 X115.6623 Y47.5278\n\
+N1095 G1 X115.8616 Y47.5104\n\
+N1096 G1 X116.0608 Y47.4927\n\
+N1097 G1 X116.2600 Y47.4748\n\
+N1098 G1 X116.4592 Y47.4567\n\
+N1099 G1 X116.6583 Y47.4385\n\
+N1100 G1 X116.8575 Y47.4200\n\
+N1101 G1 X117.0566 Y47.4013\n\
+N1102 G1 X117.2557 Y47.3824\n\
+N1103 G1 X117.4548 Y47.3634\n\
+N1104 G1 X117.6539 Y47.3441\n\
+N1105 G1 X117.8529 Y47.3246\n\
+N1106 G1 X118.0519 Y47.3050\n\
+N1107 G1 X118.2510 Y47.2851\n\
+N1108 G1 X118.4499 Y47.2650\n\
+N1109 G1 X118.6489 Y47.2448\n\
+N1110 G1 X118.8479 Y47.2243\n\
+N1111 G1 X119.0468 Y47.2036\n\
+N1112 G1 X119.2457 Y47.1828\n\
+N1113 G1 X119.4446 Y47.1617\n\
+N1114 G1 X119.6435 Y47.1405\n\
+N1115 G1 X119.8423 Y47.1190\n\
+N1116 G1 X120.0411 Y47.0973\n\
+N1117 G1 X120.2399 Y47.0755\n\
+N1118 G1 X120.4387 Y47.0534\n\
+N1119 G1 X120.6375 Y47.0312\n\
+N1120 G1 X120.8362 Y47.0087\n\
+N1121 G1 X121.0349 Y46.9861\n\
+N1122 G1 X121.2336 Y46.9632\n\
+N1123 G1 X121.4323 Y46.9402\n\
+N1124 G1 X121.6309 Y46.9169\n\
+N1125 G1 X121.8295 Y46.8935\n\
+N1126 G1 X122.0281 Y46.8698\n\
+N1127 G1 X122.2267 Y46.8460\n\
+N1128 G1 X122.4253 Y46.8220\n\
+N1129 G1 X122.6238 Y46.7977\n\
+N1130 G1 X122.8223 Y46.7733\n\
+N1131 G1 X123.0208 Y46.7486\n\
+N1132 G1 X123.2192 Y46.7238\n\
+N1133 G1 X123.4176 Y46.6988\n\
+N1134 G1 X123.6160 Y46.6735\n\
+N1135 G1 X123.8144 Y46.6481\n\
+N1136 G1 X124.0128 Y46.6225\n\
+N1137 G1 X124.2111 Y46.5966\n\
+N1138 G1 X124.4094 Y46.5706\n\
+N1139 G1 X124.6077 Y46.5444\n\
+N1140 G1 X124.8059 Y46.5180\n\
+N1141 G1 X125.0041 Y46.4914\n\
+N1142 G1 X125.2023 Y46.4645\n\
+N1143 G1 X125.4005 Y46.4375\n\
+N1144 G1 X125.5986 Y46.4103\n\
+N1145 G1 X125.7968 Y46.3829\n\
+N1146 G1 X125.9948 Y46.3553\n\
+N1147 G1 X126.1929 Y46.3275\n\
+N1148 G1 X126.3909 Y46.2995\n\
+N1149 G1 X126.5889 Y46.2713\n\
+N1150 G1 X126.7869 Y46.2429\n\
+N1151 G1 X126.9848 Y46.2143\n\
+N1152 G1 X127.1828 Y46.1855\n\
+N1153 G1 X127.3806 Y46.1565\n\
+N1154 G1 X127.5785 Y46.1273\n\
+N1155 G1 X127.7763 Y46.0979\n\
+N1156 G1 X127.9741 Y46.0683\n\
+N1157 G1 X128.1719 Y46.0385\n\
+N1158 G1 X128.3696 Y46.0085\n\
+N1159 G1 X128.5673 Y45.9783\n\
+N1160 G1 X128.7650 Y45.9479\n\
+N1161 G1 X128.9627 Y45.9174\n\
+N1162 G1 X129.1603 Y45.8866\n\
+N1163 G1 X129.3579 Y45.8556\n\
+N1164 G1 X129.5554 Y45.8244\n\
+N1165 G1 X129.7530 Y45.7931\n\
+N1166 G1 X129.9505 Y45.7615\n\
+N1167 G1 X130.1479 Y45.7297\n\
+N1168 G1 X130.3453 Y45.6978\n\
+N1169 G1 X130.5427 Y45.6656\n\
+N1170 G1 X130.7401 Y45.6332\n\
+N1171 G1 X130.9374 Y45.6007\n\
+N1172 G1 X131.1347 Y45.5679\n\
+N1173 G1 X131.3320 Y45.5350\n\
+N1174 G1 X131.5292 Y45.5018\n\
+N1175 G1 X131.7264 Y45.4685\n\
+N1176 G1 X131.9236 Y45.4350\n\
+N1177 G1 X132.1207 Y45.4012\n\
+N1178 G1 X132.3178 Y45.3673\n\
+N1179 G1 X132.5149 Y45.3332\n\
+N1180 G1 X132.7119 Y45.2988\n\
+N1181 G1 X132.9089 Y45.2643\n\
+N1182 G1 X133.1059 Y45.2296\n\
+N1183 G1 X133.3028 Y45.1947\n\
+N1184 G1 X133.4997 Y45.1595\n\
+N1185 G1 X133.6966 Y45.1242\n\
+N1186 G1 X133.8934 Y45.0887\n\
+N1187 G1 X134.0902 Y45.0530\n\
+N1188 G1 X134.2869 Y45.0171\n\
+N1189 G1 X134.4837 Y44.9810\n\
+N1190 G1 X134.6803 Y44.9447\n\
+N1191 G1 X134.8770 Y44.9082\n\
+N1192 G1 X135.0736 Y44.8715\n\
+N1193 G1 X135.2701 Y44.8346\n\
+N1194 G1 X135.4667 Y44.7975\n\
+N1195 G1 X135.6632 Y44.7603\n\
+N1196 G1 X135.8596 Y44.7228\n\
+N1197 G1 X136.0561 Y44.6851\n\
+N1198 G1 X136.2524 Y44.6472\n\
+N1199 G1 X136.4488 Y44.6092\n\
+N1200 G1 X136.6451 Y44.5709\n\
+N1201 G1 X136.8413 Y44.5325\n\
+N1202 G1 X137.0376 Y44.4938\n\
+N1203 G1 X137.2338 Y44.4550\n\
+N1204 G1 X137.4299 Y44.4159\n\
+N1205 G1 X137.6260 Y44.3767\n\
+N1206 G1 X137.8221 Y44.3372\n\
+N1207 G1 X138.0181 Y44.2976\n\
+N1208 G1 X138.2141 Y44.2578\n\
+N1209 G1 X138.4101 Y44.2177\n\
+N1210 G1 X138.6060 Y44.1775\n\
+N1211 G1 X138.8019 Y44.1371\n\
+N1212 G1 X138.9977 Y44.0965\n\
+N1213 G1 X139.1935 Y44.0557\n\
+N1214 G1 X139.3892 Y44.0146\n\
+N1215 G1 X139.5850 Y43.9734\n\
+N1216 G1 X139.7806 Y43.9320\n\
+N1217 G1 X139.9763 Y43.8905\n\
+N1218 G1 X140.1718 Y43.8487\n\
+N1219 G1 X140.3674 Y43.8067\n\
+N1220 G1 X140.5629 Y43.7645\n\
+N1221 G1 X140.7583 Y43.7221\n\
+N1222 G1 X140.9538 Y43.6796\n\
+N1223 G1 X141.1491 Y43.6368\n\
+N1224 G1 X141.3445 Y43.5938\n\
+N1225 G1 X141.5397 Y43.5507\n\
+N1226 G1 X141.7350 Y43.5073\n\
+N1227 G1 X141.9302 Y43.4638\n\
+N1228 G1 X142.1254 Y43.4200\n\
+N1229 G1 X142.3205 Y43.3761\n\
+N1230 G1 X142.5155 Y43.3319\n\
+N1231 G1 X142.7106 Y43.2876\n\
+N1232 G1 X142.9055 Y43.2431\n\
+N1233 G1 X143.1005 Y43.1984\n\
+N1234 G1 X143.2954 Y43.1535\n\
+N1235 G1 X143.4902 Y43.1084\n\
+N1236 G1 X143.6850 Y43.0630\n\
+N1237 G1 X143.8798 Y43.0176\n\
+N1238 G1 X144.0745 Y42.9719\n\
+N1239 G1 X144.2692 Y42.9260\n\
+N1240 G1 X144.4638 Y42.8799\n\
+N1241 G1 X144.6583 Y42.8336\n\
+N1242 G1 X144.8529 Y42.7871\n\
+N1243 G1 X145.0473 Y42.7405\n\
+N1244 G1 X145.2418 Y42.6936\n\
+N1245 G1 X145.4362 Y42.6466\n\
+N1246 G1 X145.6305 Y42.5993\n\
+N1247 G1 X145.8248 Y42.5519\n\
+N1248 G1 X146.0190 Y42.5042\n\
+N1249 G1 X146.2132 Y42.4564\n\
+N1250 G1 X146.4074 Y42.4084\n\
+N1251 G1 X146.6015 Y42.3602\n\
+N1252 G1 X146.7955 Y42.3117\n\
+N1253 G1 X146.9895 Y42.2631\n\
+N1254 G1 X147.1835 Y42.2143\n\
+N1255 G1 X147.3774 Y42.1653\n\
+N1256 G1 X147.5713 Y42.1161\n\
+N1257 G1 X147.7651 Y42.0668\n\
+N1258 (a tighter tolerance and a slower feed)\n\
+N1259 G64 Q0.001 F600\n\
+N1260 G1 X147.8651 Y42.0672\n\
+N1261 G1 X147.9651 Y42.0666\n\
+N1262 G1 X148.0651 Y42.0674\n\
+N1263 G1 X148.1651 Y42.0664\n\
+N1264 G1 X148.2651 Y42.0670\n\
+N1265 G1 X148.3651 Y42.0662\n\
+N1266 G1 X148.4651 Y42.0668\n\
+N1267 G1 X148.5651 Y42.0668\n\
+N1268 G1 X148.6651 Y42.0672\n\
+N1269 G1 X148.7651 Y42.0666\n\
+N1270 G1 X148.8651 Y42.0674\n\
+N1271 G1 X148.9651 Y42.0664\n\
+N1272 G1 X149.0651 Y42.0670\n\
+N1273 G1 X149.1651 Y42.0662\n\
+N1274 G1 X149.2651 Y42.0668\n\
+N1275 G1 X149.3651 Y42.0668\n\
+N1276 G1 X149.4651 Y42.0672\n\
+N1277 G1 X149.5651 Y42.0666\n\
+N1278 G1 X149.6651 Y42.0674\n\
+N1279 G1 X149.7651 Y42.0664\n\
+N1280 G1 X149.8651 Y42.0670\n\
+N1281 G1 X149.9651 Y42.0662\n\
+N1282 G1 X150.0651 Y42.0668\n\
+N1283 G1 X150.1651 Y42.0668\n\
+N1284 G1 X150.2651 Y42.0672\n\
+N1285 G1 X150.3651 Y42.0666\n\
+N1286 G1 X150.4651 Y42.0674\n\
+N1287 G1 X150.5651 Y42.0664\n\
+N1288 G1 X150.6651 Y42.0670\n\
+N1289 G1 X150.7651 Y42.0662\n\
+N1290 G1 X150.8651 Y42.0668\n\
+N1291 G1 X150.9651 Y42.0668\n\
+N1292 G1 X151.0651 Y42.0672\n\
+N1293 G1 X151.1651 Y42.0666\n\
+N1294 G1 X151.2651 Y42.0674\n\
+N1295 G1 X151.3651 Y42.0664\n\
+N1296 G1 X151.4651 Y42.0670\n\
+N1297 G1 X151.5651 Y42.0662\n\
+N1298 G1 X151.6651 Y42.0668\n\
+N1299 G1 X151.7651 Y42.0668\n\
+N1300 G1 X151.8651 Y42.0672\n\
+N1301 G1 X151.9651 Y42.0666\n\
+N1302 G1 X152.0651 Y42.0674\n\
+N1303 G1 X152.1651 Y42.0664\n\
+N1304 G1 X152.2651 Y42.0670\n\
+N1305 G1 X152.3651 Y42.0662\n\
+N1306 G1 X152.4651 Y42.0668\n\
+N1307 G1 X152.5651 Y42.0668\n\
+N1308 G1 X152.6651 Y42.0672\n\
+N1309 G1 X152.7651 Y42.0666\n\
+N1310 G1 X152.8651 Y42.0674\n\
+N1311 G1 X152.9651 Y42.0664\n\
+N1312 G1 X153.0651 Y42.0670\n\
+N1313 G1 X153.1651 Y42.0662\n\
+N1314 G1 X153.2651 Y42.0668\n\
+N1315 G1 X153.3651 Y42.0668\n\
+N1316 G1 X153.4651 Y42.0672\n\
+N1317 G1 X153.5651 Y42.0666\n\
+N1318 G1 X153.6651 Y42.0674\n\
+N1319 G1 X153.7651 Y42.0664\n\
+N1320 G1 X153.8651 Y42.0670\n\
+N1321 G1 X153.9651 Y42.0662\n\
+N1322 G1 X154.0651 Y42.0668\n\
+N1323 G1 X154.1651 Y42.0668\n\
+N1324 G1 X154.2651 Y42.0672\n\
+N1325 G1 X154.3651 Y42.0666\n\
+N1326 G1 X154.4651 Y42.0674\n\
+N1327 G1 X154.5651 Y42.0664\n\
+N1328 G1 X154.6651 Y42.0670\n\
+N1329 G1 X154.7651 Y42.0662\n\
+N1330 G1 X154.8651 Y42.0668\n\
+N1331 G1 X154.9651 Y42.0668\n\
+N1332 G1 X155.0651 Y42.0672\n\
+N1333 G1 X155.1651 Y42.0666\n\
+N1334 G1 X155.2651 Y42.0674\n\
+N1335 G1 X155.3651 Y42.0664\n\
+N1336 G1 X155.4651 Y42.0670\n\
+N1337 G1 X155.5651 Y42.0662\n\
+N1338 G1 X155.6651 Y42.0668\n\
+N1339 G1 X155.7651 Y42.0668\n\
+N1340 G1 X155.8651 Y42.0672\n\
+N1341 G1 X155.9651 Y42.0666\n\
+N1342 G1 X156.0651 Y42.0674\n\
+N1343 G1 X156.1651 Y42.0664\n\
+N1344 G1 X156.2651 Y42.0670\n\
+N1345 G1 X156.3651 Y42.0662\n\
+N1346 G1 X156.4651 Y42.0668\n\
+N1347 G1 X156.5651 Y42.0668\n\
+N1348 G1 X156.6651 Y42.0672\n\
+N1349 G1 X156.7651 Y42.0666\n\
+N1350 G1 X156.8651 Y42.0674\n\
+N1351 G1 X156.9651 Y42.0664\n\
+N1352 G1 X157.0651 Y42.0670\n\
+N1353 G1 X157.1651 Y42.0662\n\
+N1354 G1 X157.2651 Y42.0668\n\
+N1355 G1 X157.3651 Y42.0668\n\
+N1356 G1 X157.4651 Y42.0672\n\
+N1357 G1 X157.5651 Y42.0666\n\
+N1358 G1 X157.6651 Y42.0674\n\
+N1359 G1 X157.7651 Y42.0664\n\
+N1360 G1 X157.8651 Y42.0670\n\
+N1361 G1 X157.9651 Y42.0662\n\
+N1362 G1 X158.0651 Y42.0668\n\
+N1363 G1 X158.1651 Y42.0668\n\
+N1364 G1 X158.2651 Y42.0672\n\
+N1365 G1 X158.3651 Y42.0666\n\
+N1366 G1 X158.4651 Y42.0674\n\
+N1367 G1 X158.5651 Y42.0664\n\
+N1368 G1 X158.6651 Y42.0670\n\
+N1369 G1 X158.7651 Y42.0662\n\
+N1370 G1 X158.8651 Y42.0668\n\
+N1371 G1 X158.9651 Y42.0668\n\
+N1372 G1 X159.0651 Y42.0672\n\
+N1373 G1 X159.1651 Y42.0666\n\
+N1374 G1 X159.2651 Y42.0674\n\
+N1375 G1 X159.3651 Y42.0664\n\
+N1376 G1 X159.4651 Y42.0670\n\
+N1377 G1 X159.5651 Y42.0662\n\
+N1378 G1 X159.6651 Y42.0668\n\
+N1379 G1 X159.7651 Y42.0668\n\
+N1380 G1 X159.8651 Y42.0672\n\
+N1381 G1 X159.9651 Y42.0666\n\
+N1382 G1 X160.0651 Y42.0674\n\
+N1383 G1 X160.1651 Y42.0664\n\
+N1384 G1 X160.2651 Y42.0670\n\
+N1385 G1 X160.3651 Y42.0662\n\
+N1386 G1 X160.4651 Y42.0668\n\
+N1387 G1 X160.5651 Y42.0668\n\
+N1388 G1 X160.6651 Y42.0672\n\
+N1389 G1 X160.7651 Y42.0666\n\
+N1390 G1 X160.8651 Y42.0674\n\
+N1391 G1 X160.9651 Y42.0664\n\
+N1392 G1 X161.0651 Y42.0670\n\
+N1393 G1 X161.1651 Y42.0662\n\
+N1394 G1 X161.2651 Y42.0668\n\
+N1395 G1 X161.3651 Y42.0668\n\
+N1396 G1 X161.4651 Y42.0672\n\
+N1397 G1 X161.5651 Y42.0666\n\
+N1398 G1 X161.6651 Y42.0674\n\
+N1399 G1 X161.7651 Y42.0664\n\
+N1400 G1 X161.8651 Y42.0670\n\
+N1401 G1 X161.9651 Y42.0662\n\
+N1402 G1 X162.0651 Y42.0668\n\
+N1403 G1 X162.1651 Y42.0668\n\
+N1404 G1 X162.2651 Y42.0672\n\
+N1405 G1 X162.3651 Y42.0666\n\
+N1406 G1 X162.4651 Y42.0674\n\
+N1407 G1 X162.5651 Y42.0664\n\
+N1408 G1 X162.6651 Y42.0670\n\
+N1409 G1 X162.7651 Y42.0662\n\
+N1410 G1 X162.8651 Y42.0668\n\
+N1411 G1 X162.9651 Y42.0668\n\
+N1412 G1 X163.0651 Y42.0672\n\
+N1413 G1 X163.1651 Y42.0666\n\
+N1414 G1 X163.2651 Y42.0674\n\
+N1415 G1 X163.3651 Y42.0664\n\
+N1416 G1 X163.4651 Y42.0670\n\
+N1417 G1 X163.5651 Y42.0662\n\
+N1418 G1 X163.6651 Y42.0668\n\
+N1419 G1 X163.7651 Y42.0668\n\
+N1420 G1 X163.8651 Y42.0672\n\
+N1421 G1 X163.9651 Y42.0666\n\
+N1422 G1 X164.0651 Y42.0674\n\
+N1423 G1 X164.1651 Y42.0664\n\
+N1424 G1 X164.2651 Y42.0670\n\
+N1425 G1 X164.3651 Y42.0662\n\
+N1426 G1 X164.4651 Y42.0668\n\
+N1427 G1 X164.5651 Y42.0668\n\
+N1428 G1 X164.6651 Y42.0672\n\
+N1429 G1 X164.7651 Y42.0666\n\
+N1430 G1 X164.8651 Y42.0674\n\
+N1431 G1 X164.9651 Y42.0664\n\
+N1432 G1 X165.0651 Y42.0670\n\
+N1433 G1 X165.1651 Y42.0662\n\
+N1434 G1 X165.2651 Y42.0668\n\
+N1435 G1 X165.3651 Y42.0668\n\
+N1436 G1 X165.4651 Y42.0672\n\
+N1437 G1 X165.5651 Y42.0666\n\
+N1438 G1 X165.6651 Y42.0674\n\
+N1439 G1 X165.7651 Y42.0664\n\
+N1440 G1 X165.8651 Y42.0670\n\
+N1441 G1 X165.9651 Y42.0662\n\
+N1442 G1 X166.0651 Y42.0668\n\
+N1443 G1 X166.1651 Y42.0668\n\
+N1444 G1 X166.2651 Y42.0672\n\
+N1445 G1 X166.3651 Y42.0666\n\
+N1446 G1 X166.4651 Y42.0674\n\
+N1447 G1 X166.5651 Y42.0664\n\
+N1448 G1 X166.6651 Y42.0670\n\
+N1449 G1 X166.7651 Y42.0662\n\
+N1450 G1 X166.8651 Y42.0668\n\
+N1451 G1 X166.9651 Y42.0668\n\
+N1452 G1 X167.0651 Y42.0672\n\
+N1453 G1 X167.1651 Y42.0666\n\
+N1454 G1 X167.2651 Y42.0674\n\
+N1455 G1 X167.3651 Y42.0664\n\
+N1456 G1 X167.4651 Y42.0670\n\
+N1457 G1 X167.5651 Y42.0662\n\
+N1458 G1 X167.6651 Y42.0668\n\
+N1459 G1 X167.7651 Y42.0668\n\
+N1460 (back to exact path - no merging)\n\
+N1461 G61\n\
+N1462 G1 X167.8651 Y42.0668\n\
+N1463 G1 X167.9651 Y42.0668\n\
+N1464 G1 X168.0651 Y42.0668\n\
+N1465 G1 X168.1651 Y42.0668\n\
+N1466 G1 X168.2651 Y42.0668\n\
+N1467 G1 X168.3651 Y42.0668\n\
+N1468 G1 X168.4651 Y42.0668\n\
+N1469 G1 X168.5651 Y42.0668\n\
+N1470 G1 X168.6651 Y42.0668\n\
+N1471 G1 X168.7651 Y42.0668\n\
+N1472 G1 X168.8651 Y42.0668\n\
+N1473 G1 X168.9651 Y42.0668\n\
+N1474 G1 X169.0651 Y42.0668\n\
+N1475 G1 X169.1651 Y42.0668\n\
+N1476 G1 X169.2651 Y42.0668\n\
+N1477 G1 X169.3651 Y42.0668\n\
+N1478 G1 X169.4651 Y42.0668\n\
+N1479 G1 X169.5651 Y42.0668\n\
+N1480 G1 X169.6651 Y42.0668\n\
+N1481 G1 X169.7651 Y42.0668\n\
+N1482 G0 X0 Y0 Z0\n\
+N1483 M2\n\
+";
@@ -0,0 +1,56 @@
+# ----------------------------------------------------------------------------
+# This file is part of the Synthetos g2core project
+
+
+# To compile:
+#   make BOARD=posix-sim
+
+# You can also choose a CONFIG from boards.mk:
+#   make CONFIG=ShapeokoDualY BOARD=posix-sim
+
+# or pick a settings file directly (settings_default.h leaves the axes disabled):
+#   make BOARD=posix-sim SETTINGS_FILE=settings_test.h
+
+# The result is a host (Linux) executable that runs g2core against simulated
+# timers and steppers. Run it with no arguments to talk JSON/text on stdin/stdout,
+# or with --pty to get a pseudo-terminal that a host program can open like a port.
+
+# --rate N runs simulated time N times faster than the host clock, and
+# --bench runs the planner benchmark over the Gcode in Resources/gcode:
+#   <executable> --bench list
+#   <executable> --bench roadrunner,hacdc --rate 4
+# See board/posix-sim/platform/posix/posix_bench.h for what is reported.
+
+# --lockstep advances simulated time from the controller loop instead of the host
+# clock, so runs are repeatable. --golden records the trajectory of each benchmark
+# program, or checks it against an earlier recording (implies --lockstep):
+#   <executable> --bench all --golden check board/posix-sim/golden
+#   <executable> --bench hacdc --golden check board/posix-sim/golden --tolerance 0.05
+#   <executable> --bench all --golden record board/posix-sim/golden
+# See board/posix-sim/platform/posix/posix_golden.h for what is compared. --zoid checks
+# the planner's ramp solvers against exact roots, and exits 1 if one is out of bounds:
+#   <executable> --zoid
+
+
+##########
+# BOARDs for use directly from the make command line (with default settings) or by CONFIGs.
+
+ifeq ("$(BOARD)","posix-sim")
+    BASE_BOARD=posix-sim
+    DEVICE_DEFINES += MOTATE_BOARD="posix-sim"
+    DEVICE_DEFINES += SETTINGS_FILE=${SETTINGS_FILE}
+endif
+
+
+##########
+# The general posix-sim BASE_BOARD.
+
+ifeq ("$(BASE_BOARD)","posix-sim")
+    _BOARD_FOUND = 1
+
+    BOARD_PATH = ./board/posix-sim
+    SOURCE_DIRS += ${BOARD_PATH} ${BOARD_PATH}/platform/posix device/step_dir_driver
+
+    PLATFORM_BASE = ${BOARD_PATH}/platform/posix
+    include $(PLATFORM_BASE).mk
+endif
@@ -0,0 +1,38 @@
+# ----------------------------------------------------------------------------
+# This file is part of the Synthetos g2core project
+#
+# posix.mk - host (Linux/POSIX) platform for the posix-sim board.
+#
+# This stands in for ${MOTATE_PATH}/platform/atmel_sam.mk: instead of the
+# arm-none-eabi toolchain it builds a native executable with the host compiler,
+# and the Motate headers come from this directory instead of the Motate library.
+
+PLATFORM_PATH = ${BOARD_PATH}/platform/posix
+
+CROSS_COMPILE =
+CC  = gcc
+CXX = g++
+LD  = g++
+AR  = ar
+OBJCOPY = objcopy
+SIZE = size
+
+CHIP = host
+export CHIP
+CHIP_LOWERCASE = host
+
+# Don't pull in any of the Motate ARM sources - main() is in posix_sim.cpp
+FIRST_LINK_SOURCES += ${PLATFORM_PATH}/posix_sim.cpp
+
+INCLUDE_DIRS += ${BOARD_PATH} ${PLATFORM_PATH}
+
+DEVICE_DEFINES += __POSIX_SIM__=1
+
+CPU_DEV =
+CFLAGS += -pthread
+CPPFLAGS += -pthread
+LDFLAGS += -pthread
+LIBS += -lm -lrt
+
+# No linker script, no hex/bin - the ELF is the simulator
+LINKER_SCRIPT =
@@ -0,0 +1,181 @@
+/*
+ * MotateBuffer.h - posix-sim stand-in for the Motate transfer buffers
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  RXBuffer and TXBuffer are ring buffers that hand contiguous free (RX) or
+ *  filled (TX) regions to their owner device as "transfers", the way the SAM
+ *  DMA based buffers do. The owner must provide:
+ *
+ *    const base_type* getRXTransferPosition() / getTXTransferPosition()
+ *    void setRXTransferDoneCallback(std::function<void()> &&callback) / setTX...
+ *    bool startRXTransfer(base_type *&buffer, uint16_t length) / startTX...
+ *
+ *  One slot is always left empty so a full buffer can be told from an empty one.
+ */
+
+#ifndef MOTATE_BUFFER_H_ONCE
+#define MOTATE_BUFFER_H_ONCE
+
+#include <stdint.h>
+#include <functional>
+
+namespace Motate {
+
+    template <uint16_t _size, typename owner_type, typename base_type = char>
+    struct RXBuffer {
+        static_assert(((_size-1)&_size)==0, "RXBuffer _size must be 2^N");
+
+        owner_type _owner;
+        base_type _data[_size];
+
+        volatile uint16_t _read_offset;                 // next character to read
+        volatile uint16_t _last_known_write_offset;     // where the transfer was last seen writing
+        volatile bool _transfer_requested;              // a transfer is in progress
+
+        RXBuffer(owner_type owner) : _owner{owner} {};
+
+        void init() {
+            _read_offset = 0;
+            _last_known_write_offset = 0;
+            _transfer_requested = false;
+            _owner->setRXTransferDoneCallback([&]() {
+                _transfer_requested = false;
+                _restartTransfer();
+            });
+            _restartTransfer();
+        };
+
+        uint16_t _getWriteOffset() {
+            const base_type *position = _owner->getRXTransferPosition();
+            if (position != nullptr) {
+                _last_known_write_offset = (position - _data) & (_size-1);
+            }
+            return _last_known_write_offset;
+        };
+
+        bool isEmpty() { return (_read_offset == _getWriteOffset()); };
+
+        // true if offset holds data that has been written but not yet read
+        bool _canBeRead(const uint16_t offset) {
+            uint16_t write_offset = _getWriteOffset();
+            if (_read_offset <= write_offset) {
+                return ((offset >= _read_offset) && (offset < write_offset));
+            }
+            return ((offset >= _read_offset) || (offset < write_offset));
+        };
+
+        void _restartTransfer() {
+            if (_transfer_requested) {
+                return;
+            }
+            uint16_t write_offset = _getWriteOffset();
+            uint16_t end_offset;
+            if (write_offset >= _read_offset) {
+                end_offset = (_read_offset == 0) ? (_size-1) : _size;
+            } else {
+                end_offset = _read_offset - 1;
+            }
+            if (end_offset <= write_offset) {
+                return;                                 // full
+            }
+            base_type *start = _data + write_offset;
+            _transfer_requested = true;
+            if (!_owner->startRXTransfer(start, end_offset - write_offset)) {
+                _transfer_requested = false;
+            }
+        };
+
+        void flush() {
+            _read_offset = _getWriteOffset();
+        };
+    };
+
+    template <uint16_t _size, typename owner_type, typename base_type = char>
+    struct TXBuffer {
+        static_assert(((_size-1)&_size)==0, "TXBuffer _size must be 2^N");
+
+        owner_type _owner;
+        base_type _data[_size];
+
+        volatile uint16_t _read_offset;                 // next character to transfer
+        volatile uint16_t _write_offset;                // next free slot
+        volatile uint16_t _transfer_length;
+        volatile bool _transfer_requested;
+
+        TXBuffer(owner_type owner) : _owner{owner} {};
+
+        void init() {
+            _read_offset = 0;
+            _write_offset = 0;
+            _transfer_length = 0;
+            _transfer_requested = false;
+            _owner->setTXTransferDoneCallback([&]() {
+                _read_offset = (_read_offset + _transfer_length) & (_size-1);
+                _transfer_length = 0;
+                _transfer_requested = false;
+                _restartTransfer();
+            });
+        };
+
+        bool isEmpty() { return (_read_offset == _write_offset); };
+        bool isFull() { return (((_write_offset + 1) & (_size-1)) == _read_offset); };
+
+        void _restartTransfer() {
+            if (_transfer_requested || isEmpty()) {
+                return;
+            }
+            uint16_t end_offset = (_write_offset > _read_offset) ? _write_offset : _size;
+            base_type *start = _data + _read_offset;
+            _transfer_length = end_offset - _read_offset;
+            _transfer_requested = true;
+            if (!_owner->startTXTransfer(start, _transfer_length)) {
+                _transfer_length = 0;
+                _transfer_requested = false;
+            }
+        };
+
+        int16_t write(const base_type *buffer, int16_t length) {
+            int16_t written = 0;
+            while ((written < length) && !isFull()) {
+                _data[_write_offset] = *buffer++;
+                _write_offset = (_write_offset + 1) & (_size-1);
+                written++;
+            }
+            _restartTransfer();
+            return written;
+        };
+
+        void flush() {
+            if (!_transfer_requested) {
+                _read_offset = _write_offset;           // toss anything not yet sent
+            }
+        };
+    };
+
+} // namespace Motate
+
+#endif // End of include guard: MOTATE_BUFFER_H_ONCE
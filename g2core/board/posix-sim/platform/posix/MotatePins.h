@@ -0,0 +1,170 @@
+/*
+ * MotatePins.h - posix-sim stand-in for Motate pins
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  There is no GPIO on the host. Every pin keeps its last written value so it can
+ *  be read back, inputs read as if pulled up, and ADCs read zero. Pins numbered
+ *  less than zero are null pins (isNull() is true), exactly as on the boards.
+ */
+
+#ifndef MOTATE_PINS_H_ONCE
+#define MOTATE_PINS_H_ONCE
+
+#include <stdint.h>
+#include <functional>
+#include "posix_sim.h"
+
+namespace Motate {
+
+    typedef const int16_t pin_number;
+
+    enum PinMode {
+        kUnchanged      = 0,
+        kOutput         = 1,
+        kInput          = 2,
+    };
+
+    enum PinOptions {
+        kNormal         = 0,
+        kTotem          = 0,
+        kPullUp         = 1<<1,
+        kWiredAnd       = 1<<2,
+        kDriveLowOnly   = 1<<2,
+        kWiredAndPull   = kWiredAnd|kPullUp,
+        kDriveLowPullUp = kDriveLowOnly|kPullUp,
+        kDebounce       = 1<<3,
+        kDeglitch       = 1<<4,
+        kStartHigh      = 1<<5,
+        kStartLow       = 1<<6,
+        kPWMPinInverted = 1<<7,
+    };
+
+    enum PinInterruptOptions {
+        kPinInterruptsOff           = 0,
+        kPinInterruptOnChange       = 1<<10,
+        kPinInterruptOnRisingEdge   = 1<<11,
+        kPinInterruptOnFallingEdge  = 1<<12,
+        kPinInterruptOnLowLevel     = 1<<13,
+        kPinInterruptOnHighLevel    = 1<<14,
+
+        kPinInterruptPriorityHighest = 1<<5,
+        kPinInterruptPriorityHigh    = 1<<6,
+        kPinInterruptPriorityMedium  = 1<<7,
+        kPinInterruptPriorityLow     = 1<<8,
+        kPinInterruptPriorityLowest  = 1<<9,
+    };
+
+    template <int16_t pinNum>
+    struct Pin {
+        volatile bool _value;
+
+        Pin() : _value {false} {};
+        Pin(const PinMode type, const uint32_t options = kNormal) : _value {(options & (kStartHigh | kPullUp)) != 0} {};
+
+        static constexpr bool isNull() { return (pinNum < 0); };
+        void setMode(const PinMode type, const uint32_t options = kNormal) {};
+        void setOptions(const uint32_t options) {};
+        void set() { _value = true; };
+        void clear() { _value = false; };
+        void toggle() { _value = !_value; };
+        void write(const bool value) { _value = value; };
+        bool get() { return (_value); };
+        bool getInputValue() { return (_value); };
+        bool getOutputValue() { return (_value); };
+        operator bool() { return (_value); };
+    };
+
+    template <int16_t pinNum>
+    struct OutputPin : Pin<pinNum> {
+        OutputPin(const uint32_t options = kNormal) : Pin<pinNum>(kOutput, options) {};
+        OutputPin &operator=(const bool value) { Pin<pinNum>::write(value); return *this; };
+    };
+
+    template <int16_t pinNum>
+    struct InputPin : Pin<pinNum> {
+        InputPin(const uint32_t options = kPullUp) : Pin<pinNum>(kInput, options) {};
+    };
+
+    template <int16_t pinNum>
+    struct IRQPin : Pin<pinNum> {
+        std::function<void(void)> _interrupt_handler;
+
+        IRQPin(const uint32_t options, std::function<void(void)> &&handler,
+               const uint32_t interrupts = kPinInterruptOnChange|kPinInterruptPriorityMedium)
+            : Pin<pinNum>(kInput, options), _interrupt_handler {std::move(handler)} {};
+
+        void setInterrupts(const uint32_t interrupts) {};
+        void setInterruptHandler(std::function<void(void)> &&handler) { _interrupt_handler = std::move(handler); };
+    };
+
+    template <int16_t pinNum>
+    struct PWMOutputPin {
+        float _duty_cycle = 0.0;
+        uint32_t _frequency = 0;
+
+        PWMOutputPin() {};
+        PWMOutputPin(const uint32_t options, const uint32_t frequency = 1000) : _frequency {frequency} {};
+
+        static constexpr bool isNull() { return (pinNum < 0); };
+        void setFrequency(const uint32_t frequency) { _frequency = frequency; };
+        void setInterrupts(const uint32_t interrupts) {};
+        void write(const float value) { _duty_cycle = value; };
+        void set() { _duty_cycle = 1.0; };
+        void clear() { _duty_cycle = 0.0; };
+        void toggle() { _duty_cycle = (_duty_cycle > 0.0) ? 0.0 : 1.0; };
+        float read() { return (_duty_cycle); };
+        PWMOutputPin &operator=(const float value) { write(value); return *this; };
+        operator float() { return (_duty_cycle); };
+    };
+
+    template <int16_t pinNum>
+    struct PWMLikeOutputPin : PWMOutputPin<pinNum> {
+        PWMLikeOutputPin() : PWMOutputPin<pinNum>() {};
+        PWMLikeOutputPin(const uint32_t options, const uint32_t frequency = 1000) : PWMOutputPin<pinNum>(options, frequency) {};
+        PWMLikeOutputPin &operator=(const float value) { PWMOutputPin<pinNum>::write(value); return *this; };
+    };
+
+    template <int16_t pinNum>
+    struct ADCPin {
+        ADCPin() {};
+        ADCPin(const uint32_t options) {};
+
+        static constexpr bool isNull() { return (pinNum < 0); };
+        void setInterrupts(const uint32_t interrupts) {};
+        uint32_t getRaw() { return (0); };
+        uint32_t getValue() { return (0); };
+        int32_t getTop() { return (4095); };
+        void startSampling() {};
+
+        static void interrupt();    // specialized by the application, never called
+    };
+
+} // namespace Motate
+
+#include "motate_pin_assignments.h"
+
+#endif // End of include guard: MOTATE_PINS_H_ONCE
@@ -0,0 +1,59 @@
+/*
+ * MotateServiceCall.h - posix-sim stand-in for Motate software-triggered interrupts
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MOTATE_SERVICECALL_H_ONCE
+#define MOTATE_SERVICECALL_H_ONCE
+
+#include "MotateTimers.h"
+
+namespace Motate {
+
+    typedef const uint8_t service_call_number;
+
+    template <uint8_t serviceCallNum>
+    struct ServiceCall {
+        SimInterrupt _irq {&ServiceCall::interrupt, kSimPriorityLowest, false, false, nullptr};
+        uint32_t _interrupt_cause = 0;
+
+        ServiceCall() {};
+
+        void setInterrupts(const uint32_t interrupts) {
+            _irq.priority = _sim_priority(interrupts);
+            _irq.enabled = (interrupts != kInterruptsOff);
+            sim_register_interrupt(&_irq);
+        };
+
+        void setInterruptPending() { _interrupt_cause = kInterruptOnSoftwareTrigger; sim_set_pending(&_irq); };
+        uint32_t getInterruptCause() { uint32_t cause = _interrupt_cause; _interrupt_cause = 0; return cause; };
+
+        static void interrupt();    // specialized by the application
+    };
+
+} // namespace Motate
+
+#endif // End of include guard: MOTATE_SERVICECALL_H_ONCE
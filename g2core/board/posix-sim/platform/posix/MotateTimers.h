@@ -0,0 +1,190 @@
+/*
+ * MotateTimers.h - posix-sim stand-in for the Motate timers, SysTick and Timeout
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MOTATE_TIMERS_H_ONCE
+#define MOTATE_TIMERS_H_ONCE
+
+#include <stdint.h>
+#include <functional>
+#include "posix_sim.h"
+
+namespace Motate {
+
+    enum TimerMode {
+        kTimerUp            = 0,
+        kTimerUpToMatch     = 1,
+        kTimerUpDown        = 2,
+        kTimerUpDownToMatch = 3,
+    };
+
+    enum TimerChannelInterruptOptions {
+        kInterruptsOff              = 0,
+        kInterruptOnOverflow        = 1<<0,
+        kInterruptOnMatch           = 1<<1,
+        kInterruptOnSoftwareTrigger = 1<<2,
+
+        kInterruptPriorityHighest   = 1<<5,
+        kInterruptPriorityHigh      = 1<<6,
+        kInterruptPriorityMedium    = 1<<7,
+        kInterruptPriorityLow       = 1<<8,
+        kInterruptPriorityLowest    = 1<<9,
+    };
+
+    // map the Motate priority bits to a simulated NVIC priority
+    constexpr uint8_t _sim_priority(const uint32_t interrupts)
+    {
+        return ((interrupts & kInterruptPriorityHighest) ? kSimPriorityHighest :
+                (interrupts & kInterruptPriorityHigh)    ? kSimPriorityHigh :
+                (interrupts & kInterruptPriorityMedium)  ? kSimPriorityMedium :
+                (interrupts & kInterruptPriorityLow)     ? kSimPriorityLow :
+                                                           kSimPriorityLowest);
+    }
+
+    /*
+     * TimerChannel<> - only one TimerChannel may run periodically (the DDA timer).
+     *  Others are used as software-triggered interrupts.
+     */
+
+    template <uint8_t timerNum, uint8_t channelNum>
+    struct TimerChannel {
+        SimInterrupt _irq {&TimerChannel::interrupt, kSimPriorityLowest, false, false, nullptr};
+        uint32_t _frequency = 0;
+        uint32_t _interrupt_cause = 0;
+
+        TimerChannel() {};
+        TimerChannel(const TimerMode mode, const uint32_t freq) : _frequency{freq} {};
+
+        void setModeAndFrequency(const TimerMode mode, const uint32_t freq) { _frequency = freq; };
+
+        void setInterrupts(const uint32_t interrupts) {
+            _irq.priority = _sim_priority(interrupts);
+            _irq.enabled = (interrupts != kInterruptsOff);
+            sim_register_interrupt(&_irq);
+            if (interrupts & (kInterruptOnOverflow | kInterruptOnMatch)) {
+                sim_set_periodic_timer(&_irq, _frequency);
+            }
+        };
+
+        void setInterruptPending() { _interrupt_cause = kInterruptOnSoftwareTrigger; sim_set_pending(&_irq); };
+        uint32_t getInterruptCause() { uint32_t cause = _interrupt_cause; _interrupt_cause = 0; return cause; };
+
+        void start() { sim_start_periodic_timer(); };
+        void stop() { sim_stop_periodic_timer(); };
+
+        static void interrupt();    // specialized by the application
+    };
+
+    /*
+     * SysTick
+     */
+
+    struct SysTickEvent {
+        const std::function<void(void)> callback;
+        SysTickEvent *next;
+    };
+
+    struct SysTickTimer_t {
+        SysTickEvent *firstEvent = nullptr;
+
+        uint32_t getValue() { return (sim_systick_value()); };
+
+        void registerEvent(SysTickEvent *new_event) {
+            if (new_event->next != nullptr) {
+                return;                     // already registered somewhere in the list
+            }
+            if (firstEvent == nullptr) {
+                firstEvent = new_event;
+                return;
+            }
+            SysTickEvent *event = firstEvent;
+            while (event != new_event) {
+                if (event->next == nullptr) {
+                    event->next = new_event;
+                    return;
+                }
+                event = event->next;
+            }
+        };
+
+        void unregisterEvent(SysTickEvent *event_to_remove) {
+            if (firstEvent == event_to_remove) {
+                firstEvent = event_to_remove->next;
+                event_to_remove->next = nullptr;
+                return;
+            }
+            for (SysTickEvent *event = firstEvent; event != nullptr; event = event->next) {
+                if (event->next == event_to_remove) {
+                    event->next = event_to_remove->next;
+                    event_to_remove->next = nullptr;
+                    return;
+                }
+            }
+        };
+
+        void _handleEvents() {
+            SysTickEvent *event = firstEvent;
+            while (event != nullptr) {
+                SysTickEvent *next = event->next;   // the callback may unregister itself
+                event->callback();
+                event = next;
+            }
+        };
+    };
+
+    extern SysTickTimer_t SysTickTimer;
+
+    /*
+     * Timeout - non-blocking millisecond timeout
+     */
+
+    struct Timeout {
+        uint32_t start_, delay_;
+        Timeout() : start_ {0}, delay_ {0} {};
+
+        bool isSet() { return (start_ > 0); }
+        bool isPast() {
+            if (!isSet()) {
+                return false;
+            }
+            return ((SysTickTimer.getValue() - start_) > delay_);
+        };
+        void set(uint32_t delay) {
+            start_ = SysTickTimer.getValue();
+            if (start_ == 0) {
+                start_ = 1;         // zero means "not set"
+            }
+            delay_ = delay;
+        };
+        void clear() { start_ = 0; delay_ = 0; }
+    };
+
+    void delay(uint32_t microseconds);
+
+} // namespace Motate
+
+#endif // End of include guard: MOTATE_TIMERS_H_ONCE
@@ -0,0 +1,122 @@
+/*
+ * MotateUART.h - posix-sim stand-in for the Motate UART (stdin/stdout or a pty)
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Every UART<> on the host talks to the simulation console: stdin/stdout by default,
+ *  or a pseudo-terminal if the simulator was started with --pty (see posix_sim.cpp).
+ *
+ *  RX transfers are filled by polling the console (non-blocking) whenever the buffer
+ *  asks for the transfer position, which xio does every time it looks for a line.
+ *  TX transfers are written out synchronously and complete immediately.
+ *  The console is "connected" as soon as a connection callback is installed.
+ */
+
+#ifndef MOTATE_UART_H_ONCE
+#define MOTATE_UART_H_ONCE
+
+#include <stdint.h>
+#include <functional>
+#include "MotatePins.h"
+
+namespace Motate {
+
+    void sim_console_set_fds(int fd_in, int fd_out);
+    int sim_console_read(char *buffer, uint16_t length);         // returns bytes read, 0 if none
+    void sim_console_write(const char *buffer, uint16_t length);
+
+    enum class UARTMode {
+        NoParity                = 0,
+        RTSCTSFlowControl       = 1<<1,
+        XonXoffFlowControl      = 1<<2,
+    };
+
+    struct _SimUART {
+        std::function<void(bool)> _connection_callback;
+        std::function<void(void)> _rx_done_callback;
+        std::function<void(void)> _tx_done_callback;
+
+        char *_rx_position = nullptr;
+        uint16_t _rx_remaining = 0;
+        bool _rx_active = false;
+        char *_tx_position = nullptr;
+
+        void init() {};
+
+        void setConnectionCallback(std::function<void(bool)> &&callback) {
+            _connection_callback = std::move(callback);
+            _connection_callback(true);
+        };
+
+        const char *getRXTransferPosition() {
+            if (_rx_active) {
+                int count = sim_console_read(_rx_position, _rx_remaining);
+                _rx_position += count;
+                _rx_remaining -= count;
+                if (_rx_remaining == 0) {
+                    _rx_active = false;
+                    if (_rx_done_callback) {
+                        _rx_done_callback();            // may start the next transfer
+                    }
+                }
+            }
+            return _rx_position;
+        };
+
+        void setRXTransferDoneCallback(std::function<void(void)> &&callback) { _rx_done_callback = std::move(callback); };
+
+        bool startRXTransfer(char *&buffer, const uint16_t length) {
+            _rx_position = buffer;
+            _rx_remaining = length;
+            _rx_active = true;
+            return true;
+        };
+
+        const char *getTXTransferPosition() { return _tx_position; };
+
+        void setTXTransferDoneCallback(std::function<void(void)> &&callback) { _tx_done_callback = std::move(callback); };
+
+        bool startTXTransfer(char *&buffer, const uint16_t length) {
+            sim_console_write(buffer, length);
+            _tx_position = buffer + length;
+            if (_tx_done_callback) {
+                _tx_done_callback();
+            }
+            return true;
+        };
+
+        void flush() {};
+        void flushRead() {};
+    };
+
+    template <int16_t rxPinNumber, int16_t txPinNumber, int16_t rtsPinNumber = -1, int16_t ctsPinNumber = -1>
+    struct UART : _SimUART {
+        UART(const uint32_t baud = 115200, const UARTMode options = UARTMode::NoParity) {};
+    };
+
+} // namespace Motate
+
+#endif // End of include guard: MOTATE_UART_H_ONCE
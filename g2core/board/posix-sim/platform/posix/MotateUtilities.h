@@ -0,0 +1,57 @@
+/*
+ * MotateUtilities.h - posix-sim stand-in for the Motate utilities
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MOTATE_UTILITIES_H_ONCE
+#define MOTATE_UTILITIES_H_ONCE
+
+#include <stdint.h>
+#include <string.h>
+
+namespace Motate {
+
+    // constexpr strlen/strncpy, as used for compile-time strings in g2core
+    constexpr int strlen(const char *p) { return (*p != 0) ? (1 + strlen(p + 1)) : 0; }
+
+    inline char *strncpy(char *t, const char *f, int n)
+    {
+        return ::strncpy(t, f, n + 1);      // copy the terminating NUL as well
+    }
+
+    // host is little endian
+    inline uint16_t fromLittleEndian(const uint16_t value) { return value; }
+    inline uint32_t fromLittleEndian(const uint32_t value) { return value; }
+    inline uint16_t toLittleEndian(const uint16_t value) { return value; }
+    inline uint32_t toLittleEndian(const uint32_t value) { return value; }
+    inline uint16_t fromBigEndian(const uint16_t value) { return __builtin_bswap16(value); }
+    inline uint32_t fromBigEndian(const uint32_t value) { return __builtin_bswap32(value); }
+    inline uint16_t toBigEndian(const uint16_t value) { return __builtin_bswap16(value); }
+    inline uint32_t toBigEndian(const uint32_t value) { return __builtin_bswap32(value); }
+
+} // namespace Motate
+
+#endif // End of include guard: MOTATE_UTILITIES_H_ONCE
@@ -0,0 +1,1048 @@
+/*
+ * posix_bench.cpp - planner benchmark harness for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* See posix_bench.h for how to run the benchmark */
+
+#include "g2core.h"
+#include "config.h"
+#include "controller.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "plan_arc.h"
+#include "stepper.h"
+#include "encoder.h"
+#include "kinematics.h"
+#include "profiler.h"
+#include "posix_sim.h"
+#include "posix_bench.h"
+#include "posix_golden.h"
+#include "util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#if (PROFILER_ENABLED != true)
+#error "the benchmark takes its plan and exec timing from the profiler - see profiler.h"
+#endif
+
+#if (PLANNER_BENCHMARK_ENABLED != true)
+#error The posix-sim benchmark requires PLANNER_BENCHMARK_ENABLED
+#endif
+
+/**** Benchmark programs ****
+ *
+ *  The Gcode files are C strings. Each is included in its own namespace because
+ *  several of them use the same array name. Every file in Resources/gcode is here, the
+ *  nine larger ones first; where a file holds more than one program the first is used.
+ */
+
+#define PROGMEM
+
+namespace bench_roadrunner {
+#include "../../../../../Resources/gcode/gcode_roadrunner.h"
+}
+namespace bench_hacdc {
+#include "../../../../../Resources/gcode/gcode_hacdc.h"
+}
+namespace bench_braid2d {
+#include "../../../../../Resources/gcode/gcode_braid2d.h"
+}
+namespace bench_braid_short {
+#include "../../../../../Resources/gcode/gcode_braid_short.h"
+}
+namespace bench_mudflap {
+#include "../../../../../Resources/gcode/gcode_mudflap.h"
+}
+namespace bench_star {
+#include "../../../../../Resources/gcode/gcode_star_1x1.h"
+}
+namespace bench_xyzcurve {
+#include "../../../../../Resources/gcode/gcode_xyzcurve.h"
+}
+namespace bench_zoetrope {
+#include "../../../../../Resources/gcode/gcode_zoetrope.h"
+}
+namespace bench_contraptor {
+#include "../../../../../Resources/gcode/gcode_contraptor_circle.h"
+}
+namespace bench_bigcircle {
+#include "../../../../../Resources/gcode/gcode_bigcircle_smallcircle.h"
+}
+namespace bench_boxes {
+#include "../../../../../Resources/gcode/gcode_boxes_400mm.h"
+}
+namespace bench_braid_001 {
+#include "../../../../../Resources/gcode/gcode_braid_short_001.h"
+}
+namespace bench_braid_002 {
+#include "../../../../../Resources/gcode/gcode_braid_short_002.h"
+}
+namespace bench_circles2 {
+#include "../../../../../Resources/gcode/gcode_circles2.h"
+}
+namespace bench_debug {
+#include "../../../../../Resources/gcode/gcode_debug_tests.h"
+}
+namespace bench_drift {
+#include "../../../../../Resources/gcode/gcode_drift_pattern.h"
+}
+namespace bench_hokanson {
+#include "../../../../../Resources/gcode/gcode_hokanson.h"
+}
+namespace bench_infinity {
+#include "../../../../../Resources/gcode/gcode_infinity_002.h"
+}
+namespace bench_line_x {
+#include "../../../../../Resources/gcode/gcode_line_X_800mm.h"
+}
+namespace bench_line_xa {
+#include "../../../../../Resources/gcode/gcode_line_Xa_800mm.h"
+}
+namespace bench_mickey {
+#include "../../../../../Resources/gcode/gcode_mickey_test.h"
+}
+namespace bench_nfinity {
+#include "../../../../../Resources/gcode/gcode_nfinity_001.h"
+}
+namespace bench_reilly {
+#include "../../../../../Resources/gcode/gcode_reilly_111115.h"
+}
+namespace bench_pocket {
+#include "../../../../../Resources/gcode/gcode_square_pocket.h"
+}
+namespace bench_startup {
+#include "../../../../../Resources/gcode/gcode_startup_tests.h"
+}
+namespace bench_straight {
+#include "../../../../../Resources/gcode/gcode_straight_600mm.h"
+}
+namespace bench_test001 {
+#include "../../../../../Resources/gcode/gcode_test001.h"
+}
+namespace bench_test002 {
+#include "../../../../../Resources/gcode/gcode_test_002.h"
+}
+namespace bench_tests {
+#include "../../../../../Resources/gcode/gcode_tests.h"
+}
+namespace bench_blend {
+#include "../../../../../Resources/gcode/gcode_blend_polyline.h"
+}
+namespace bench_merge {
+#include "../../../../../Resources/gcode/gcode_merge_microsegments.h"
+}
+namespace bench_home_polar {
+#include "../../../../../Resources/gcode/gcode_home_polar.h"
+}
+namespace bench_center_polar {
+#include "../../../../../Resources/gcode/gcode_center_polar.h"
+}
+
+typedef struct benchProgram {
+    const char *name;
+    const char *gcode;
+} benchProgram_t;
+
+static const benchProgram_t _programs[] = {
+    { "roadrunner",    bench_roadrunner::roadrunner },
+    { "hacdc",         bench_hacdc::hacdc },
+    { "braid2d",       bench_braid2d::gcode_file },
+    { "braid_short",   bench_braid_short::gcode_file },
+    { "mudflap",       bench_mudflap::gcode_file },
+    { "star",          bench_star::gcode_file },
+    { "xyzcurve",      bench_xyzcurve::gcode_file },
+    { "zoetrope",      bench_zoetrope::zoetrope },
+    { "contraptor",    bench_contraptor::contraptor_circle },
+    { "bigcircle",     bench_bigcircle::gcode_file },
+    { "boxes",         bench_boxes::gcode_file },
+    { "braid_001",     bench_braid_001::braid2d },
+    { "braid_002",     bench_braid_002::braid2d },
+    { "circles2",      bench_circles2::gcode_file },
+    { "debug",         bench_debug::gcode_file },
+    { "drift",         bench_drift::gcode_file },
+    { "hokanson",      bench_hokanson::hokanson_02 },
+    { "infinity",      bench_infinity::gcode_file },
+    { "line_x",        bench_line_x::gcode_file },
+    { "line_xa",       bench_line_xa::line_X_800 },
+    { "mickey",        bench_mickey::gcode_file },
+    { "nfinity",       bench_nfinity::gcode_file },
+    { "reilly",        bench_reilly::gcode_file },
+    { "pocket",        bench_pocket::gcode_file },
+    { "startup",       bench_startup::startup_tests },
+    { "straight",      bench_straight::gcode_file },
+    { "test001",       bench_test001::gcode_file },
+    { "test002",       bench_test002::gcode_file },
+    { "tests",         bench_tests::gcode_file },
+    { "blend",         bench_blend::gcode_file },
+    { "merge",         bench_merge::gcode_file },
+    { "home_polar",    bench_home_polar::gcode_file },
+    { "center_polar",  bench_center_polar::gcode_file },
+};
+#define BENCH_PROGRAMS (sizeof(_programs) / sizeof(benchProgram_t))
+
+static const uint32_t kIdleMs = 100;        // machine must be idle this long to end a program
+
+/**** Benchmark state ****/
+
+typedef enum {
+    BENCH_OFF = 0,
+    BENCH_WAIT_READY,                       // wait for the controller to finish startup
+    BENCH_FEEDING,                          // feeding the program to the console
+    BENCH_DRAINING,                         // program fed, waiting for motion to end
+} benchState;
+
+static struct benchSingleton {
+    benchState state;
+    uint8_t selected[BENCH_PROGRAMS];       // program indexes to run, in order
+    uint8_t count;                          // number of selected programs
+    uint8_t current;                        // index into selected[]
+    const char *rd;                         // read pointer into the current program
+
+    uint32_t sim_start_ms;                  // simulated time the program started
+    uint32_t idle_start_ms;                 // simulated time the machine went idle (0 = not idle)
+    uint64_t host_start_ns;                 // host time the program started
+
+    bool failed;                            // a golden trajectory check failed
+    mpPlannerBenchmark_t total;             // totals over all programs
+    profStats_t plan_total;                 // _plan_block() and mp_exec_move() timing over all programs
+    profStats_t exec_total;
+    double sim_total_s;
+    double host_total_s;
+    double drift_max;                       // worst step drift at the end of a program
+} bench;
+
+/*
+ * sim_bench_select() - select programs by comma separated names, "all" or "list"
+ */
+
+bool sim_bench_select(const char *names)
+{
+    if (strcmp(names, "list") == 0) {
+        for (uint8_t i = 0; i < BENCH_PROGRAMS; i++) {
+            printf("%-12s %6u bytes\n", _programs[i].name, (unsigned)strlen(_programs[i].gcode));
+        }
+        exit(0);
+    }
+    bench.count = 0;
+    if (strcmp(names, "all") == 0) {
+        for (uint8_t i = 0; i < BENCH_PROGRAMS; i++) {
+            bench.selected[bench.count++] = i;
+        }
+    } else {
+        const char *name = names;
+        while (*name != 0) {
+            size_t len = strcspn(name, ",");
+            uint8_t i;
+            for (i = 0; i < BENCH_PROGRAMS; i++) {
+                if ((strlen(_programs[i].name) == len) && (strncmp(_programs[i].name, name, len) == 0)) {
+                    break;
+                }
+            }
+            if ((i == BENCH_PROGRAMS) || (bench.count == BENCH_PROGRAMS)) {
+                fprintf(stderr, "posix-sim: unknown benchmark '%.*s' (try --bench list)\n", (int)len, name);
+                return (false);
+            }
+            bench.selected[bench.count++] = i;
+            name += (name[len] == ',') ? len+1 : len;
+        }
+    }
+    bench.state = (bench.count > 0) ? BENCH_WAIT_READY : BENCH_OFF;
+    return (true);
+}
+
+bool sim_bench_active()
+{
+    return (bench.state != BENCH_OFF);
+}
+
+/*
+ * _reset_machine() - put the machine back in its power-up state between programs
+ * _start_program() - reset the counters and start feeding the next program
+ * _end_program()   - print the results for the program just finished
+ * _step_drift()    - steps the motors are off the commanded position, worst motor
+ */
+
+static void _reset_machine()
+{
+    if (kn.type != KINEMATICS) {                // a program may set $kty
+        kn.type = KINEMATICS;
+        kn_configure();
+    }
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        cm_set_position(axis, 0);               // machine is idle, so this is safe
+        cm.homed[axis] = false;
+    }
+    cm.homing_state = HOMING_NOT_HOMED;
+    canonical_machine_reset();                  // Gcode defaults - units, plane, coord system, path control...
+    cm_reset_origin_offsets();                  // G92.1
+    cm_set_feed_rate(0);
+    cm.gm.linenum = 0;                          // N words count from the start of each program
+    cm.gmx.last_line_number = 0;
+}
+
+static void _start_program()
+{
+    _reset_machine();
+    memset(&mp_bench, 0, sizeof(mp_bench));
+    prof_clear();
+    bench.rd = _programs[bench.selected[bench.current]].gcode;
+    bench.sim_start_ms = Motate::sim_systick_value();
+    bench.idle_start_ms = 0;
+    bench.host_start_ns = Motate::sim_host_ns();
+    sim_golden_begin(_programs[bench.selected[bench.current]].name);
+    bench.state = BENCH_FEEDING;
+}
+
+static double _step_drift()
+{
+    double drift = 0;
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        int32_t steps = en.en[motor].encoder_steps + en.en[motor].steps_run;   // counted by the DDA
+        drift = std::max(drift, fabs(steps - (double)mr.target_steps[motor]));
+    }
+    return (drift);
+}
+
+static double _ticks_to_ns(const double ticks)
+{
+    return (ticks * 1000.0 / PROFILER_TICKS_PER_US);
+}
+
+static void _print_result(const char *name, const mpPlannerBenchmark_t *b, const profStats_t *plan, const profStats_t *exec,
+                          double sim_s, double host_s, double drift)
+{
+    fprintf(stderr, "%-12s %7u blocks %6u merged %6u blended %8u segs  sim %8.2fs host %7.2fs | len %7.3fmm feed %6.0fmm/min"
+                    " | plan %9.0f blocks/s max %7.1fus back %5.1f/block jerk %5.1f%% | exec %9.0f segs/s max %7.1fus"
+                    " | starved %u underruns %u | drift %0.3f steps\n",
+            name, b->blocks, b->merges, b->blends, b->segments, sim_s, host_s,
+            (b->blocks > 0) ? b->length / b->blocks : 0.0, (sim_s > 0) ? b->length * 60.0 / sim_s : 0.0,
+            (plan->total > 0) ? (double)b->blocks * 1e9 / _ticks_to_ns(plan->total) : 0.0, _ticks_to_ns(plan->max) / 1000.0,
+            (b->blocks > 0) ? (double)b->back_plans / b->blocks : 0.0,
+            (b->jerk_calls > 0) ? 100.0 * b->jerk_hits / b->jerk_calls : 0.0,
+            (exec->total > 0) ? (double)b->segments * 1e9 / _ticks_to_ns(exec->total) : 0.0, _ticks_to_ns(exec->max) / 1000.0,
+            b->starvations, b->underruns, drift);
+}
+
+static void _end_program()
+{
+    double sim_s = (bench.idle_start_ms - bench.sim_start_ms) / 1000.0;
+    double host_s = (Motate::sim_host_ns() - bench.host_start_ns) / 1e9;
+
+    double drift = _step_drift();
+
+    const profStats_t *plan = &prof.point[PROF_PLAN_BLOCK];
+    const profStats_t *exec = &prof.point[PROF_EXEC_MOVE];
+    _print_result(_programs[bench.selected[bench.current]].name, &mp_bench, plan, exec, sim_s, host_s, drift);
+    if (!sim_golden_end()) {
+        bench.failed = true;
+    }
+
+    bench.total.blocks += mp_bench.blocks;
+    bench.total.merges += mp_bench.merges;
+    bench.total.blends += mp_bench.blends;
+    bench.total.jerk_calls += mp_bench.jerk_calls;
+    bench.total.jerk_hits += mp_bench.jerk_hits;
+    bench.total.plan_blocks += mp_bench.plan_blocks;
+    bench.total.back_plans += mp_bench.back_plans;
+    bench.total.length += mp_bench.length;
+    bench.total.segments += mp_bench.segments;
+    bench.total.starvations += mp_bench.starvations;
+    bench.total.underruns += mp_bench.underruns;
+    bench.plan_total.total += plan->total;
+    bench.exec_total.total += exec->total;
+    bench.plan_total.max = std::max(bench.plan_total.max, plan->max);
+    bench.exec_total.max = std::max(bench.exec_total.max, exec->max);
+    bench.sim_total_s += sim_s;
+    bench.host_total_s += host_s;
+    bench.drift_max = std::max(bench.drift_max, drift);
+
+    if (++bench.current < bench.count) {
+        _start_program();
+        return;
+    }
+    if (bench.count > 1) {
+        _print_result("total", &bench.total, &bench.plan_total, &bench.exec_total, bench.sim_total_s, bench.host_total_s, bench.drift_max);
+    }
+    exit(bench.failed ? 1 : 0);
+}
+
+/*
+ * _machine_is_idle() - true if the program has finished moving
+ *
+ *  The planner must be back in PLANNER_IDLE as well, or the first blocks of the next
+ *  program are primed one at a time rather than held in STARTUP (see mp_planner_callback()).
+ */
+
+static bool _machine_is_idle()
+{
+    return ((cm_get_machine_state() != MACHINE_CYCLE) && !mp_has_runnable_buffer() && !st_runtime_isbusy() &&
+            (mp.planner_state == PLANNER_IDLE));
+}
+
+/*
+ * sim_bench_read() - console input while the benchmark runs
+ *
+ *  Called from the main loop every time xio polls the console, so it also runs the
+ *  benchmark state machine. The console takes as much input as it has room for -
+ *  g2core's normal flow control (planner buffer headroom) paces the program.
+ */
+
+int sim_bench_read(char *buffer, uint16_t length)
+{
+    cmMachineState machine_state = cm_get_machine_state();
+    if ((machine_state == MACHINE_ALARM) || (machine_state == MACHINE_SHUTDOWN) || (machine_state == MACHINE_PANIC)) {
+        fprintf(stderr, "posix-sim: benchmark %s stopped by alarm (machine state %d)\n",
+                _programs[bench.selected[bench.current]].name, (int)machine_state);
+        exit(1);
+    }
+
+    switch (bench.state) {
+        case BENCH_WAIT_READY: {
+            if ((cs.controller_state == CONTROLLER_READY) && _machine_is_idle()) {
+                fprintf(stderr, "planner pool %u blocks", (unsigned)PLANNER_BUFFER_POOL_SIZE);
+                if (PLANNER_TIME_LOOKAHEAD == true) {
+                    fprintf(stderr, ", time look-ahead %0.0fms", (double)PLANNER_LOOKAHEAD_MS);
+                }
+                fprintf(stderr, "\n");
+                _start_program();
+            }
+            return (0);
+        }
+        case BENCH_FEEDING: {
+            int count = 0;
+            while ((count < length) && (*bench.rd != 0)) {
+                buffer[count++] = *bench.rd++;
+            }
+            if ((*bench.rd == 0) && (count < length)) {
+                buffer[count++] = '\n';         // in case the last line has no newline
+                bench.state = BENCH_DRAINING;
+            }
+            return (count);
+        }
+        case BENCH_DRAINING: {
+            if (!_machine_is_idle()) {
+                bench.idle_start_ms = 0;
+            } else if (bench.idle_start_ms == 0) {
+                bench.idle_start_ms = Motate::sim_systick_value();
+            } else if ((Motate::sim_systick_value() - bench.idle_start_ms) > kIdleMs) {
+                _end_program();
+            }
+            return (0);
+        }
+        default: { return (0); }
+    }
+}
+
+/*
+ * sim_bench_arcgen() - run the arc generator benchmark and exit
+ *
+ *  Each generator runs the same full circles - a 10mm radius turned through 0.01 radian
+ *  segments - and adds every point it makes into a volatile so none of the work can be
+ *  dropped. The small angle generator is fed the step with a little jitter, as segment
+ *  lengths vary through the head and tail of a native arc.
+ */
+
+static const float kArcRadius = 10.0;
+static const float kArcStep = 0.01;                 // radians per segment
+static const uint32_t kArcSegments = 628;           // segments per circle
+
+typedef enum {
+    ARCGEN_TRIG = 0,                                // sin() and cos() every segment
+    ARCGEN_ROTATE,                                  // fixed rotation, exact resync
+    ARCGEN_ROTATE_SMALL,                            // small angle rotation, exact resync
+} arcgenMethod;
+
+typedef struct arcgenState {
+    float theta;
+    float vector_0;
+    float vector_1;
+    uint8_t resync_count;
+} arcgenState_t;
+
+static void _arcgen_start(arcgenState_t *a)
+{
+    a->theta = 0;
+    a->vector_0 = 0;
+    a->vector_1 = kArcRadius;
+    a->resync_count = ARC_RESYNC_SEGMENTS;
+}
+
+static float _arcgen_step(arcgenMethod method, uint32_t i)
+{
+    return ((method == ARCGEN_ROTATE_SMALL) ? kArcStep * (1 + 0.25 * (float)(i & 7) / 7) : kArcStep);
+}
+
+static inline void _arcgen_next(arcgenMethod method, arcgenState_t *a, const float step,
+                                const float sin_step, const float cos_step)
+{
+    a->theta += step;
+    if ((method == ARCGEN_TRIG) || (--a->resync_count == 0)) {
+        a->resync_count = ARC_RESYNC_SEGMENTS;
+        a->vector_0 = sin(a->theta) * kArcRadius;
+        a->vector_1 = cos(a->theta) * kArcRadius;
+    } else if (method == ARCGEN_ROTATE) {
+        arc_rotate(a->vector_0, a->vector_1, sin_step, cos_step);
+    } else {
+        arc_rotate_small(a->vector_0, a->vector_1, step);
+    }
+}
+
+static double _arcgen_run(arcgenMethod method, uint32_t segments, double *max_error)
+{
+    volatile float sink = 0;
+    const float sin_step = sin(kArcStep);
+    const float cos_step = cos(kArcStep);
+    arcgenState_t a;
+
+    uint64_t start_ns = Motate::sim_host_ns();
+    for (uint32_t i = 0; i < segments; i++) {
+        if ((i % kArcSegments) == 0) {
+            _arcgen_start(&a);
+        }
+        _arcgen_next(method, &a, _arcgen_step(method, i), sin_step, cos_step);
+        sink = sink + a.vector_0 + a.vector_1;
+    }
+    double host_s = (Motate::sim_host_ns() - start_ns) / 1e9;
+
+    double theta = 0;                               // one circle again, untimed, against the exact points
+    *max_error = 0;
+    _arcgen_start(&a);
+    for (uint32_t i = 0; i < kArcSegments; i++) {
+        const float step = _arcgen_step(method, i);
+        theta += step;
+        _arcgen_next(method, &a, step, sin_step, cos_step);
+        *max_error = std::max(*max_error, hypot(a.vector_0 - ::sin(theta) * kArcRadius,
+                                                a.vector_1 - ::cos(theta) * kArcRadius));
+    }
+    return ((host_s > 0) ? segments / host_s : 0.0);
+}
+
+void sim_bench_arcgen(uint32_t segments)
+{
+    static const char *names[] = { "sin/cos", "rotate", "rotate small" };
+    double trig_rate = 0;
+
+    fprintf(stderr, "arc generators, %u segments of %0.3f radians on a %0.0fmm radius, resync every %u\n",
+            (unsigned)segments, (double)kArcStep, (double)kArcRadius, (unsigned)ARC_RESYNC_SEGMENTS);
+    for (uint8_t method = ARCGEN_TRIG; method <= ARCGEN_ROTATE_SMALL; method++) {
+        double max_error;
+        double rate = _arcgen_run((arcgenMethod)method, segments, &max_error);
+        if (method == ARCGEN_TRIG) {
+            trig_rate = rate;
+        }
+        fprintf(stderr, "%-12s %11.0f segs/s  x%4.2f | max error %0.6fmm\n",
+                names[method], rate, (trig_rate > 0) ? rate / trig_rate : 0.0, max_error);
+    }
+    exit(0);
+}
+
+/*
+ * sim_bench_zoid() - run the ramp solver benchmark and exit
+ *
+ *  Solves the same generated cases with the Newton iterations plan_zoid.cpp used to run
+ *  and with the current solvers (see Ramp solvers in planner.h). Jerks run from 10 to
+ *  100,000 (x 1,000,000), velocities from 0 to 50,000 mm/min and - for the meet velocity -
+ *  lengths from half to 20 times the ramp between the entry and exit velocities, so both
+ *  sides of the no-meet boundary of ZOID_EXIT_3c are covered. Decelerations are from 1 to
+ *  50,000 mm/min over up to all of the braking length, as in a feedhold. The s-curve cases
+ *  also draw a deceleration jerk ratio from 1/3 to 3 and, for 4 in 5 of them, an
+ *  acceleration limit that puts the plateau anywhere in the same velocity range.
+ *
+ *  The worst case time of each solver is the slowest case, each case timed as the fastest
+ *  of kZoidTrials runs of kZoidRepeats calls so host interrupts don't count. The error is
+ *  the velocity returned against the root found by bisection in double, relative to the
+ *  root for the meet velocity and to v_0 for the deceleration.
+ *
+ *  It is also the check that the velocities the planner now plans with are right: each
+ *  current solver's error must stay under its bound in kZoidErrorMax, or the benchmark says
+ *  which one failed and exits 1. The old Newton iterations are only reported - their error
+ *  is what moved the recorded golden trajectories when they were replaced.
+ */
+
+static const uint8_t kZoidRepeats = 16;
+static const uint8_t kZoidTrials = 3;
+
+typedef struct zoidCase {
+    float jerk;
+    float jerk_ratio;                               // s-curve cases only
+    float accel;                                    // s-curve cases only, 0 for no limit
+    float v_0;
+    float v_2;                                      // exit velocity (meet) - unused for decel
+    float L;
+} zoidCase_t;
+
+typedef enum {
+    ZOID_MEET_NEWTON = 0,
+    ZOID_MEET,
+    ZOID_MEET_SCURVE,
+    ZOID_DECEL_NEWTON,
+    ZOID_DECEL,
+    ZOID_DECEL_SCURVE,
+    ZOID_SOLVERS
+} zoidSolver;
+
+static const double kZoidErrorMax[ZOID_SOLVERS] = {   // 0 = not checked
+    0,                                              // meet newton
+    MEET_TOLERANCE,                                 // meet - stops within MEET_TOLERANCE of the length
+    MEET_TOLERANCE,                                 // meet s-curve
+    0,                                              // decel newton
+    0.00001,                                        // decel - float precision, less near the double root
+    0.00001                                         // decel s-curve
+};
+
+static uint32_t _zoid_seed = 12345;
+
+static double _zoid_random()                        // 0 to 1 - xorshift, so every run solves the same cases
+{
+    _zoid_seed ^= _zoid_seed << 13;
+    _zoid_seed ^= _zoid_seed >> 17;
+    _zoid_seed ^= _zoid_seed << 5;
+    return (_zoid_seed / 4294967296.0);
+}
+
+static void _zoid_set_ramp(mpRamp_t *ramp, const float jerk, const float dv_plateau)
+{
+    ramp->jerk = jerk;
+    ramp->sqrt_j = sqrt(jerk);
+    ramp->q_recip_2_sqrt_j = 2.40281141413 / (2 * ramp->sqrt_j);
+    ramp->dv_plateau = dv_plateau;
+    ramp->plateau_k = (dv_plateau > 0) ? ramp->q_recip_2_sqrt_j / (2 * sqrt(dv_plateau)) : 0;
+}
+
+static void _zoid_set_case(mpBuf_t *bf, const zoidCase_t *c, const bool scurve)    // as _calculate_jerk() would
+{
+    bf->jerk = c->jerk;
+    if (!scurve) {
+        bf->ramp_profile = RAMP_QUINTIC;
+        _zoid_set_ramp(&bf->head, c->jerk, 0);
+        bf->tail = bf->head;
+        return;
+    }
+    const float tail_jerk = c->jerk * c->jerk_ratio;
+    bf->ramp_profile = RAMP_SCURVE;
+    _zoid_set_ramp(&bf->head, c->jerk * SCURVE_JERK_FACTOR, c->accel * c->accel / c->jerk);
+    _zoid_set_ramp(&bf->tail, tail_jerk * SCURVE_JERK_FACTOR, c->accel * c->accel / tail_jerk);
+}
+
+static double _zoid_length(const mpRamp_t *ramp, const double v_0, const double v_1)
+{
+    const double dv = fabs(v_1 - v_0);
+    if ((ramp->dv_plateau > 0) && (dv > ramp->dv_plateau)) {
+        return (ramp->q_recip_2_sqrt_j * (dv + ramp->dv_plateau) / (2 * ::sqrt((double)ramp->dv_plateau)) * (v_1 + v_0));
+    }
+    return (ramp->q_recip_2_sqrt_j * ::sqrt(dv) * (v_1 + v_0));
+}
+
+static double _zoid_exact_meet(const mpBuf_t *bf, const zoidCase_t *c)     // -1 if there is no meet velocity
+{
+    double lo = std::max(c->v_0, c->v_2);
+    if (c->L <= _zoid_length((c->v_0 < c->v_2) ? &bf->head : &bf->tail, c->v_0, c->v_2)) {
+        return (-1);
+    }
+    double hi = lo + 1;
+    while ((_zoid_length(&bf->head, c->v_0, hi) + _zoid_length(&bf->tail, hi, c->v_2)) < c->L) {
+        hi = lo + (hi - lo) * 2;
+    }
+    for (uint8_t i = 0; i < 100; i++) {
+        double mid = (lo + hi) / 2;
+        if ((_zoid_length(&bf->head, c->v_0, mid) + _zoid_length(&bf->tail, mid, c->v_2)) < c->L) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo);
+}
+
+static double _zoid_exact_decel(const mpBuf_t *bf, const zoidCase_t *c)
+{
+    const double dv_plateau = bf->tail.dv_plateau;
+    double lo = c->v_0;                             // the length grows as v_1 comes down from v_0...
+    double hi = c->v_0 / 3;                         // ...to its maximum
+    if ((dv_plateau > 0) && (dv_plateau < c->v_0 * 2 / 3)) {
+        hi = dv_plateau / 2;                        // ...which is on the plateau
+    }
+    for (uint8_t i = 0; i < 100; i++) {
+        double mid = (lo + hi) / 2;
+        if (_zoid_length(&bf->tail, mid, c->v_0) < c->L) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo);
+}
+
+// the meet velocity Newton iteration plan_zoid.cpp used to run - returns iterations in bf->meet_iterations
+static float _newton_meet_velocity(const float v_0, const float v_2, const float L, mpBuf_t* bf, mpBlockRuntimeBuf_t* block)
+{
+    const float q_recip_2_sqrt_j = bf->head.q_recip_2_sqrt_j;
+    const float min_v_1 = std::max(v_0, v_2);
+    float v_1 = mp_get_target_velocity(min_v_1, L / 2.0, &bf->head);
+
+    if (fp_EQ(v_0, v_2)) {
+        block->head_length = L / 2.0;
+        block->body_length = 0;
+        block->tail_length = L - block->head_length;
+        bf->meet_iterations = -1;
+        return v_1;
+    }
+    int i = 0;
+    while (i++ < 30) {
+        if (v_1 < min_v_1) {
+            v_1 = min_v_1;
+            if (v_0 < v_2) {
+                block->head_length = mp_get_target_length(v_0, v_2, &bf->head);
+                if (block->head_length > L) {
+                    block->head_length = L;
+                    block->body_length = 0;
+                    v_1 = mp_get_target_velocity(v_0, L, &bf->head);
+                } else {
+                    block->body_length = L - block->head_length;
+                }
+                block->tail_length = 0;
+            } else {
+                block->tail_length = mp_get_target_length(v_2, v_0, &bf->head);
+                if (block->tail_length > L) {
+                    block->tail_length = L;
+                    block->body_length = 0;
+                    v_1 = mp_get_target_velocity(v_2, L, &bf->head);
+                } else {
+                    block->body_length = L - block->tail_length;
+                }
+                block->head_length = 0;
+            }
+            break;
+        }
+        const float sqrt_delta_v_0 = sqrt(fabs(v_1 - v_0));
+        const float sqrt_delta_v_2 = sqrt(fabs(v_1 - v_2));
+        const float l_h = q_recip_2_sqrt_j * (sqrt_delta_v_0 * (v_1 + v_0));
+        const float l_t = q_recip_2_sqrt_j * (sqrt_delta_v_2 * (v_1 + v_2));
+        const float l_c = (l_h + l_t) - L;
+
+        block->head_length = l_h;
+        block->tail_length = l_t;
+        block->body_length = 0;
+        if ((l_c < 0.00001) && (l_c > -1.0)) {
+            if (l_c < 0.0) {
+                block->body_length = -l_c;
+            } else {
+                block->tail_length = L - block->head_length;
+            }
+            break;
+        }
+        const float v_1x3 = 3 * v_1;
+        const float recip_l_d = (2 * sqrt_delta_v_0 * sqrt_delta_v_2) /
+                                ((sqrt_delta_v_0 * (v_1x3 - v_2) - (v_0 - v_1x3) * sqrt_delta_v_2) * q_recip_2_sqrt_j);
+        v_1 = v_1 - (l_c * recip_l_d);
+    }
+    bf->meet_iterations = i;
+    return v_1;
+}
+
+// the deceleration Newton iteration plan_zoid.cpp used to run - returns iterations in bf->meet_iterations
+static float _newton_decel_velocity(const float v_0, const float L, mpBuf_t* bf)
+{
+    const float q_recip_2_sqrt_j = bf->head.q_recip_2_sqrt_j;
+    float v_1 = 0;
+    bool first_pass = true;
+
+    int i = 0;
+    while (i++ < 10) {
+        const float sqrt_delta_v_0 = sqrt(v_0 - v_1);
+        const float l_t = q_recip_2_sqrt_j * (sqrt_delta_v_0 * (v_1 + v_0)) - L;
+        if (fabs(l_t) < 0.00001) {
+            break;
+        }
+        if (first_pass && (l_t > 0)) {
+            v_1 = v_0 - 0.001;
+            first_pass = false;
+            continue;
+        }
+        const float v_1x3 = 3 * v_1;
+        const float recip_l_t = (2 * sqrt_delta_v_0) / ((v_0 - v_1x3) * q_recip_2_sqrt_j);
+        v_1 = v_1 - (l_t * recip_l_t);
+    }
+    bf->meet_iterations = i;
+    return v_1;
+}
+
+static inline float _zoid_solve(zoidSolver solver, const zoidCase_t *c, mpBuf_t *bf, mpBlockRuntimeBuf_t *block)
+{
+    switch (solver) {
+        case ZOID_MEET_NEWTON:  return (_newton_meet_velocity(c->v_0, c->v_2, c->L, bf, block));
+        case ZOID_MEET:
+        case ZOID_MEET_SCURVE:  return (mp_get_meet_velocity(c->v_0, c->v_2, c->L, bf, block));
+        case ZOID_DECEL_NEWTON: return (_newton_decel_velocity(c->v_0, c->L, bf));
+        default:                bf->meet_iterations = DECEL_NEWTON_STEPS;
+                                return (mp_get_decel_velocity(c->v_0, c->L, &bf->tail));
+    }
+}
+
+static void _zoid_make_case(zoidCase_t *c, const bool meet, const bool scurve)
+{
+    c->jerk = pow(10, 7 + 4 * _zoid_random());
+    c->jerk_ratio = 1;
+    c->accel = 0;
+    if (scurve) {
+        c->jerk_ratio = pow(3, 2 * _zoid_random() - 1);
+        if (_zoid_random() < 0.8) {
+            c->accel = sqrt(pow(10, 4.7 * _zoid_random()) * c->jerk);      // dV* of 1 to 50,000 mm/min
+        }
+    }
+    mpBuf_t bf;
+    _zoid_set_case(&bf, c, scurve);
+    if (meet) {
+        c->v_0 = (_zoid_random() < 0.1) ? 0 : pow(10, 4.7 * _zoid_random());
+        c->v_2 = (_zoid_random() < 0.1) ? 0 : pow(10, 4.7 * _zoid_random());
+        const mpRamp_t *ramp = (c->v_0 < c->v_2) ? &bf.head : &bf.tail;
+        c->L = _zoid_length(ramp, c->v_0, c->v_2) * pow(40, _zoid_random()) / 2 + 0.0001;
+    } else {
+        c->v_0 = pow(10, 4.7 * _zoid_random());
+        c->v_2 = 0;
+        c->L = _zoid_length(&bf.tail, c->v_0, 0) * (0.0001 + 0.9998 * _zoid_random());
+    }
+}
+
+void sim_bench_zoid(uint32_t cases)
+{
+    static const char *names[ZOID_SOLVERS] = { "meet newton", "meet", "meet s-curve", "decel newton", "decel", "decel s-curve" };
+    zoidCase_t *meet = (zoidCase_t *)malloc(cases * sizeof(zoidCase_t));
+    zoidCase_t *meet_scurve = (zoidCase_t *)malloc(cases * sizeof(zoidCase_t));
+    zoidCase_t *decel = (zoidCase_t *)malloc(cases * sizeof(zoidCase_t));
+    zoidCase_t *decel_scurve = (zoidCase_t *)malloc(cases * sizeof(zoidCase_t));
+    mpBuf_t bf;
+    mpBlockRuntimeBuf_t block;
+    volatile float sink = 0;
+    bool failed = false;
+
+    for (uint32_t i = 0; i < cases; i++) {
+        _zoid_make_case(&meet[i], true, false);
+        _zoid_make_case(&decel[i], false, false);
+    }
+    for (uint32_t i = 0; i < cases; i++) {          // after the quintic cases, so those don't change
+        _zoid_make_case(&meet_scurve[i], true, true);
+        _zoid_make_case(&decel_scurve[i], false, true);
+    }
+
+    fprintf(stderr, "ramp solvers, %u cases each, worst case timed as the best of %u runs of %u calls\n",
+            (unsigned)cases, kZoidTrials, kZoidRepeats);
+    for (uint8_t solver = 0; solver < ZOID_SOLVERS; solver++) {
+        const zoidCase_t *c = (solver == ZOID_MEET_SCURVE)  ? meet_scurve :
+                              (solver == ZOID_DECEL_SCURVE) ? decel_scurve :
+                              (solver < ZOID_DECEL_NEWTON)  ? meet : decel;
+        const bool scurve = (solver == ZOID_MEET_SCURVE) || (solver == ZOID_DECEL_SCURVE);
+        double worst_ns = 0;
+        double worst_error = 0;
+        int8_t max_iterations = 0;
+
+        uint64_t start_ns = Motate::sim_host_ns();
+        for (uint32_t i = 0; i < cases; i++) {
+            _zoid_set_case(&bf, &c[i], scurve);
+            sink = sink + _zoid_solve((zoidSolver)solver, &c[i], &bf, &block);
+        }
+        double mean_ns = (double)(Motate::sim_host_ns() - start_ns) / cases;
+
+        for (uint32_t i = 0; i < cases; i++) {
+            _zoid_set_case(&bf, &c[i], scurve);
+            double case_ns = 1e9;
+            for (uint8_t trial = 0; trial < kZoidTrials; trial++) {
+                uint64_t t = Motate::sim_host_ns();
+                for (uint8_t r = 0; r < kZoidRepeats; r++) {
+                    sink = sink + _zoid_solve((zoidSolver)solver, &c[i], &bf, &block);
+                }
+                case_ns = std::min(case_ns, (double)(Motate::sim_host_ns() - t) / kZoidRepeats);
+            }
+            worst_ns = std::max(worst_ns, case_ns);
+
+            const double v_1 = _zoid_solve((zoidSolver)solver, &c[i], &bf, &block);
+            max_iterations = std::max(max_iterations, bf.meet_iterations);
+            if (solver >= ZOID_DECEL_NEWTON) {
+                worst_error = std::max(worst_error, fabs(v_1 - _zoid_exact_decel(&bf, &c[i])) / c[i].v_0);
+            } else {
+                const double exact = _zoid_exact_meet(&bf, &c[i]);
+                if (exact > 0) {
+                    worst_error = std::max(worst_error, fabs(v_1 - exact) / exact);
+                }
+            }
+        }
+        const bool fail = (kZoidErrorMax[solver] > 0) && (worst_error > kZoidErrorMax[solver]);
+        fprintf(stderr, "%-13s mean %6.1fns worst %6.1fns | max %2d iterations | velocity error %0.2e%s\n",
+                names[solver], mean_ns, worst_ns, max_iterations, worst_error,
+                (kZoidErrorMax[solver] > 0) ? (fail ? " | FAIL" : " | PASS") : "");
+        failed = failed || fail;
+    }
+    free(meet);
+    free(meet_scurve);
+    free(decel);
+    free(decel_scurve);
+    exit(failed ? 1 : 0);
+}
+
+/*
+ * sim_bench_kin() - run the kinematics benchmark and exit
+ *
+ *  Runs every $kty module over the same path - arcs of up to 1 1/2 turns each way at about
+ *  a degree per segment, swept in and out across the reach of the delta and SCARA
+ *  geometries - and times the module's inverse transform and the whole of
+ *  kn_inverse_kinematics() (module, motor mapping and the profiler point) per call, as the
+ *  fastest of kKinTrials runs. The mapping is what's left of the latter after the module
+ *  and an empty profiler point. The error is the largest distance between a point and the
+ *  forward transform of its joints. kn_forward_kinematics() is timed on the steps of the
+ *  path (moving) and on the same steps over and over (at rest, from its cache).
+ */
+
+static const uint8_t kKinTrials = 5;
+static const float kKinSteps = 500;                 // path angle 3 pi sin(i / kKinSteps)
+
+static void _kin_point(const uint32_t i, const float reach_min, const float reach_max, float travel[])
+{
+    const float theta = 3 * M_PI * sin(i / kKinSteps);     // 1 1/2 turns each way, across the atan2() seam
+    const float radius = reach_min + (reach_max - reach_min) * (0.5 - 0.5 * cos(i * 0.0011));
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        travel[axis] = 0;
+    }
+    travel[AXIS_X] = radius * cos(theta);
+    travel[AXIS_Y] = radius * sin(theta);
+    travel[AXIS_Z] = 20 * sin(i * 0.0007);
+    travel[AXIS_A] = 30 * sin(i * 0.0009);                 // trunnion tilt and table
+    travel[AXIS_C] = theta * RADIAN;
+}
+
+void sim_bench_kin(uint32_t points)
+{
+    static const char *names[KINEMATICS_TYPES] = { "cartesian", "corexy", "delta", "scara", "polar", "trunnion" };
+    float *path = (float *)malloc(points * AXES * sizeof(float));
+    float *path_steps = (float *)malloc(points * MOTORS * sizeof(float));
+    float joint[AXES], back[AXES], steps[MOTORS];
+    volatile float sink = 0;
+    double base_ns = 0;
+
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {     // motor n on axis n, as on a 6 axis machine
+        st_cfg.mot[motor].motor_map = motor % AXES;
+        st_cfg.mot[motor].steps_per_unit = 80 * (motor + 1);
+        st_cfg.mot[motor].units_per_step = 1 / st_cfg.mot[motor].steps_per_unit;
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        cm.a[axis].axis_mode = AXIS_STANDARD;
+    }
+    kn.delta_radius = 100;
+    kn.delta_rod_length = 250;
+    kn.scara_proximal = 200;
+    kn.scara_distal = 150;
+    kn.trunnion_tilt = 0;
+    kn.pivot[0] = 0;
+    kn.pivot[1] = 0;
+    kn.pivot[2] = -50;
+
+    double prof_ns = 1e12;                          // an empty profiler point, to take out of the mapping
+    for (uint8_t trial = 0; trial < kKinTrials; trial++) {
+        uint64_t t = Motate::sim_host_ns();
+        for (uint32_t i = 0; i < points; i++) {
+            PROF_START(prof_start);
+            PROF_END(prof_start, PROF_KINEMATICS);
+        }
+        prof_ns = std::min(prof_ns, (double)(Motate::sim_host_ns() - t) / points);
+    }
+
+    fprintf(stderr, "kinematics, %u points, delta radius %0.0f rods %0.0f, scara arms %0.0f and %0.0f, trunnion pivot Z %0.0f (mm)\n",
+            (unsigned)points, kn.delta_radius, kn.delta_rod_length, kn.scara_proximal, kn.scara_distal, kn.pivot[2]);
+    for (uint8_t type = KINEMATICS_CARTESIAN; type < KINEMATICS_TYPES; type++) {
+        kn.type = type;
+        const float reach_min = (type == KINEMATICS_SCARA) ? 80 : 0;
+        const float reach_max = (type == KINEMATICS_DELTA) ? 120 : 320;
+        for (uint32_t i = 0; i < points; i++) {
+            _kin_point(i, reach_min, reach_max, &path[i * AXES]);
+        }
+
+        double module_ns = 1e12;
+        double total_ns = 1e12;
+        for (uint8_t trial = 0; trial < kKinTrials; trial++) {
+            kn_configure();
+            uint64_t t = Motate::sim_host_ns();
+            for (uint32_t i = 0; i < points; i++) {
+                kn.inverse(&path[i * AXES], joint);
+                sink = sink + joint[AXIS_X];
+            }
+            module_ns = std::min(module_ns, (double)(Motate::sim_host_ns() - t) / points);
+
+            kn_configure();
+            t = Motate::sim_host_ns();
+            for (uint32_t i = 0; i < points; i++) {
+                kn_inverse_kinematics(&path[i * AXES], steps);
+                sink = sink + steps[0];
+            }
+            total_ns = std::min(total_ns, (double)(Motate::sim_host_ns() - t) / points);
+        }
+        if (type == KINEMATICS_CARTESIAN) {
+            base_ns = module_ns;
+        }
+
+        kn_configure();
+        for (uint32_t i = 0; i < points; i++) {
+            kn_inverse_kinematics(&path[i * AXES], &path_steps[i * MOTORS]);
+        }
+        double forward_ns = 1e12;
+        double rest_ns = 1e12;
+        for (uint8_t trial = 0; trial < kKinTrials; trial++) {
+            uint64_t t = Motate::sim_host_ns();
+            for (uint32_t i = 0; i < points; i++) {
+                kn_forward_kinematics(&path_steps[i * MOTORS], back);
+                sink = sink + back[AXIS_X];
+            }
+            forward_ns = std::min(forward_ns, (double)(Motate::sim_host_ns() - t) / points);
+
+            t = Motate::sim_host_ns();
+            for (uint32_t i = 0; i < points; i++) {
+                kn_forward_kinematics(path_steps, back);
+                sink = sink + back[AXIS_X];
+            }
+            rest_ns = std::min(rest_ns, (double)(Motate::sim_host_ns() - t) / points);
+        }
+
+        double max_error = 0;
+        kn_configure();
+        for (uint32_t i = 0; i < points; i++) {
+            const float *travel = &path[i * AXES];
+            kn.inverse(travel, joint);
+            kn.forward(joint, back);
+            max_error = std::max(max_error, (double)sqrt(square(back[AXIS_X] - travel[AXIS_X]) +
+                                                         square(back[AXIS_Y] - travel[AXIS_Y]) +
+                                                         square(back[AXIS_Z] - travel[AXIS_Z])));
+        }
+        fprintf(stderr, "%-10s module %6.1fns (+%5.1fns) | kn_inverse_kinematics %6.1fns mapping %5.1fns | %s | round trip error %0.6fmm\n"
+                        "           kn_forward_kinematics %6.1fns moving %6.1fns at rest\n",
+                names[type], module_ns, module_ns - base_ns, total_ns, total_ns - module_ns - prof_ns,
+                kn.linear ? "linear    " : "non-linear", max_error, forward_ns, rest_ns);
+    }
+    free(path);
+    free(path_steps);
+    exit(0);
+}
@@ -0,0 +1,119 @@
+/*
+ * posix_bench.h - planner benchmark harness for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Planner benchmark ---
+ *
+ *  g2core-sim --bench <name>[,<name>...] | all | list  [--rate N]
+ *
+ *  Runs the Gcode files in Resources/gcode through the unmodified firmware - xio,
+ *  gcode_parser(), mp_aline(), mp_plan_block_list(), mp_exec_aline() and the DDA -
+ *  with the console fed from the file instead of stdin. Console output is discarded.
+ *  When the machine goes idle after the end of each file one line is printed on stderr:
+ *
+ *    blocks      blocks committed to the planner
+ *    merged      lines merged into the block before them instead (see Collinear merging)
+ *    blended     corners rounded with a blend arc (see Corner blending)
+ *    segs        aline segments prepped for the steppers
+ *    sim/host    seconds of simulated time and of host time the file took
+ *    len         mean length of the committed moves, in mm
+ *    feed        achieved feed rate - total move length over simulated time, in mm/min
+ *    plan        blocks per second of _plan_block() time, worst-case _plan_block(), and
+ *                blocks visited by back-planning per block committed, and the share of
+ *                _calculate_jerk() calls served from the jerk cache (see planner.h)
+ *    exec        segments per second of mp_exec_move() time, and worst-case mp_exec_move()
+ *    starved     times the exec reached a block that was not planned yet while in motion
+ *    underruns   times the DDA had no segment to load while in motion
+ *    drift       steps the DDA emitted off the commanded position once the program stopped,
+ *                worst motor (the total line has the worst program)
+ *
+ *  Before each file the machine is put back in its power-up state - position zeroed,
+ *  axes unhomed, $kty from the settings, Gcode defaults, G92 offsets and line number
+ *  cleared, planner idle - so a file gives the same result whether it runs alone or
+ *  anywhere in a list.
+ *
+ *  Comparing feed against len across the files shows how well the planner's look-ahead
+ *  copes with short segments. Build with a different PLANNER_BUFFER_POOL_SIZE or with
+ *  PLANNER_TIME_LOOKAHEAD (see planner.h) to compare look-ahead settings - the first line
+ *  printed shows the settings the build uses. Build with DDA_INTEGER_STEPS (see stepper.h)
+ *  to compare the two step generators.
+ *
+ *  The throughput and latency numbers are host CPU numbers and are meant for comparing
+ *  one build against another on the same host, not for predicting ARM timing.
+ *  Starvation depends on how fast simulated time runs: use --rate to compress time
+ *  and see how much headroom the planner has. Run with SETTINGS_FILE=settings_test.h
+ *  (or any profile that enables the axes).
+ *
+ *  The exit status is 0 if all files ran, 1 if the machine alarmed or a --golden
+ *  check failed (see posix_golden.h).
+ */
+/* --- Arc generator benchmark ---
+ *
+ *  g2core-sim --arcgen [segments]
+ *
+ *  Times the arc point generators on their own, outside the firmware: a sin() and cos()
+ *  per segment (what cm_arc_callback() used to do), rotation by a fixed step with exact
+ *  resync (cm_arc_callback()) and rotation by a varying small angle with exact resync
+ *  (native arcs in plan_exec.cpp) - see Incremental arc interpolation in plan_arc.h.
+ *  Prints segments per second and the largest distance from the exact point for each,
+ *  then exits. Like the planner benchmark these are host numbers, for comparing the
+ *  generators against each other rather than for predicting ARM timing.
+ */
+/* --- Ramp solver benchmark ---
+ *
+ *  g2core-sim --zoid [cases]
+ *
+ *  Times mp_get_meet_velocity() (the rate-limited ZOID_EXIT_3c case) and mp_get_decel_velocity()
+ *  (feedholds) against the Newton iterations they replaced - see Ramp solvers in planner.h.
+ *  Each is run over the same generated cases and printed with its mean and worst case time per
+ *  call, the most iterations it took and the worst relative error in the velocity it returned.
+ *  Host numbers again: the iteration counts carry over to ARM, the times only roughly. The
+ *  errors are checked - it exits 1 if a current solver is off the exact root by more than
+ *  its bound, so it can be run alongside the golden check.
+ */
+/* --- Kinematics benchmark ---
+ *
+ *  g2core-sim --kin [points]
+ *
+ *  Times each $kty module (see kinematics.h) on its own and inside kn_inverse_kinematics(),
+ *  which is what _exec_aline_segment() pays per segment, and checks each forward transform
+ *  against its inverse. Host numbers: read them against each other and against Cartesian,
+ *  and use {profi:n} on the board for the cost in the exec interrupt.
+ */
+
+#ifndef POSIX_BENCH_H_ONCE
+#define POSIX_BENCH_H_ONCE
+
+#include <stdint.h>
+
+bool sim_bench_select(const char *names);           // returns false if a name is unknown
+bool sim_bench_active(void);
+int sim_bench_read(char *buffer, uint16_t length);  // console input while the benchmark runs
+void sim_bench_arcgen(uint32_t segments);           // run the arc generator benchmark and exit
+void sim_bench_zoid(uint32_t cases);                // run the ramp solver benchmark and exit
+void sim_bench_kin(uint32_t points);                // run the kinematics benchmark and exit
+
+#endif // End of include guard: POSIX_BENCH_H_ONCE
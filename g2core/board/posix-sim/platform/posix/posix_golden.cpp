@@ -0,0 +1,492 @@
+/*
+ * posix_golden.cpp - golden trajectory regression checks for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* See posix_golden.h for how the golden trajectories are recorded and checked */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "util.h"
+#include "posix_golden.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#if (PLANNER_TRAJECTORY_HOOKS_ENABLED != true)
+#error The posix-sim golden trajectories require PLANNER_TRAJECTORY_HOOKS_ENABLED
+#endif
+
+static const double kVelocityTolerance = 0.001;     // segment velocity may exceed cruise_vmax by 0.1%
+static const double kJerkTolerance = 0.10;          // estimated jerk may exceed the block jerk by 10%
+static const double kBlockTolerance = 0.0001;       // relative difference for a block to count as changed
+static const float kPathSlack = 0.001;              // mm a segment end may be off the path beyond its tolerance
+static const float kArcSag = 0.0005;                // mm between a programmed arc and the chords it is checked on
+static const uint16_t kArcChordsMax = 4096;
+static const size_t kPathWindow = 4096;             // path pieces ahead of the last match searched for a segment end
+
+/**** Golden state ****/
+
+typedef enum {
+    GOLDEN_OFF = 0,
+    GOLDEN_RECORD,
+    GOLDEN_CHECK
+} goldenMode;
+
+static const char _block_header[] =
+    "# B line length v_entry v_cruise v_exit head_ms body_ms tail_ms jerk segments time_ms v_max a_max j_max end_position[AXES]\n";
+
+enum {                                  // indexes into goldenBlock_t.f
+    GB_LINE = 0, GB_LENGTH, GB_V_ENTRY, GB_V_CRUISE, GB_V_EXIT, GB_HEAD_MS, GB_BODY_MS, GB_TAIL_MS, GB_JERK,
+    GB_SEGMENTS, GB_TIME_MS, GB_V_MAX, GB_A_MAX, GB_J_MAX, GB_POSITION,
+    GB_FIELDS = GB_POSITION + AXES      // numbers on a block line (after the "B")
+};
+
+typedef struct goldenBlock {
+    double f[GB_FIELDS];                // fields in golden file order - see _block_header
+} goldenBlock_t;
+
+typedef struct goldenPath {             // a line of the programmed path, or a chord of an arc
+    float start[3];                     // XYZ
+    float end[3];
+    float tolerance;                    // how far the motion may be from it (G64 P + Q, or kArcSag)
+} goldenPath_t;
+
+static struct goldenSingleton {
+    goldenMode mode;
+    const char *dir;
+    double tolerance;                   // allowed relative change in total cycle time
+    char name[32];                      // current program
+
+    std::vector<goldenBlock_t> blocks;  // trajectory of the current program
+    bool in_block;                      // a block is being recorded
+    float v_limit;                      // cruise_vmax of the current block
+    float jerk_limit;                   // jerk of the current block (mm/min^3)
+    uint8_t section;                    // section of the previous segment
+    uint8_t samples;                    // segments in this section so far (for the derivatives)
+    float v_prev;                       // previous segment velocity
+    float a_prev;                       // previous acceleration estimate
+    float arc_jerk_limit;               // centripetal jerk limit of the current arc block (0 if a line)
+    float arc_planar_share;             // ...share of its path in the plane
+    float arc_radius;
+
+    std::vector<goldenPath_t> path;     // the programmed path of the current program
+    size_t path_cursor;                 // piece the last segment end was matched to
+    float path_deviation;               // farthest a segment end came from the programmed path
+
+    uint32_t violations;                // velocity, jerk or path tolerance violations
+    uint32_t first_violation_line;
+} golden;
+
+/*
+ * sim_golden_select() - select "record" or "check" into a directory
+ */
+
+bool sim_golden_select(const char *mode, const char *dir)
+{
+    if (strcmp(mode, "record") == 0) {
+        golden.mode = GOLDEN_RECORD;
+    } else if (strcmp(mode, "check") == 0) {
+        golden.mode = GOLDEN_CHECK;
+    } else {
+        return (false);
+    }
+    golden.dir = dir;
+    golden.tolerance = 0.0001;
+    return (true);
+}
+
+void sim_golden_set_tolerance(double percent)
+{
+    golden.tolerance = percent / 100;
+}
+
+bool sim_golden_active()
+{
+    return (golden.mode != GOLDEN_OFF);
+}
+
+/*
+ * _violation() - count a limit violation on the current block
+ * _copy3()     - copy the XYZ of a position
+ */
+
+static void _violation()
+{
+    if (golden.violations++ == 0) {
+        golden.first_violation_line = golden.blocks.back().f[GB_LINE];
+    }
+}
+
+static void _copy3(float dst[], const float src[])
+{
+    for (uint8_t i = 0; i < 3; i++) {
+        dst[i] = src[i];
+    }
+}
+
+/*
+ * mp_trajectory_path() - add a programmed line or arc to the path (planner trajectory hook)
+ *
+ *  Arcs are kept as chords no more than kArcSag from the arc, and the chords are given
+ *  that much tolerance.
+ */
+
+void mp_trajectory_path(const float start[], const float end[], const mpArcGeometry_t *arc, const float tolerance)
+{
+    if (golden.mode == GOLDEN_OFF) {
+        return;
+    }
+    goldenPath_t p;
+    p.tolerance = tolerance;
+    _copy3(p.start, start);
+    if (arc == NULL) {
+        _copy3(p.end, end);
+        golden.path.push_back(p);
+        return;
+    }
+    uint16_t chords = 1;
+    if (arc->radius > kArcSag) {
+        const float chord_theta = 2 * acos(1 - kArcSag / arc->radius);
+        chords = (uint16_t)std::min((float)kArcChordsMax, std::max((float)1, ceilf(fabs(arc->angular_travel) / chord_theta)));
+    }
+    p.tolerance = tolerance + kArcSag;
+    for (uint16_t i = 1; i <= chords; i++) {
+        const float fraction = (float)i / chords;
+        const float theta = arc->theta + fraction * arc->angular_travel;
+        _copy3(p.end, start);
+        p.end[arc->plane_axis_0] = arc->center_0 + sin(theta) * arc->radius;
+        p.end[arc->plane_axis_1] = arc->center_1 + cos(theta) * arc->radius;
+        p.end[arc->linear_axis] = arc->linear_start + fraction * arc->linear_travel;
+        golden.path.push_back(p);
+        _copy3(p.start, p.end);
+    }
+}
+
+/*
+ * _path_distance() - distance from a point to a piece of the path (XYZ)
+ * _check_path()    - a segment ended at point: it must be within tolerance of the path
+ *
+ *  The motion runs the path in order, so the segment end is matched to the first piece it
+ *  is close enough to, searching forward from the last match - or to the piece after that one
+ *  if it is clearly closer, as it is past a rounded corner. Paths that double back
+ *  on themselves are only told apart by order.
+ */
+
+static float _path_distance(const goldenPath_t &p, const float point[])
+{
+    float d[3], u[3];
+    float length_sq = 0, along = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        d[i] = point[i] - p.start[i];
+        u[i] = p.end[i] - p.start[i];
+        length_sq += u[i] * u[i];
+        along += d[i] * u[i];
+    }
+    const float t = (length_sq > 0) ? std::min(std::max(along / length_sq, 0.0f), 1.0f) : 0;
+    return (sqrt(square(d[0] - t*u[0]) + square(d[1] - t*u[1]) + square(d[2] - t*u[2])));
+}
+
+static void _check_path(const float point[])
+{
+    float closest = -1;
+    const size_t last = std::min(golden.path.size(), golden.path_cursor + kPathWindow);
+    for (size_t i = golden.path_cursor; i < last; i++) {
+        float distance = _path_distance(golden.path[i], point);
+        if (distance <= golden.path[i].tolerance + kPathSlack) {
+            if ((i+1 < golden.path.size()) && (_path_distance(golden.path[i+1], point) < distance - kPathSlack)) {
+                distance = _path_distance(golden.path[i+1], point);     // past a corner - take the closer piece
+                i++;
+            }
+            golden.path_cursor = i;
+            golden.path_deviation = std::max(golden.path_deviation, distance);
+            return;
+        }
+        if ((closest < 0) || (distance < closest)) {
+            closest = distance;
+        }
+    }
+    golden.path_deviation = std::max(golden.path_deviation, closest);
+    _violation();
+}
+
+/*
+ * mp_trajectory_block()   - start recording a block (planner trajectory hook)
+ * mp_trajectory_segment() - record a segment of the current block (planner trajectory hook)
+ *
+ *  Besides the velocity and the jerk along the path, an arc block's centripetal jerk must
+ *  be within what _calculate_arc_vmax() holds it to - this covers the blend arcs as well.
+ */
+
+void mp_trajectory_block(const mpBuf_t *bf)
+{
+    if (golden.mode == GOLDEN_OFF) {
+        return;
+    }
+    goldenBlock_t b;
+    memset(&b, 0, sizeof(b));
+    b.f[GB_LINE] = bf->linenum;
+    b.f[GB_LENGTH] = bf->length;
+    b.f[GB_V_ENTRY] = mr.entry_velocity;
+    b.f[GB_V_CRUISE] = mr.r->cruise_velocity;
+    b.f[GB_V_EXIT] = mr.r->exit_velocity;
+    b.f[GB_HEAD_MS] = mr.r->head_time * 60000;
+    b.f[GB_BODY_MS] = mr.r->body_time * 60000;
+    b.f[GB_TAIL_MS] = mr.r->tail_time * 60000;
+    b.f[GB_JERK] = bf->jerk / JERK_MULTIPLIER;
+    golden.blocks.push_back(b);
+
+    golden.in_block = true;
+    golden.v_limit = bf->cruise_vmax;
+    golden.jerk_limit = bf->jerk * std::max(1.0f, bf->tail.jerk / bf->head.jerk);    // the tail may jerk harder (S-curve)
+    golden.samples = 0;
+    golden.arc_jerk_limit = 0;
+    if (bf->block_type == BLOCK_TYPE_ARC) {
+        golden.arc_jerk_limit = std::min(cm.a[bf->arc->plane_axis_0].jerk_max, cm.a[bf->arc->plane_axis_1].jerk_max) * JERK_MULTIPLIER;
+        golden.arc_planar_share = fabs(bf->arc->angular_travel) * bf->arc->radius / bf->length;
+        golden.arc_radius = bf->arc->radius;
+    }
+}
+
+void mp_trajectory_segment()
+{
+    if ((golden.mode == GOLDEN_OFF) || !golden.in_block) {
+        return;
+    }
+    goldenBlock_t &b = golden.blocks.back();
+    const float v = mr.segment_velocity;
+    const float dt = mr.segment_time;
+
+    b.f[GB_SEGMENTS] += 1;
+    b.f[GB_TIME_MS] += dt * 60000;
+    b.f[GB_V_MAX] = std::max(b.f[GB_V_MAX], (double)v);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        b.f[GB_POSITION + axis] = mr.gm.target[axis];
+    }
+
+    // derivatives are only estimated within a section, where the segment time is constant
+    if (mr.section != golden.section) {
+        golden.section = mr.section;
+        golden.samples = 0;
+    }
+    if (golden.samples > 0) {
+        float a = (v - golden.v_prev) / dt;
+        b.f[GB_A_MAX] = std::max(b.f[GB_A_MAX], (double)fabs(a));
+        if (golden.samples > 1) {
+            float j = (a - golden.a_prev) / dt;
+            b.f[GB_J_MAX] = std::max(b.f[GB_J_MAX], (double)fabs(j) / JERK_MULTIPLIER);
+            if (fabs(j) > golden.jerk_limit * (1 + kJerkTolerance)) {
+                _violation();
+            }
+        }
+        golden.a_prev = a;
+    }
+    if (v > golden.v_limit * (1 + kVelocityTolerance)) {
+        _violation();
+    }
+    if ((golden.arc_jerk_limit > 0) &&
+        (pow(v * golden.arc_planar_share, 3) / square(golden.arc_radius) > golden.arc_jerk_limit * (1 + kJerkTolerance))) {
+        _violation();
+    }
+    _check_path(mr.gm.target);
+    golden.v_prev = v;
+    golden.samples++;
+}
+
+/*
+ * sim_golden_begin() - a benchmark program is starting
+ */
+
+void sim_golden_begin(const char *name)
+{
+    strncpy(golden.name, name, sizeof(golden.name)-1);
+    golden.blocks.clear();
+    golden.path.clear();
+    golden.path_cursor = 0;
+    golden.path_deviation = 0;
+    golden.in_block = false;
+    golden.violations = 0;
+    golden.first_violation_line = 0;
+}
+
+/*
+ * _golden_path() - file for the current program
+ * _total_time()  - total cycle time of a trajectory in ms
+ * _block_differs() - true if two blocks differ by more than kBlockTolerance
+ */
+
+static void _golden_path(char *path, size_t size)
+{
+    snprintf(path, size, "%s/%s.golden", golden.dir, golden.name);
+}
+
+static double _total_time(const std::vector<goldenBlock_t> &blocks)
+{
+    double time = 0;
+    for (const goldenBlock_t &b : blocks) {
+        time += b.f[GB_TIME_MS];
+    }
+    return (time);
+}
+
+static bool _block_differs(const goldenBlock_t &a, const goldenBlock_t &b)
+{
+    for (uint8_t i = 0; i < GB_FIELDS; i++) {
+        double scale = std::max(std::max(fabs(a.f[i]), fabs(b.f[i])), 1.0);
+        if (fabs(a.f[i] - b.f[i]) > kBlockTolerance * scale) {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+static void _print_block(const char *label, const goldenBlock_t &b)
+{
+    fprintf(stderr, "  %-8s", label);
+    for (uint8_t i = 0; i < GB_FIELDS; i++) {
+        fprintf(stderr, " %.6g", b.f[i]);
+    }
+    fprintf(stderr, "\n");
+}
+
+/*
+ * _record() - write the trajectory of the current program
+ * _check()  - compare the trajectory of the current program to its recording
+ */
+
+static bool _record()
+{
+    char path[256];
+    _golden_path(path, sizeof(path));
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return (false);
+    }
+    fprintf(f, "# g2core golden trajectory - %s\n", golden.name);
+    fputs(_block_header, f);
+    for (const goldenBlock_t &b : golden.blocks) {
+        fprintf(f, "B");
+        for (uint8_t i = 0; i < GB_FIELDS; i++) {
+            fprintf(f, " %.9g", b.f[i]);
+        }
+        fprintf(f, "\n");
+    }
+    fprintf(f, "T %u %.9g %u %u\n", (unsigned)golden.blocks.size(), _total_time(golden.blocks),
+            (unsigned)mp_bench.blends, (unsigned)mp_bench.merges);
+    fclose(f);
+
+    fprintf(stderr, "golden %-12s recorded %u blocks, cycle time %.3f ms, %u blends, %u merges, path within %.4f mm, %u limit violations\n",
+            golden.name, (unsigned)golden.blocks.size(), _total_time(golden.blocks), (unsigned)mp_bench.blends,
+            (unsigned)mp_bench.merges, golden.path_deviation, golden.violations);
+    return (golden.violations == 0);
+}
+
+static bool _check()
+{
+    char path[256];
+    _golden_path(path, sizeof(path));
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return (false);
+    }
+    std::vector<goldenBlock_t> recorded;
+    unsigned recorded_blends = 0;
+    unsigned recorded_merges = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == 'T') {
+            unsigned blocks;
+            double time;
+            sscanf(line + 1, "%u %lf %u %u", &blocks, &time, &recorded_blends, &recorded_merges);  // blends and merges are optional
+            continue;
+        }
+        if (line[0] != 'B') {
+            continue;
+        }
+        goldenBlock_t b;
+        char *p = line + 1;
+        for (uint8_t i = 0; i < GB_FIELDS; i++) {
+            b.f[i] = strtod(p, &p);
+        }
+        recorded.push_back(b);
+    }
+    fclose(f);
+
+    uint32_t differ = 0;
+    size_t first = 0;
+    size_t common = std::min(recorded.size(), golden.blocks.size());
+    for (size_t i = 0; i < common; i++) {
+        if (_block_differs(recorded[i], golden.blocks[i])) {
+            if (differ++ == 0) {
+                first = i;
+            }
+        }
+    }
+    double time = _total_time(golden.blocks);
+    double recorded_time = _total_time(recorded);
+    double change = (recorded_time > 0) ? (time - recorded_time) / recorded_time : 0;
+    bool blends_lost = (recorded_blends > 0) && (mp_bench.blends == 0);
+    bool merges_lost = (recorded_merges > 0) && (mp_bench.merges == 0);
+    bool pass = (fabs(change) <= golden.tolerance) && (golden.violations == 0) && !blends_lost && !merges_lost;
+
+    fprintf(stderr, "golden %-12s cycle time %.3f ms (recorded %.3f, %+.4f%%) | %u/%u blocks differ%s | %u blends%s | %u merges%s | path within %.4f mm | %u limit violations | %s\n",
+            golden.name, time, recorded_time, change * 100, differ, (unsigned)golden.blocks.size(),
+            (recorded.size() != golden.blocks.size()) ? " (block count changed)" : "",
+            (unsigned)mp_bench.blends, blends_lost ? " (recorded blends, none now)" : "",
+            (unsigned)mp_bench.merges, merges_lost ? " (recorded merges, none now)" : "",
+            golden.path_deviation, golden.violations, pass ? "PASS" : "FAIL");
+    if (differ > 0) {
+        fprintf(stderr, "  first difference at block %u:\n", (unsigned)first);
+        _print_block("recorded", recorded[first]);
+        _print_block("now", golden.blocks[first]);
+    }
+    if (golden.violations > 0) {
+        fprintf(stderr, "  first limit or path violation at line %u\n", golden.first_violation_line);
+    }
+    return (pass);
+}
+
+/*
+ * sim_golden_end() - the current program has finished; record or check it
+ */
+
+bool sim_golden_end()
+{
+    golden.in_block = false;
+    if (golden.mode == GOLDEN_RECORD) {
+        return (_record());
+    }
+    if (golden.mode == GOLDEN_CHECK) {
+        return (_check());
+    }
+    return (true);
+}
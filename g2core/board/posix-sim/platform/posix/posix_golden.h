@@ -0,0 +1,78 @@
+/*
+ * posix_golden.h - golden trajectory regression checks for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- Golden trajectories ---
+ *
+ *  g2core-sim --bench <names> --golden record <dir>
+ *  g2core-sim --bench <names> --golden check <dir> [--tolerance <percent>]
+ *
+ *  Records the motion the planner and runtime actually produce for each benchmark
+ *  program and compares it against a previous recording. --golden implies --lockstep,
+ *  so the same build always produces the same trajectory.
+ *
+ *  For every aline block <dir>/<program>.golden holds one line with:
+ *    - the block as planned by mp_calculate_ramps() and the exec: line number, length,
+ *      entry/cruise/exit velocity, head/body/tail time, jerk
+ *    - the segments the forward-difference runtime generated for it: count, time,
+ *      peak velocity, acceleration and jerk (estimated from the segment velocities
+ *      within each section) and the end position
+ *  and a final line with the totals: blocks, cycle time, corners blended and lines merged.
+ *
+ *  Units are g2core's: mm, mm/min, mm/min^2, ms for times, and jerk in the same
+ *  units as $xjm (mm/min^3 / 1,000,000).
+ *
+ *  Check fails (exit status 1) if the total cycle time moves by more than the tolerance
+ *  (default 0.01%), if any segment exceeds the block's cruise velocity or jerk, or if
+ *  the program blended corners or merged lines when it was recorded and no longer does.
+ *  Record and check also fail if a segment exceeds an arc block's centripetal jerk limit
+ *  (see _calculate_arc_vmax()), or if a segment ends farther from the programmed path
+ *  than G64 P + Q allow - so the blend arcs and merged lines are held to their tolerance.
+ *  Blocks that differ from the recording are counted and the first one is printed,
+ *  but do not fail the check by themselves - optimizations may legitimately change
+ *  how a program is segmented.
+ *
+ *  Each program starts from the power-up state (see posix_bench.h), so a program can be
+ *  checked on its own against a recording of the whole list.
+ *
+ *  board/posix-sim/golden holds recordings of every program, made with the default build
+ *  flags and SETTINGS_FILE=settings_test.h. Check a change against them with:
+ *
+ *    g2core-sim --bench all --golden check board/posix-sim/golden
+ *
+ *  A change that is meant to alter the motion should re-record them in the same commit.
+ */
+
+#ifndef POSIX_GOLDEN_H_ONCE
+#define POSIX_GOLDEN_H_ONCE
+
+bool sim_golden_select(const char *mode, const char *dir);  // returns false if mode is unknown
+void sim_golden_set_tolerance(double percent);
+bool sim_golden_active(void);
+void sim_golden_begin(const char *name);                    // a benchmark program is starting
+bool sim_golden_end(void);                                  // it finished; returns false if the check failed
+
+#endif // End of include guard: POSIX_GOLDEN_H_ONCE
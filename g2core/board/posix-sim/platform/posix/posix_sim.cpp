@@ -0,0 +1,539 @@
+/*
+ * posix_sim.cpp - host (POSIX) interrupt and time simulation for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* See posix_sim.h for an overview of how the simulation works */
+
+#include "posix_sim.h"
+#include "posix_bench.h"
+#include "posix_golden.h"
+#include "MotateTimers.h"
+#include "MotateUART.h"
+#include "MotateUniqueID.h"
+#include "MotatePower.h"
+#include "MotateDebug.h"
+
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+/**** Simulation state ****/
+
+namespace Motate {
+
+    static SimInterrupt *_irq_list = nullptr;               // all registered interrupt sources
+    static volatile uint8_t _current_priority = kSimPriorityNone;
+    static volatile bool _irq_disabled = false;             // __disable_irq() is in effect
+
+    static SimInterrupt *_periodic_irq = nullptr;           // the dda_timer
+    static uint32_t _periodic_frequency = 0;
+    static volatile bool _periodic_running = false;
+    static uint64_t _periodic_ticks_done = 0;               // DDA ticks run since the timer was started
+    static uint64_t _periodic_start_ns = 0;
+
+    static uint64_t _start_ns = 0;                          // time the simulation started
+    static volatile uint32_t _systick = 0;                  // SysTick events run so far
+    static uint32_t _rate = 1;                              // simulated time runs this many times faster than the host
+    static bool _lockstep = false;                          // simulated time is advanced by the main loop
+    static uint64_t _lockstep_ns = 0;                       // simulated time in lockstep mode
+
+    static const uint32_t kMaxCatchupMs = 10;               // limit work done in one SIGALRM
+    static const uint8_t kLockstepPassesPerMs = 4;          // roughly what an ARM board manages while running Gcode
+
+    static uint64_t _now_ns()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+    }
+
+    uint64_t sim_host_ns()
+    {
+        return (_now_ns());
+    }
+
+    // simulated time since the start of the simulation
+    static uint64_t _sim_ns()
+    {
+        if (_lockstep) {
+            return (_lockstep_ns);
+        }
+        return ((_now_ns() - _start_ns) * _rate);
+    }
+
+    void sim_set_rate(uint32_t rate)
+    {
+        _rate = (rate < 1) ? 1 : rate;
+    }
+
+    static void _block_alarm(sigset_t *old)
+    {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGALRM);
+        sigprocmask(SIG_BLOCK, &set, old);
+    }
+
+    static void _restore_alarm(sigset_t *old)
+    {
+        sigprocmask(SIG_SETMASK, old, nullptr);
+    }
+
+    /*
+     * _run_irq() - run one interrupt handler at its own priority
+     */
+
+    static void _run_irq(SimInterrupt *irq)
+    {
+        uint8_t saved_priority = _current_priority;
+        _current_priority = irq->priority;
+        irq->pending = false;
+        irq->handler();
+        _current_priority = saved_priority;
+    }
+
+    /*
+     * sim_register_interrupt() - add an interrupt source to the (simulated) NVIC
+     */
+
+    void sim_register_interrupt(SimInterrupt *irq)
+    {
+        for (SimInterrupt *i = _irq_list; i != nullptr; i = i->next) {
+            if (i == irq) {
+                return;                                     // already registered
+            }
+        }
+        irq->next = _irq_list;
+        _irq_list = irq;
+    }
+
+    /*
+     * sim_dispatch_pending() - run all pending interrupts that would preempt the current level
+     *
+     *  Must be called with SIGALRM blocked or from inside the SIGALRM handler.
+     */
+
+    void sim_dispatch_pending()
+    {
+        if (_irq_disabled) {
+            return;
+        }
+        while (true) {
+            SimInterrupt *next = nullptr;
+            for (SimInterrupt *i = _irq_list; i != nullptr; i = i->next) {
+                if (i->pending && i->enabled && (i->priority < _current_priority)) {
+                    if ((next == nullptr) || (i->priority < next->priority)) {
+                        next = i;
+                    }
+                }
+            }
+            if (next == nullptr) {
+                return;
+            }
+            _run_irq(next);
+        }
+    }
+
+    /*
+     * sim_set_pending() - request an interrupt; preempt the caller if it has higher priority
+     */
+
+    void sim_set_pending(SimInterrupt *irq)
+    {
+        irq->pending = true;
+        if ((irq->priority >= _current_priority) || _irq_disabled) {
+            return;                                         // will run when the caller is done
+        }
+        if (_current_priority == kSimPriorityNone) {        // main loop: emulate preemption
+            sigset_t old;
+            _block_alarm(&old);
+            sim_dispatch_pending();
+            _restore_alarm(&old);
+        } else {                                            // nested interrupt
+            sim_dispatch_pending();
+        }
+    }
+
+    uint8_t sim_current_priority() { return (_current_priority); }
+
+    /*
+     * sim_set_periodic_timer() - bind the DDA-rate timer
+     * sim_start_periodic_timer()
+     * sim_stop_periodic_timer()
+     */
+
+    void sim_set_periodic_timer(SimInterrupt *irq, uint32_t frequency)
+    {
+        _periodic_irq = irq;
+        _periodic_frequency = frequency;
+    }
+
+    void sim_start_periodic_timer()
+    {
+        if (_periodic_running) {
+            return;
+        }
+        _periodic_ticks_done = 0;
+        _periodic_start_ns = _sim_ns();
+        _periodic_running = true;
+    }
+
+    void sim_stop_periodic_timer()
+    {
+        _periodic_running = false;
+    }
+
+    uint32_t sim_systick_value()
+    {
+        return ((uint32_t)(_sim_ns() / 1000000ULL));
+    }
+
+    /*
+     * _run_tick() - the simulated interrupt hardware. Runs everything that is due.
+     * _sim_tick() - SIGALRM handler
+     */
+
+    static void _run_tick()
+    {
+        uint8_t saved_priority = _current_priority;
+        _current_priority = kSimPriorityHigh;               // SysTick
+
+        // run SysTick events for every millisecond that has elapsed
+        uint32_t now_ms = sim_systick_value();
+        if ((now_ms - _systick) > kMaxCatchupMs * _rate) {
+            _systick = now_ms - kMaxCatchupMs * _rate;
+        }
+        while (_systick < now_ms) {
+            _systick++;
+            SysTickTimer._handleEvents();
+        }
+        _current_priority = saved_priority;
+
+        // run the DDA ticks that are due, letting lower priority interrupts run in between
+        if (_periodic_running && (_periodic_irq != nullptr) && _periodic_irq->enabled) {
+            uint64_t due = ((_sim_ns() - _periodic_start_ns) * _periodic_frequency) / 1000000000ULL;
+            uint64_t max_catchup = (uint64_t)_periodic_frequency * kMaxCatchupMs * _rate / 1000;
+            if ((due - _periodic_ticks_done) > max_catchup) {
+                _periodic_ticks_done = due - max_catchup;
+            }
+            while (_periodic_running && (_periodic_ticks_done < due)) {
+                _periodic_ticks_done++;
+                _run_irq(_periodic_irq);
+                sim_dispatch_pending();
+            }
+        }
+        sim_dispatch_pending();
+    }
+
+    static void _sim_tick(int)
+    {
+        if (_irq_disabled || _lockstep) {
+            return;                                         // we'll catch up on the next tick
+        }
+        _run_tick();
+    }
+
+    /*
+     * sim_set_lockstep()  - advance simulated time from the main loop instead of the host clock
+     * sim_lockstep_pass() - called once per controller pass (from hardware_periodic())
+     *
+     *  Lockstep starts after setup() (which waits on SysTick) has run in real time.
+     *  In lockstep mode every kLockstepPassesPerMs controller passes advance simulated
+     *  time by one millisecond and run its interrupts, so interrupts only run between
+     *  passes. The result depends only on the input, so
+     *  two runs of the same build produce the same motion - and it runs as fast as the
+     *  host allows.
+     */
+
+    void sim_set_lockstep(bool lockstep)
+    {
+        if (lockstep && !_lockstep) {
+            _lockstep_ns = (_sim_ns() / 1000000ULL) * 1000000ULL;   // continue from the current time
+        }
+        _lockstep = lockstep;
+    }
+
+    void sim_lockstep_pass()
+    {
+        static uint8_t passes = 0;
+        if (!_lockstep || (++passes < kLockstepPassesPerMs)) {
+            return;
+        }
+        passes = 0;
+        _lockstep_ns += 1000000ULL;
+        if (!_irq_disabled) {
+            _run_tick();
+        }
+    }
+
+    /*
+     * sim_systick_init() - start the interrupt engine (a 1 ms POSIX interval timer)
+     */
+
+    void sim_systick_init()
+    {
+        _start_ns = _now_ns();
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = _sim_tick;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGALRM, &sa, nullptr);
+
+        struct itimerval tv;
+        tv.it_interval.tv_sec = 0;
+        tv.it_interval.tv_usec = 1000;
+        tv.it_value = tv.it_interval;
+        setitimer(ITIMER_REAL, &tv, nullptr);
+    }
+
+} // namespace Motate
+
+/**** Motate globals ****/
+
+namespace Motate {
+
+    SysTickTimer_t SysTickTimer;
+    _SimDebug debug;
+    const char *UUID = "posix-sim-0000";
+
+    void delay(uint32_t microseconds)
+    {
+        uint64_t until = _now_ns() + (uint64_t)microseconds * 1000ULL;
+        while (_now_ns() < until);
+    }
+
+    void _SimDebug::write(const char *str)
+    {
+        fputs(str, stderr);
+    }
+
+    namespace System {
+        void reset(bool bootloader)
+        {
+            fprintf(stderr, "posix-sim: %s requested, exiting\n", bootloader ? "flash loader" : "reset");
+            exit(0);
+        }
+    } // namespace System
+
+} // namespace Motate
+
+/**** CMSIS-style global interrupt control ****/
+
+void __disable_irq()
+{
+    if (Motate::_current_priority == Motate::kSimPriorityNone) {
+        sigset_t old;
+        Motate::_block_alarm(&old);                         // leaves SIGALRM blocked
+    }
+    Motate::_irq_disabled = true;
+}
+
+void __enable_irq()
+{
+    Motate::_irq_disabled = false;
+    if (Motate::_current_priority == Motate::kSimPriorityNone) {
+        Motate::sim_dispatch_pending();                     // run anything requested while disabled
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGALRM);
+        sigprocmask(SIG_UNBLOCK, &set, nullptr);
+    }
+}
+
+/**** Console (stdin/stdout or pty) ****/
+
+namespace Motate {
+
+    static int _console_fd_in = STDIN_FILENO;
+    static int _console_fd_out = STDOUT_FILENO;
+
+    void sim_console_set_fds(int fd_in, int fd_out)
+    {
+        _console_fd_in = fd_in;
+        _console_fd_out = fd_out;
+    }
+
+    int sim_console_read(char *buffer, uint16_t length)
+    {
+        if (sim_bench_active()) {
+            return (sim_bench_read(buffer, length));
+        }
+        ssize_t count = read(_console_fd_in, buffer, length);
+        return ((count > 0) ? (int)count : 0);
+    }
+
+    void sim_console_write(const char *buffer, uint16_t length)
+    {
+        if (sim_bench_active()) {
+            return;                                         // the benchmark reports on stderr
+        }
+        while (length > 0) {
+            ssize_t count = write(_console_fd_out, buffer, length);
+            if (count <= 0) {
+                return;                                     // console went away; drop the output
+            }
+            buffer += count;
+            length -= count;
+        }
+    }
+
+} // namespace Motate
+
+static struct termios _saved_termios;
+static bool _termios_saved = false;
+
+static void _restore_console()
+{
+    if (_termios_saved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &_saved_termios);
+    }
+}
+
+/*
+ * _open_console() - set up the file descriptors the simulated UART talks to
+ *
+ *  Default is stdin/stdout. With --pty a pseudo-terminal is created and its
+ *  slave device name is printed on stderr, so a host program (a sender, a UI)
+ *  can connect to it like a real serial port.
+ */
+
+static void _open_console(bool use_pty)
+{
+    int fd_in = STDIN_FILENO;
+    int fd_out = STDOUT_FILENO;
+
+    if (use_pty) {
+        int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if ((master < 0) || (grantpt(master) < 0) || (unlockpt(master) < 0)) {
+            perror("posix-sim: unable to open pty");
+            exit(1);
+        }
+        struct termios t;
+        tcgetattr(master, &t);
+        cfmakeraw(&t);
+        tcsetattr(master, TCSANOW, &t);
+        fprintf(stderr, "posix-sim: serial port is %s\n", ptsname(master));
+        fd_in = master;
+        fd_out = master;
+
+    } else if (isatty(STDIN_FILENO)) {
+        struct termios t;
+        tcgetattr(STDIN_FILENO, &_saved_termios);
+        _termios_saved = true;
+        atexit(_restore_console);
+        t = _saved_termios;
+        t.c_lflag &= ~(ICANON);                             // deliver !, ~, ^x without waiting for a newline
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &t);
+    }
+    fcntl(fd_in, F_SETFL, fcntl(fd_in, F_GETFL) | O_NONBLOCK);
+    Motate::sim_console_set_fds(fd_in, fd_out);
+}
+
+/*
+ * _exit_on_signal() - SIGINT / SIGTERM exit through exit() so the atexit() handlers
+ *                     (console restore, step trace file) run on the way out.
+ *                     SIGALRM is masked while the handler runs so no ISR interleaves.
+ */
+
+static void _exit_on_signal(int signum)
+{
+    exit(0);
+}
+
+/**** main() ****/
+
+extern void setup(void);
+extern void loop(void);
+
+int main(int argc, char *argv[])
+{
+    bool use_pty = false;
+    bool lockstep = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pty") == 0) {
+            use_pty = true;
+        } else if (strcmp(argv[i], "--lockstep") == 0) {
+            lockstep = true;
+        } else if ((strcmp(argv[i], "--rate") == 0) && (i+1 < argc)) {
+            Motate::sim_set_rate(atoi(argv[++i]));
+        } else if ((strcmp(argv[i], "--bench") == 0) && (i+1 < argc)) {
+            if (!sim_bench_select(argv[++i])) {
+                return (1);
+            }
+        } else if ((strcmp(argv[i], "--golden") == 0) && (i+2 < argc)) {
+            if (!sim_golden_select(argv[i+1], argv[i+2])) {
+                fprintf(stderr, "posix-sim: --golden takes record or check\n");
+                return (1);
+            }
+            lockstep = true;
+            i += 2;
+        } else if ((strcmp(argv[i], "--tolerance") == 0) && (i+1 < argc)) {
+            sim_golden_set_tolerance(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--arcgen") == 0) {
+            sim_bench_arcgen(((i+1 < argc) && (argv[i+1][0] != '-')) ? atoi(argv[i+1]) : 10000000);
+        } else if (strcmp(argv[i], "--zoid") == 0) {
+            sim_bench_zoid(((i+1 < argc) && (argv[i+1][0] != '-')) ? atoi(argv[i+1]) : 100000);
+        } else if (strcmp(argv[i], "--kin") == 0) {
+            sim_bench_kin(((i+1 < argc) && (argv[i+1][0] != '-')) ? atoi(argv[i+1]) : 1000000);
+        } else {
+            fprintf(stderr, "usage: %s [--pty] [--rate N | --lockstep] [--bench <name>[,<name>...] | all | list]\n"
+                            "       [--golden record|check <dir> [--tolerance <percent>]] [--arcgen [segments]]\n"
+                            "       [--zoid [cases]] [--kin [points]]\n", argv[0]);
+            return (1);
+        }
+    }
+    if (sim_golden_active() && !sim_bench_active()) {
+        fprintf(stderr, "posix-sim: --golden needs --bench\n");
+        return (1);
+    }
+    _open_console(use_pty);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _exit_on_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaddset(&sa.sa_mask, SIGALRM);
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    Motate::sim_systick_init();
+    setup();
+    Motate::sim_set_lockstep(lockstep);
+    for (;;) {
+        loop();
+    }
+    return (0);
+}
@@ -0,0 +1,109 @@
+/*
+ * posix_sim.h - host (POSIX) interrupt and time simulation for the posix-sim board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* --- How the simulation works ---
+ *
+ *  The posix-sim board runs the unmodified g2core application on a Linux host.
+ *  The Motate headers in this directory stand in for the ARM platform and provide
+ *  just enough of the Motate API for the g2core sources to compile and run.
+ *
+ *  Interrupts are emulated with a single POSIX interval timer delivering SIGALRM
+ *  to the main thread. The signal handler plays the part of the NVIC: it preempts
+ *  the main loop (controller_run()) exactly the way a hardware interrupt would,
+ *  so code that relies on ISR atomicity sees the same behavior it sees on the board.
+ *
+ *  Each SIGALRM represents one SysTick (MILLISECONDS_PER_TICK). On every tick the
+ *  handler:
+ *    - advances the SysTick counter and runs registered SysTickEvents
+ *    - runs FREQUENCY_DDA/1000 dda_timer interrupts if the DDA timer is started
+ *    - after every DDA interrupt, runs any pending lower-priority interrupts
+ *      (exec_timer, fwd_plan_timer) in priority order
+ *
+ *  Software-triggered interrupts (setInterruptPending()) requested from the main
+ *  loop run immediately with SIGALRM blocked, emulating preemption of the main loop.
+ *  When requested from inside an interrupt they are left pending and run once all
+ *  higher-priority work is done, emulating tail-chaining.
+ *
+ *  __disable_irq() and __enable_irq() block and unblock SIGALRM.
+ *
+ *  With --rate N simulated time (SysTick and the DDA) runs N times faster than the
+ *  host clock. The host must be able to keep up; if it can't, time is dropped.
+ *  With --lockstep simulated time is advanced by the controller loop (a fixed number
+ *  of passes per millisecond) instead of the host clock, so runs are repeatable.
+ */
+
+#ifndef POSIX_SIM_H_ONCE
+#define POSIX_SIM_H_ONCE
+
+#include <stdint.h>
+
+namespace Motate {
+
+    // Interrupt priorities - lower number is higher priority (same as the NVIC)
+    enum SimInterruptPriority : uint8_t {
+        kSimPriorityHighest = 0,
+        kSimPriorityHigh    = 1,
+        kSimPriorityMedium  = 2,
+        kSimPriorityLow     = 3,
+        kSimPriorityLowest  = 4,
+        kSimPriorityNone    = 0xFF      // the main loop - not in an interrupt
+    };
+
+    // An interrupt source. Timers and service calls own one of these.
+    struct SimInterrupt {
+        void (*handler)(void);          // the ISR to call
+        uint8_t priority;               // SimInterruptPriority
+        volatile bool pending;          // set by setInterruptPending(), cleared on entry
+        volatile bool enabled;          // set by setInterrupts()
+        SimInterrupt *next;             // linked list of registered interrupt sources
+    };
+
+    void sim_register_interrupt(SimInterrupt *irq);
+    void sim_set_pending(SimInterrupt *irq);         // request an interrupt (dispatches if appropriate)
+    void sim_dispatch_pending(void);                 // run pending interrupts above the current priority
+    uint8_t sim_current_priority(void);              // kSimPriorityNone if in the main loop
+
+    // The one periodic timer that drives DDA-rate interrupts
+    void sim_set_periodic_timer(SimInterrupt *irq, uint32_t frequency);
+    void sim_start_periodic_timer(void);
+    void sim_stop_periodic_timer(void);
+
+    uint32_t sim_systick_value(void);                // milliseconds since start (simulated time)
+    void sim_set_rate(uint32_t rate);                // run simulated time this many times faster than the host
+    uint64_t sim_host_ns(void);                      // host monotonic clock in nanoseconds
+    void sim_set_lockstep(bool lockstep);            // advance simulated time from the main loop
+    void sim_lockstep_pass(void);                    // call once per controller pass
+    void sim_systick_init(void);                     // start SysTick and the interrupt engine
+
+} // namespace Motate
+
+// CMSIS-style global interrupt control (used by planner.cpp)
+void __disable_irq(void);
+void __enable_irq(void);
+inline void __NOP(void) {}
+
+#endif // End of include guard: POSIX_SIM_H_ONCE
@@ -0,0 +1,83 @@
+/*
+ * posix-sim-pinout.h - board pinout specification for the posix-sim host board
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Robert Giseburt
+ * Copyright (c) 2016 Alden S. Hart Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef posix_sim_pinout_h
+#define posix_sim_pinout_h
+
+/*
+ *  The host has no pin multiplexing, so unlike the ARM pinout files there are no
+ *  _MAKE_MOTATE_PIN() linkages here - only the capability flags the rest of g2core
+ *  tests with #if. The pin names themselves are in motate_pin_assignments.h.
+ *
+ *  All I/O goes through the UART stand-in (stdin/stdout or a pty, see posix_sim.cpp).
+ */
+
+#include <MotatePins.h>
+
+#define INPUT1_AVAILABLE 1
+#define INPUT2_AVAILABLE 1
+#define INPUT3_AVAILABLE 1
+#define INPUT4_AVAILABLE 1
+#define INPUT5_AVAILABLE 1
+#define INPUT6_AVAILABLE 1
+#define INPUT7_AVAILABLE 1
+#define INPUT8_AVAILABLE 1
+#define INPUT9_AVAILABLE 0
+#define INPUT10_AVAILABLE 0
+#define INPUT11_AVAILABLE 0
+#define INPUT12_AVAILABLE 0
+#define INPUT13_AVAILABLE 0
+
+#define ADC0_AVAILABLE 0
+#define ADC1_AVAILABLE 0
+#define ADC2_AVAILABLE 0
+#define ADC3_AVAILABLE 0
+
+#define XIO_HAS_USB 0
+#define XIO_HAS_UART 1
+#define XIO_HAS_SPI 0
+#define XIO_HAS_I2C 0
+
+#define TEMPERATURE_OUTPUT_ON 0
+
+#define OUTPUT1_PWM 0
+#define OUTPUT2_PWM 0
+#define OUTPUT3_PWM 0
+#define OUTPUT4_PWM 0
+#define OUTPUT5_PWM 0
+#define OUTPUT6_PWM 0
+#define OUTPUT7_PWM 0
+#define OUTPUT8_PWM 0
+#define OUTPUT9_PWM 0
+#define OUTPUT10_PWM 0
+#define OUTPUT11_PWM 0
+#define OUTPUT12_PWM 0
+#define OUTPUT13_PWM 0
+
+#endif
@@ -122,6 +122,10 @@ using Motate::OutputPin;
 #define FREQUENCY_DWELL		1000UL
 #define FREQUENCY_SGI		200000UL		// 200,000 Hz means software interrupts will fire 5 uSec after being called
 
+/**** Profiler ****/
+
+#define PROFILER_ENABLED true        // {prof:n} hot path timing from the DWT cycle counter - see profiler.h
+
 /**** Motate Definitions ****/
 
 // Timer definitions. See stepper.h and other headers for setup
@@ -39,14 +39,14 @@
  *
  *  There are 3 temporal contexts for system state:
  *      - The gcode model in the canonical machine (the MODEL context, held in gm)
- *      - The gcode model used by the planner (PLANNER context, held in bf's and mm)
+ *      - The gcode model used by the planner (held in bf's and mp)
  *      - The gcode model used during motion for reporting (RUNTIME context, held in mr)
  *
  *  It's a bit more complicated than this. The 'gm' struct contains the core Gcode model
- *  context. This originates in the canonical machine and is copied to each planner buffer
- *  (bf buffer) during motion planning. Finally, the gm context is passed to the runtime
- *  (mr) for the RUNTIME context. So at last count the Gcode model exists in as many as
- *  30 copies in the system. (1+28+1)
+ *  context. This originates in the canonical machine. Each planner buffer (bf buffer) gets
+ *  the part of it needed to plan and run the block, and a sequence number for the rest, which
+ *  is kept once per change in the planner's Gcode state table (see planner.h). Finally, the
+ *  two are joined in the runtime (mr) for the RUNTIME context.
  *
  *  Depending on the need, any one of these contexts may be called for reporting or by
  *  a function. Most typically, all new commends from the gcode parser work form the MODEL
@@ -97,6 +97,7 @@
 
 #include "plan_arc.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "stepper.h"
 #include "encoder.h"
 #include "spindle.h"
@@ -220,7 +221,6 @@ cmCombinedState cm_get_combined_state()
 
 /*  These getters and setters will work on any gm model with inputs:
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -320,7 +320,6 @@ float cm_get_active_coord_offset(const uint8_t axis)
  * cm_get_work_offset() - return a coord offset from the gcode_state
  *
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -334,7 +333,6 @@ float cm_get_work_offset(const GCodeState_t *gcode_state, const uint8_t axis)
  * cm_set_work_offsets() - capture coord offsets from the model into absolute values in the gcode_state
  *
  *    MODEL         (GCodeState_t *)&cm.gm          // absolute pointer from canonical machine gm model
- *    PLANNER       (GCodeState_t *)&bf->gm         // relative to buffer *bf is currently pointing to
  *    RUNTIME       (GCodeState_t *)&mr.gm          // absolute pointer from runtime mm struct
  *    ACTIVE_MODEL   cm.am                          // active model pointer is maintained by state management
  */
@@ -451,6 +449,7 @@ stat_t cm_deferred_write_callback()
 /*
  * cm_set_tram() - JSON command to trigger computing the rotation matrix
  * cm_get_tram() - JSON query to determine if the rotation matrix is set (non-identity)
+ * cm_rotation_is_identity() - return false if the rotation matrix or z offset is set
  *
  * There MUST be three valid probes stored.
  */
@@ -555,8 +554,13 @@ stat_t cm_set_tram(nvObj_t *nv)
 
 stat_t cm_get_tram(nvObj_t *nv)
 {
-    nv->value = true;
+    nv->value = cm_rotation_is_identity();
+    nv->valuetype = TYPE_BOOL;
+    return (STAT_OK);
+}
 
+bool cm_rotation_is_identity()
+{
     if (fp_NOT_ZERO(cm.rotation_z_offset) ||
         fp_NOT_ZERO(cm.rotation_matrix[0][1]) ||
         fp_NOT_ZERO(cm.rotation_matrix[0][2]) ||
@@ -568,10 +572,9 @@ stat_t cm_get_tram(nvObj_t *nv)
         fp_NE(1.0,  cm.rotation_matrix[1][1]) ||
         fp_NE(1.0,  cm.rotation_matrix[2][2]))
     {
-        nv->value = false;
+        return (false);
     }
-    nv->valuetype = TYPE_BOOL;
-    return (STAT_OK);
+    return (true);
 }
 
 
@@ -691,10 +694,17 @@ void cm_set_model_target(const float target[], const bool flags[])
 /*
  * cm_get_soft_limits()
  * cm_set_soft_limits()
+ * cm_reach_is_tested()  - true if moves are tested against the kinematics reach
  * cm_test_soft_limits() - return error code if soft limit is exceeded
  *
  *  The target[] arg must be in absolute machine coordinates. Best done after cm_set_model_target().
  *
+ *  A line from the model position to the target that the kinematics can't make (see
+ *  kinematics.h) is refused with STAT_KINEMATICS_MOVE_UNREACHABLE, whether or not soft
+ *  limits are enabled. It is an error, not an alarm - nothing has moved. The reach is
+ *  only known once X and Y are homed (or set with G28.3), and homing moves aren't tested:
+ *  until then the model position is just where the machine powered up.
+ *
  *  Tests for soft limit for any homed axis if min and max are different values. You can set min
  *  and max to the same value (e.g. 0,0) to disable soft limits for an axis. Also will not test
  *  a min or a max if the value is more than +/- 1000000 (plus or minus 1 million ).
@@ -704,6 +714,11 @@ void cm_set_model_target(const float target[], const bool flags[])
 bool cm_get_soft_limits() { return (cm.soft_limit_enable); }
 void cm_set_soft_limits(bool enable) { cm.soft_limit_enable = enable; }
 
+bool cm_reach_is_tested()
+{
+    return (kn_reach_is_limited() && (cm.cycle_state != CYCLE_HOMING) && cm.homed[AXIS_X] && cm.homed[AXIS_Y]);
+}
+
 static stat_t _finalize_soft_limits(const stat_t status)
 {
     cm.gm.motion_mode = MOTION_MODE_CANCEL_MOTION_MODE;     // cancel motion
@@ -728,6 +743,10 @@ stat_t cm_test_soft_limits(const float target[])
             }
         }
     }
+    if (cm_reach_is_tested() && !kn_move_is_reachable(cm.gmx.position, target)) {
+        copy_vector(cm.gm.target, cm.gmx.position);         // reset model target
+        return (STAT_KINEMATICS_MOVE_UNREACHABLE);
+    }
     return (STAT_OK);
 }
 
@@ -776,7 +795,7 @@ void canonical_machine_reset()
     cm_set_units_mode(cm.default_units_mode);
     cm_set_coord_system(cm.default_coord_system);   // NB: queues a block to the planner with the coordinates
     cm_select_plane(cm.default_select_plane);
-    cm_set_path_control(MODEL, cm.default_path_control);
+    cm_set_path_control(MODEL, cm.default_path_control, 0, false, 0, false);
     cm_set_distance_mode(cm.default_distance_mode);
     cm_set_arc_distance_mode(INCREMENTAL_DISTANCE_MODE);// always the default
     cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);       // always the default
@@ -1490,11 +1509,36 @@ stat_t cm_set_feed_rate_mode(const uint8_t mode)
 
 /*
  * cm_set_path_control() - G61, G61.1, G64
+ *
+ *  G64 P sets the tolerance corners between lines may be blended within, and G64 Q the
+ *  tolerance runs of nearly collinear lines may be merged within (see mp_aline()). As in
+ *  LinuxCNC Q defaults to P if only P is given. G64 without P or Q, G61 and G61.1 turn
+ *  both off.
  */
 
-stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode)
+stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode,
+                           const float P_word, const bool P_word_f,
+                           const float Q_word, const bool Q_word_f)
 {
+    float tolerance = 0;
+    float merge_tolerance = 0;
+    if (mode == PATH_CONTINUOUS) {
+        if (P_word_f) {
+            if (P_word < 0) {
+                return (STAT_P_WORD_IS_NEGATIVE);
+            }
+            tolerance = merge_tolerance = _to_millimeters(P_word);
+        }
+        if (Q_word_f) {
+            if (Q_word < 0) {
+                return (STAT_Q_WORD_IS_INVALID);
+            }
+            merge_tolerance = _to_millimeters(Q_word);
+        }
+    }
     gcode_state->path_control = (cmPathControl)mode;
+    gcode_state->path_tolerance = tolerance;
+    gcode_state->merge_tolerance = merge_tolerance;
     return (STAT_OK);
 }
 
@@ -2497,6 +2541,7 @@ stat_t cm_set_am(nvObj_t *nv)        // axis mode
         }
     }
     set_ui8(nv);
+    kn_map_motors();                    // inhibited axes drop out of the motor mapping
     return(STAT_OK);
 }
 
@@ -2522,6 +2567,9 @@ stat_t cm_set_hi(nvObj_t *nv)
  * cm_set_fr() - set feedrate max value - called from dispatch table
  * cm_set_jm() - set jerk max value - called from dispatch table
  * cm_set_jh() - set jerk homing value - called from dispatch table
+ * cm_set_ac() - set acceleration max value - called from dispatch table
+ * cm_set_rp() - set ramp profile - called from dispatch table
+ * cm_set_jr() - set deceleration jerk ratio - called from dispatch table
  *
  *  Jerk values can be rather large, often in the billions. This makes for some pretty big
  *  numbers for people to deal with. Jerk values are stored in the system in truncated format;
@@ -2611,6 +2659,50 @@ stat_t cm_set_jh(nvObj_t *nv)
     return(STAT_OK);
 }
 
+/*
+ *  Acceleration limits and the deceleration jerk ratio only apply to S-curve ramps (see
+ *  Ramp profiles in planner.h). An acceleration of 0 is no limit. All three feed the
+ *  planner's cached jerk terms, so setting them empties the cache.
+ */
+
+stat_t cm_set_ac(nvObj_t *nv)
+{
+    if (nv->value < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    uint8_t axis = _get_axis(nv->index);
+    if ((axis == AXIS_A) || (axis == AXIS_B) || (axis == AXIS_C)) {
+        set_flt(nv);
+    } else {
+        set_flu(nv);
+    }
+    mp_reset_jerk_cache();
+    return(STAT_OK);
+}
+
+stat_t cm_set_rp(nvObj_t *nv)
+{
+    ritorno(set_01(nv));
+    mp_reset_jerk_cache();
+    return(STAT_OK);
+}
+
+stat_t cm_set_jr(nvObj_t *nv)
+{
+    if (nv->value < DECEL_JERK_RATIO_MIN) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > DECEL_JERK_RATIO_MAX) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    set_flt(nv);
+    mp_reset_jerk_cache();
+    return(STAT_OK);
+}
+
 stat_t cm_set_jt(nvObj_t *nv)
 {
     stat_t status = STAT_OK;
@@ -2820,12 +2912,16 @@ void cm_print_gdi(nvObj_t *nv) { text_print(nv, fmt_gdi);}  // TYPE_INT
 
 static const char fmt_jt[] = "[jt]  junction integrgation time%6.2f\n";
 static const char fmt_ct[] = "[ct]  chordal tolerance%17.4f%s\n";
+static const char fmt_rp[] = "[rp]  ramp profile%17d [0=quintic,1=s-curve]\n";
+static const char fmt_jr[] = "[jr]  deceleration jerk ratio%10.2f\n";
 static const char fmt_sl[] = "[sl]  soft limit enable%12d [0=disable,1=enable]\n";
 static const char fmt_lim[] ="[lim] limit switch enable%10d [0=disable,1=enable]\n";
 static const char fmt_saf[] ="[saf] safety interlock enable%6d [0=disable,1=enable]\n";
 
 void cm_print_jt(nvObj_t *nv) { text_print(nv, fmt_jt);}        // TYPE FLOAT
 void cm_print_ct(nvObj_t *nv) { text_print_flt_units(nv, fmt_ct, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_rp(nvObj_t *nv) { text_print(nv, fmt_rp);}        // TYPE_INT
+void cm_print_jr(nvObj_t *nv) { text_print(nv, fmt_jr);}        // TYPE FLOAT
 void cm_print_sl(nvObj_t *nv) { text_print(nv, fmt_sl);}        // TYPE_INT
 void cm_print_lim(nvObj_t *nv){ text_print(nv, fmt_lim);}       // TYPE_INT
 void cm_print_saf(nvObj_t *nv){ text_print(nv, fmt_saf);}       // TYPE_INT
@@ -2860,6 +2956,7 @@ void cm_print_nxln(nvObj_t *nv) { text_print(nv, fmt_nxln);};   // TYPE INT
  *    cm_print_tn()
  *    cm_print_jm()
  *    cm_print_jh()
+ *    cm_print_ac()
  *    cm_print_ra()
  *    cm_print_hi()
  *    cm_print_hd()
@@ -2879,6 +2976,7 @@ static const char fmt_Xtm[] = "[%s%s] %s travel maximum%17.3f%s\n";
 static const char fmt_Xtn[] = "[%s%s] %s travel minimum%17.3f%s\n";
 static const char fmt_Xjm[] = "[%s%s] %s jerk maximum%15.0f%s/min^3 * 1 million\n";
 static const char fmt_Xjh[] = "[%s%s] %s jerk homing%16.0f%s/min^3 * 1 million\n";
+static const char fmt_Xac[] = "[%s%s] %s acceleration maximum%7.0f%s/min^2 * 1000 [0=no limit]\n";
 static const char fmt_Xra[] = "[%s%s] %s radius value%20.4f%s\n";
 static const char fmt_Xhi[] = "[%s%s] %s homing input%15d [input 1-N or 0 to disable homing this axis]\n";
 static const char fmt_Xhd[] = "[%s%s] %s homing direction%11d [0=search-to-negative, 1=search-to-positive]\n";
@@ -2955,6 +3053,7 @@ void cm_print_tm(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xtm);}
 void cm_print_tn(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xtn);}
 void cm_print_jm(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xjm);}
 void cm_print_jh(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xjh);}
+void cm_print_ac(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xac);}
 void cm_print_ra(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xra);}
 
 void cm_print_hi(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xhi);}
@@ -43,7 +43,6 @@
 /* Defines, Macros, and Assorted Parameters */
 
 #define MODEL   (GCodeState_t *)&cm.gm      // absolute pointer from canonical machine gm model
-#define PLANNER (GCodeState_t *)&bf->gm     // relative to buffer *bf is currently pointing to
 #define RUNTIME (GCodeState_t *)&mr.gm      // absolute pointer from runtime mm struct
 #define ACTIVE_MODEL cm.am                  // active model pointer is maintained by state management
 
@@ -293,6 +292,8 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
 
     float feed_rate;                    // F - normalized to millimeters/minute or in inverse time mode
     float parameter;                    // P - parameter used for dwell time in seconds, G10 coord select...
+    float path_tolerance;               // G64 P - corner blending tolerance in mm (0 = don't blend)
+    float merge_tolerance;              // G64 Q - collinear line merging tolerance in mm (0 = don't merge)
 
     cmFeedRateMode feed_rate_mode;      // See cmFeedRateMode for settings
     cmCanonicalPlane select_plane;      // G17,G18,G19 - values to set plane to
@@ -316,6 +317,8 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
 
         feed_rate = 0.0;
         parameter = 0.0;
+        path_tolerance = 0.0;
+        merge_tolerance = 0.0;
 
         feed_rate_mode = INVERSE_TIME_MODE;
         select_plane = CANON_PLANE_XY;
@@ -373,6 +376,7 @@ typedef struct cmAxis {
     float travel_min;                       // min work envelope for soft limits
     float jerk_max;                         // max jerk (Jm) in mm/min^3 divided by 1 million
     float jerk_high;                        // high speed deceleration jerk (Jh) in mm/min^3 divided by 1 million
+    float accel_max;                        // max acceleration in mm/min^2 divided by 1000, 0 for none (S-curve ramps only)
     //float recip_jerk;                       // stored reciprocal of current jerk value - has the million in it
     float max_junction_accel;               // high speed deceleration jerk (Jh) in mm/min^3 divided by 1 million
     float junction_dev;                     // aka cornering delta -- DEPRICATED!
@@ -394,6 +398,8 @@ typedef struct cmSingleton {                // struct to manage cm globals and c
     // system group settings
     float junction_integration_time;        // how aggressively will the machine corner? 1.6 or so is about the upper limit
     float chordal_tolerance;                // arc chordal accuracy setting in mm
+    uint8_t ramp_profile;                   // acceleration ramp shape - see rampProfile in planner.h
+    float decel_jerk_ratio;                 // S-curve deceleration jerk as a multiple of the acceleration jerk
     bool soft_limit_enable;                 // true to enable soft limit testing on Gcode inputs
     bool limit_enable;                      // true to enable limit switches (disabled is same as override)
     bool safety_interlock_enable;           // true to enable safety interlock system
@@ -516,6 +522,7 @@ stat_t cm_deferred_write_callback(void);
 void cm_set_model_target(const float target[], const bool flag[]);
 bool cm_get_soft_limits(void);
 void cm_set_soft_limits(bool enable);
+bool cm_reach_is_tested(void);
 
 stat_t cm_test_soft_limits(const float target[]);
 
@@ -524,6 +531,7 @@ stat_t cm_test_soft_limits(const float target[]);
 // Initialization and termination (4.3.2)
 void canonical_machine_init(void);
 void canonical_machine_reset_rotation(void);                    // NOT in NIST
+bool cm_rotation_is_identity(void);                             // NOT in NIST
 void canonical_machine_reset(void);
 void canonical_machine_init_assertions(void);
 stat_t canonical_machine_test_assertions(void);
@@ -574,7 +582,9 @@ stat_t cm_goto_g30_position(const float target[], const bool flags[]);      // G
 // Machining Attributes (4.3.5)
 stat_t cm_set_feed_rate(const float feed_rate);                             // F parameter
 stat_t cm_set_feed_rate_mode(const uint8_t mode);                           // G93, G94, (G95 unimplemented)
-stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode);  // G61, G61.1, G64
+stat_t cm_set_path_control(GCodeState_t *gcode_state, const uint8_t mode,   // G61, G61.1, G64
+                           const float P_word, const bool P_word_f,
+                           const float Q_word, const bool Q_word_f);
 
 // Machining Functions (4.3.6)
 stat_t cm_straight_feed(const float target[], const bool flags[]);          // G1
@@ -700,6 +710,9 @@ stat_t cm_set_vm(nvObj_t *nv);          // set velocity max and reciprocal
 stat_t cm_set_fr(nvObj_t *nv);          // set feedrate max and reciprocal
 stat_t cm_set_jm(nvObj_t *nv);          // set jerk max with 1,000,000 correction
 stat_t cm_set_jh(nvObj_t *nv);          // set jerk high with 1,000,000 correction
+stat_t cm_set_ac(nvObj_t *nv);          // set acceleration max
+stat_t cm_set_rp(nvObj_t *nv);          // set ramp profile
+stat_t cm_set_jr(nvObj_t *nv);          // set deceleration jerk ratio
 
 stat_t cm_set_mfo(nvObj_t *nv);         // set manual feedrate override factor
 stat_t cm_set_mto(nvObj_t *nv);         // set manual traverse override factor
@@ -749,6 +762,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
 
     void cm_print_jt(nvObj_t *nv);          // global CM settings
     void cm_print_ct(nvObj_t *nv);
+    void cm_print_rp(nvObj_t *nv);
+    void cm_print_jr(nvObj_t *nv);
     void cm_print_sl(nvObj_t *nv);
     void cm_print_lim(nvObj_t *nv);
     void cm_print_saf(nvObj_t *nv);
@@ -769,6 +784,7 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     void cm_print_tn(nvObj_t *nv);
     void cm_print_jm(nvObj_t *nv);
     void cm_print_jh(nvObj_t *nv);
+    void cm_print_ac(nvObj_t *nv);
     void cm_print_ra(nvObj_t *nv);
 
     void cm_print_hi(nvObj_t *nv);
@@ -816,6 +832,8 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
 
     #define cm_print_jt tx_print_stub       // global CM settings
     #define cm_print_ct tx_print_stub
+    #define cm_print_rp tx_print_stub
+    #define cm_print_jr tx_print_stub
     #define cm_print_sl tx_print_stub
     #define cm_print_lim tx_print_stub
     #define cm_print_saf tx_print_stub
@@ -836,6 +854,7 @@ stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line
     #define cm_print_tn tx_print_stub
     #define cm_print_jm tx_print_stub
     #define cm_print_jh tx_print_stub
+    #define cm_print_ac tx_print_stub
     #define cm_print_ra tx_print_stub
 
     #define cm_print_hi tx_print_stub
@@ -42,6 +42,9 @@
 #include "xio.h"
 
 static void _set_defa(nvObj_t *nv, bool print);
+static void _init_token_index(void);
+
+static bool _token_index_ready = false;     // nv_get_index() scans the table until the index is built
 
 /***********************************************************************************
  **** STRUCTURE ALLOCATIONS ********************************************************
@@ -113,6 +116,7 @@ void config_init()
 {
     nvObj_t *nv = nv_reset_nv_list();
     config_init_assertions();
+    _init_token_index();
     js.json_mode = JSON_MODE;                    // initial value until persistence is read
     _set_defa(nv, false);
     rpt_print_loading_configs_message();
@@ -385,11 +389,16 @@ stat_t set_flt(nvObj_t *nv)
  *
  *  The sys group is an exception where the children carry a blank group field, even though
  *  the sys parent is labeled as a TYPE_PARENT.
+ *
+ *  A group can't have more than NV_MAX_OBJECTS children. One that does is reported as an
+ *  exception and returns an error with the children that fit, rather than running past
+ *  the end of the body - so a table entry that takes a group over the limit shows up.
  */
 
 stat_t get_grp(nvObj_t *nv)
 {
     char group[GROUP_LEN+1];
+    uint8_t children = 0;
 
     strcpy(group, nv->token);                       // save the group string
     nv_reset_nv_list();                             // start with a clean list
@@ -397,6 +406,9 @@ stat_t get_grp(nvObj_t *nv)
     nv->valuetype = TYPE_PARENT;                    // make first object the parent
     for (index_t i=0; nv_index_is_single(i); i++) {
         if (strcmp(group, cfgArray[i].group) != 0) { continue; }
+        if (++children > NV_MAX_OBJECTS) {
+            return (rpt_exception(STAT_JSON_OUTPUT_TOO_LONG, "get_grp() group has more than NV_MAX_OBJECTS children"));
+        }
         (++nv)->index = i;
         nv_get_nvObj(nv);
     }
@@ -440,18 +452,44 @@ stat_t set_grp(nvObj_t *nv)
  */
 
 /* nv_get_index() - get index from mnenonic token + group
+ * _get_index_by_scan() - linear table scan. Used until the token index is built
+ * _init_token_index() - build the token index
  *
- * nv_get_index() is the most expensive routine in the whole config. It does a
- * linear table scan of the strings, which of course could be further
- * optimized with indexes or hashing.
+ * nv_get_index() is the most expensive routine in the whole config as every JSON
+ * key, status report and text mode command goes through it. It does a binary search
+ * of cfgTokenIndex[], which lists the cfgArray indexes sorted by token. Tokens match
+ * on their first NV_TOKEN_MATCH_LEN characters, and if two tokens are the same the
+ * lower index wins - the same result as the original scan of the table.
+ *
+ * The index is built once by config_init() as cfgArray is const and never changes.
  */
-index_t nv_get_index(const char *group, const char *token)
+
+#define NV_TOKEN_MATCH_LEN 5                // characters compared by the lookup
+
+static int _compare_token_index(const void *a, const void *b)
 {
-    char c;
-    char str[TOKEN_LEN + GROUP_LEN+1];    // should actually never be more than TOKEN_LEN+1
-    strncpy(str, group, GROUP_LEN+1);
-    strncat(str, token, TOKEN_LEN+1);
+    index_t ia = *(const index_t *)a;
+    index_t ib = *(const index_t *)b;
+    int cmp = strncmp(cfgArray[ia].token, cfgArray[ib].token, NV_TOKEN_MATCH_LEN);
+    if (cmp != 0) {
+        return (cmp);
+    }
+    return ((ia < ib) ? -1 : 1);            // keep table order for duplicates
+}
+
+static void _init_token_index()
+{
+    index_t index_max = nv_index_max();
+    for (index_t i=0; i < index_max; i++) {
+        cfgTokenIndex[i] = i;
+    }
+    qsort(cfgTokenIndex, index_max, sizeof(index_t), _compare_token_index);
+    _token_index_ready = true;
+}
 
+static index_t _get_index_by_scan(const char *str)
+{
+    char c;
     index_t i;
     index_t index_max = nv_index_max();
 
@@ -470,6 +508,33 @@ index_t nv_get_index(const char *group, const char *token)
     return (NO_MATCH);
 }
 
+index_t nv_get_index(const char *group, const char *token)
+{
+    char str[TOKEN_LEN + GROUP_LEN+1];    // should actually never be more than TOKEN_LEN+1
+    strncpy(str, group, GROUP_LEN+1);
+    strncat(str, token, TOKEN_LEN+1);
+
+    if (!_token_index_ready) {
+        return (_get_index_by_scan(str));
+    }
+
+    // find the first entry in the index that is not less than the token
+    index_t lo = 0;
+    index_t hi = nv_index_max();
+    while (lo < hi) {
+        index_t mid = lo + ((hi - lo) >> 1);
+        if (strncmp(cfgArray[cfgTokenIndex[mid]].token, str, NV_TOKEN_MATCH_LEN) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if ((lo < nv_index_max()) && (strncmp(cfgArray[cfgTokenIndex[lo]].token, str, NV_TOKEN_MATCH_LEN) == 0)) {
+        return (cfgTokenIndex[lo]);
+    }
+    return (NO_MATCH);
+}
+
 /*
  * nv_get_type() - returns command type as a NV_TYPE enum
  *
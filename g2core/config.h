@@ -289,6 +289,7 @@ typedef struct cfgItem {
 extern nvStr_t nvStr;
 extern nvList_t nvl;
 extern const cfgItem_t cfgArray[];
+extern index_t cfgTokenIndex[];         // cfgArray indexes sorted by token (see nv_get_index())
 
 //#define nv_header nv.list
 #define nv_header (&nvl.list[0])
@@ -35,8 +35,11 @@
 #include "text_parser.h"
 #include "settings.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "plan_arc.h"
 #include "stepper.h"
+#include "step_trace.h"
+#include "profiler.h"
 #include "gpio.h"
 #include "spindle.h"
 #include "temperature.h"
@@ -275,6 +278,7 @@ const cfgItem_t cfgArray[] = {
     { "x","xtm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   (float *)&cm.a[AXIS_X].travel_max,     X_TRAVEL_MAX },
     { "x","xjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_X].jerk_max,       X_JERK_MAX },
     { "x","xjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_X].jerk_high,      X_JERK_HIGH_SPEED },
+    { "x","xac",_fipc, 0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_X].accel_max,      X_ACCEL_MAX },
     { "x","xhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_X].homing_input,   X_HOMING_INPUT },
     { "x","xhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_X].homing_dir,     X_HOMING_DIRECTION },
     { "x","xsv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  (float *)&cm.a[AXIS_X].search_velocity,X_SEARCH_VELOCITY },
@@ -289,6 +293,7 @@ const cfgItem_t cfgArray[] = {
     { "y","ytm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   (float *)&cm.a[AXIS_Y].travel_max,     Y_TRAVEL_MAX },
     { "y","yjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_Y].jerk_max,       Y_JERK_MAX },
     { "y","yjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_Y].jerk_high,      Y_JERK_HIGH_SPEED },
+    { "y","yac",_fipc, 0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_Y].accel_max,      Y_ACCEL_MAX },
     { "y","yhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_Y].homing_input,   Y_HOMING_INPUT },
     { "y","yhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_Y].homing_dir,     Y_HOMING_DIRECTION },
     { "y","ysv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  (float *)&cm.a[AXIS_Y].search_velocity,Y_SEARCH_VELOCITY },
@@ -303,6 +308,7 @@ const cfgItem_t cfgArray[] = {
     { "z","ztm",_fipc, 3, cm_print_tm, get_flt,   set_flu,   (float *)&cm.a[AXIS_Z].travel_max,     Z_TRAVEL_MAX },
     { "z","zjm",_fipc, 0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_Z].jerk_max,       Z_JERK_MAX },
     { "z","zjh",_fipc, 0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_Z].jerk_high,      Z_JERK_HIGH_SPEED },
+    { "z","zac",_fipc, 0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_Z].accel_max,      Z_ACCEL_MAX },
     { "z","zhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_Z].homing_input,   Z_HOMING_INPUT },
     { "z","zhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_Z].homing_dir,     Z_HOMING_DIRECTION },
     { "z","zsv",_fipc, 0, cm_print_sv, get_flt,   set_flup,  (float *)&cm.a[AXIS_Z].search_velocity,Z_SEARCH_VELOCITY },
@@ -317,6 +323,7 @@ const cfgItem_t cfgArray[] = {
     { "a","atm",_fip,  3, cm_print_tm, get_flt,   set_flt,   (float *)&cm.a[AXIS_A].travel_max,     A_TRAVEL_MAX },
     { "a","ajm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_A].jerk_max,       A_JERK_MAX },
     { "a","ajh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_A].jerk_high,      A_JERK_HIGH_SPEED },
+    { "a","aac",_fip,  0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_A].accel_max,      A_ACCEL_MAX },
     { "a","ara",_fipc, 3, cm_print_ra, get_flt,   set_flt,   (float *)&cm.a[AXIS_A].radius,         A_RADIUS},
     { "a","ahi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_A].homing_input,   A_HOMING_INPUT },
     { "a","ahd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_A].homing_dir,     A_HOMING_DIRECTION },
@@ -332,6 +339,7 @@ const cfgItem_t cfgArray[] = {
     { "b","btm",_fip,  3, cm_print_tm, get_flt,   set_flt,   (float *)&cm.a[AXIS_B].travel_max,     B_TRAVEL_MAX },
     { "b","bjm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_B].jerk_max,       B_JERK_MAX },
     { "b","bjh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_B].jerk_high,      B_JERK_HIGH_SPEED },
+    { "b","bac",_fip,  0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_B].accel_max,      B_ACCEL_MAX },
     { "b","bra",_fipc, 3, cm_print_ra, get_flt,   set_flt,   (float *)&cm.a[AXIS_B].radius,         B_RADIUS },
     { "b","bhi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_B].homing_input,   B_HOMING_INPUT },
     { "b","bhd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_B].homing_dir,     B_HOMING_DIRECTION },
@@ -347,6 +355,7 @@ const cfgItem_t cfgArray[] = {
     { "c","ctm",_fip,  3, cm_print_tm, get_flt,   set_flt,   (float *)&cm.a[AXIS_C].travel_max,     C_TRAVEL_MAX },
     { "c","cjm",_fip,  0, cm_print_jm, get_flt,   cm_set_jm, (float *)&cm.a[AXIS_C].jerk_max,       C_JERK_MAX },
     { "c","cjh",_fip,  0, cm_print_jh, get_flt,   cm_set_jh, (float *)&cm.a[AXIS_C].jerk_high,       C_JERK_HIGH_SPEED },
+    { "c","cac",_fip,  0, cm_print_ac, get_flt,   cm_set_ac, (float *)&cm.a[AXIS_C].accel_max,      C_ACCEL_MAX },
     { "c","cra",_fipc, 3, cm_print_ra, get_flt,   set_flt,   (float *)&cm.a[AXIS_C].radius,         C_RADIUS },
     { "c","chi",_fip,  0, cm_print_hi, get_ui8,   cm_set_hi, (float *)&cm.a[AXIS_C].homing_input,   C_HOMING_INPUT },
     { "c","chd",_fip,  0, cm_print_hd, get_ui8,   set_01,    (float *)&cm.a[AXIS_C].homing_dir,     C_HOMING_DIRECTION },
@@ -839,6 +848,17 @@ const cfgItem_t cfgArray[] = {
     // General system parameters
     { "sys","jt", _fipn, 2, cm_print_jt,  get_flt, cm_set_jt,(float *)&cm.junction_integration_time,JUNCTION_INTEGRATION_TIME },
     { "sys","ct", _fipnc,4, cm_print_ct,  get_flt, set_flup, (float *)&cm.chordal_tolerance,        CHORDAL_TOLERANCE },
+    { "ramp","rp",_fipn, 0, cm_print_rp,  get_ui8, cm_set_rp,(float *)&cm.ramp_profile,             RAMP_PROFILE },
+    { "ramp","jr",_fipn, 2, cm_print_jr,  get_flt, cm_set_jr,(float *)&cm.decel_jerk_ratio,         DECEL_JERK_RATIO },
+    { "kin","kty",_fipn, 0, kn_print_kty, get_ui8, kn_set_kty,(float *)&kn.type,                     KINEMATICS },
+    { "kin","kdr",_fipnc,3, kn_print_kdr, get_flt, kn_set_geometry,(float *)&kn.delta_radius,        DELTA_RADIUS },
+    { "kin","kdl",_fipnc,3, kn_print_kdl, get_flt, kn_set_geometry,(float *)&kn.delta_rod_length,    DELTA_ROD_LENGTH },
+    { "kin","ksp",_fipnc,3, kn_print_ksp, get_flt, kn_set_geometry,(float *)&kn.scara_proximal,      SCARA_PROXIMAL_LENGTH },
+    { "kin","ksd",_fipnc,3, kn_print_ksd, get_flt, kn_set_geometry,(float *)&kn.scara_distal,        SCARA_DISTAL_LENGTH },
+    { "kin","ktt",_fipn, 0, kn_print_ktt, get_ui8, kn_set_ktt, (float *)&kn.trunnion_tilt,            TRUNNION_TILT_AXIS },
+    { "kin","kpx",_fipnc,3, kn_print_kpx, get_flt, kn_set_pivot,(float *)&kn.pivot[0],                TRUNNION_PIVOT_X },
+    { "kin","kpy",_fipnc,3, kn_print_kpy, get_flt, kn_set_pivot,(float *)&kn.pivot[1],                TRUNNION_PIVOT_Y },
+    { "kin","kpz",_fipnc,3, kn_print_kpz, get_flt, kn_set_pivot,(float *)&kn.pivot[2],                TRUNNION_PIVOT_Z },
     { "sys","sl", _fipn, 0, cm_print_sl,  get_ui8, set_01,   (float *)&cm.soft_limit_enable,        SOFT_LIMIT_ENABLE },
     { "sys","lim", _fipn,0, cm_print_lim, get_ui8, set_01,   (float *)&cm.limit_enable,             HARD_LIMIT_ENABLE },
     { "sys","saf", _fipn,0, cm_print_saf, get_ui8, set_01,   (float *)&cm.safety_interlock_enable,  SAFETY_INTERLOCK_ENABLE },
@@ -910,6 +930,27 @@ const cfgItem_t cfgArray[] = {
     { "", "defa",_f0, 0, tx_print_nul, help_defa, set_defaults,(float *)&cs.null,0 },   // set/print defaults / help screen
     { "", "flash",_f0,0, tx_print_nul, help_flash,hw_flash,  (float *)&cs.null,0 },
 
+#if (STEP_TRACE_ENABLED == true)
+    { "", "trc", _f0, 0, st_trace_print_trc, st_trace_get_trc, st_trace_set_trc, (float *)&cs.null, 0 },  // step trace mode - SET clears the trace
+    { "", "trn", _f0, 0, st_trace_print_trn, st_trace_get_trn, set_ro,           (float *)&cs.null, 0 },  // step trace record count
+    { "", "trd", _f0, 0, tx_print_int,       st_trace_get_trd, set_ro,           (float *)&cs.null, 0 },  // GET to stop and dump step trace
+#endif
+
+#if (PROFILER_ENABLED == true)
+    // Hot path profiler - see profiler.h. Set a point to 0 to clear it, or profu to 0 to clear all
+    { "prof","profm",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // mp_exec_move()
+    { "prof","profs",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // _exec_aline_segment()
+    { "prof","profp",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // st_prep_line()
+    { "prof","profb",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // _plan_block()
+    { "prof","profg",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // gcode_parser()
+    { "prof","profj",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // json_parser()
+    { "prof","profh",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // _calculate_jerk() cache hits
+    { "prof","profk",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // _calculate_jerk() cache misses
+    { "prof","profi",_f0, 0, prof_print_point, prof_get_point, prof_set_point, (float *)&cs.null, 0 },  // kn_inverse_kinematics()
+    { "prof","profu",_f0, 1, prof_print_profu, prof_get_profu, prof_set_profu, (float *)&cs.null, 0 },  // worst-case exec as % of segment time
+    { "prof","profc",_f0, 0, prof_print_profc, prof_get_profc, set_ro,  (float *)&cs.null, 0 },  // jerk cache hit rate and time saved
+#endif
+
 #ifdef __HELP_SCREENS
     { "", "help",_f0, 0, tx_print_nul, help_config, set_nul, (float *)&cs.null,0 }, // prints config help screen
     { "", "h",   _f0, 0, tx_print_nul, help_config, set_nul, (float *)&cs.null,0 }, // alias for "help"
@@ -1061,8 +1102,10 @@ const cfgItem_t cfgArray[] = {
     //      - Uber groups (count these separately)
 
     { "","sys",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // system group
+    { "","ramp",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // ramp profile group
+    { "","kin", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // kinematics group
     { "","p1", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // PWM 1 group
-    // 2
+    // 4
     { "","1",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // motor groups
     { "","2",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","3",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
@@ -1073,14 +1116,14 @@ const cfgItem_t cfgArray[] = {
 #if (MOTORS >= 6)
     { "","6",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
 #endif
-    // +4 = 6
+    // +4 = 8
     { "","x",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // axis groups
     { "","y",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","z",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","a",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","b",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","c",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
-    // +6 = 12
+    // +6 = 14
     { "","in",  _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // input state
     { "","di1", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // input configs
     { "","di2", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
@@ -1091,7 +1134,7 @@ const cfgItem_t cfgArray[] = {
     { "","di7", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","di8", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","di9", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
-    // +10 = 22
+    // +10 = 24
     { "","out", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // output state
     { "","do1", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // output configs
     { "","do2", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
@@ -1106,7 +1149,7 @@ const cfgItem_t cfgArray[] = {
     { "","do11", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","do12", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","do13", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
-    // +14 = 36
+    // +14 = 38
     { "","g54",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // coord offset groups
     { "","g55",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
     { "","g56",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },
@@ -1116,7 +1159,7 @@ const cfgItem_t cfgArray[] = {
     { "","g92",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // origin offsets
     { "","g28",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // g28 home position
     { "","g30",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // g30 home position
-    // +9 = 45
+    // +9 = 47
     { "","tof",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // tool offsets
     { "","tt1",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // tt offsets
     { "","tt2",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // tt offsets
@@ -1134,7 +1177,7 @@ const cfgItem_t cfgArray[] = {
     { "","tt14",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // tt offsets
     { "","tt15",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // tt offsets
     { "","tt16",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // tt offsets
-    // +17 = 62
+    // +17 = 64
     { "","mpo",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // machine position group
     { "","pos",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // work position group
     { "","ofs",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // work offset group
@@ -1143,14 +1186,14 @@ const cfgItem_t cfgArray[] = {
     { "","pwr",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // motor power enagled group
     { "","jog",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // axis jogging state group
     { "","jid",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },    // job ID group
-    // +8 = 70
+    // +8 = 72
     { "","he1", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // heater 1 group
     { "","he2", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // heater 2 group
     { "","he3", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // heater 3 group
     { "","pid1",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // PID 1 group
     { "","pid2",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // PID 2 group
     { "","pid3",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },   // PID 3 group
-    // +6 = 76
+    // +6 = 78
 
 #ifdef __USER_DATA
     { "","uda", _f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },  // user data group
@@ -1168,6 +1211,9 @@ const cfgItem_t cfgArray[] = {
     { "","_xs",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },  // correction steps group
     { "","_fe",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },  // following error group
 #endif
+#if (PROFILER_ENABLED == true)
+    { "","prof",_f0, 0, tx_print_nul, get_grp, set_grp,(float *)&cs.null,0 },  // hot path profiler group
+#endif
 
     // Uber-group (groups of groups, for text-mode displays only)
     // *** Must agree with NV_COUNT_UBER_GROUPS below ****
@@ -1182,7 +1228,7 @@ const cfgItem_t cfgArray[] = {
 /***** Make sure these defines line up with any changes in the above table *****/
 
 #define NV_COUNT_UBER_GROUPS    6     // count of uber-groups, above
-#define FIXED_GROUPS            92    // count of fixed groups, excluding optional groups
+#define FIXED_GROUPS            94    // count of fixed groups, excluding optional groups
 
 #if (MOTORS >= 5)
 #define MOTOR_GROUP_5           1
@@ -1208,8 +1254,14 @@ const cfgItem_t cfgArray[] = {
 #define DIAGNOSTIC_GROUPS       0
 #endif
 
+#if (PROFILER_ENABLED == true)
+#define PROFILER_GROUPS         1    // count of profiler groups only
+#else
+#define PROFILER_GROUPS         0
+#endif
+
 #define TEMPERATURE_GROUPS      6
-#define NV_COUNT_GROUPS (FIXED_GROUPS + MOTOR_GROUP_5 + MOTOR_GROUP_6 + USER_DATA_GROUPS + DIAGNOSTIC_GROUPS + TEMPERATURE_GROUPS)
+#define NV_COUNT_GROUPS (FIXED_GROUPS + MOTOR_GROUP_5 + MOTOR_GROUP_6 + USER_DATA_GROUPS + DIAGNOSTIC_GROUPS + PROFILER_GROUPS + TEMPERATURE_GROUPS)
 
 /* <DO NOT MESS WITH THESE DEFINES> */
 #define NV_INDEX_MAX (sizeof(cfgArray) / sizeof(cfgItem_t))
@@ -1218,6 +1270,8 @@ const cfgItem_t cfgArray[] = {
 #define NV_INDEX_START_UBER_GROUPS (NV_INDEX_MAX - NV_COUNT_UBER_GROUPS)
 /* </DO NOT MESS WITH THESE DEFINES> */
 
+index_t cfgTokenIndex[NV_INDEX_MAX];    // lookup index for nv_get_index() - built by config_init()
+
 index_t nv_index_max() { return ( NV_INDEX_MAX );}
 bool nv_index_is_single(index_t index) { return ((index <= NV_INDEX_END_SINGLES) ? true : false);}
 bool nv_index_is_group(index_t index) { return (((index >= NV_INDEX_START_GROUPS) && (index < NV_INDEX_START_UBER_GROUPS)) ? true : false);}
@@ -1318,6 +1372,12 @@ bool nv_group_is_prefixed(char *group)
     if (strcmp("sr", group) == 0) {
         return (false);
     }
+    if (strcmp("ramp", group) == 0) {
+        return (false);
+    }
+    if (strcmp("kin", group) == 0) {
+        return (false);
+    }
     return (true);
 }
 
@@ -1413,6 +1473,8 @@ static stat_t _do_heaters(nvObj_t *nv)  // print parameters for all heater group
 static stat_t _do_all(nvObj_t *nv)  // print all parameters
 {
     _do_group(nv, (char *)"sys");   // System group
+    _do_group(nv, (char *)"ramp");  // Ramp profile group
+    _do_group(nv, (char *)"kin");   // Kinematics group
     _do_motors(nv);
     _do_axes(nv);
     _do_inputs(nv);
@@ -74,7 +74,11 @@ stat_t encoder_test_assertions() {
  *	position except if the machine is at zero.
  */
 
-void en_set_encoder_steps(uint8_t motor, float steps) { en.en[motor].encoder_steps = (int32_t)round(steps); }
+void en_set_encoder_steps(uint8_t motor, float steps)
+{
+    en.en[motor].encoder_steps = (int32_t)round(steps);
+    en.en[motor].commanded_steps = steps;
+}
 
 /*
  * en_read_encoder()
@@ -88,6 +92,31 @@ void en_set_encoder_steps(uint8_t motor, float steps) { en.en[motor].encoder_ste
 
 float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps); }
 
+/*
+ * en_read_following_error()
+ *
+ *	Read the encoder positions, the commanded positions they are sampled against and
+ *	the difference between them (the following error) for all motors. The loader can
+ *	take a new sample while this runs from the exec, so retry until all motors come
+ *	from the same sample.
+ */
+
+void en_read_following_error(float encoder_steps[], float commanded_steps[], float following_error[])
+{
+    uint32_t sample;
+    do {
+        sample = en.sample;
+        for (uint8_t m = 0; m < MOTORS; m++) {
+            encoder_steps[m] = (float)en.en[m].encoder_steps;
+            commanded_steps[m] = en.en[m].commanded_steps;
+        }
+    } while (sample != en.sample);
+
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        following_error[m] = encoder_steps[m] - commanded_steps[m];
+    }
+}
+
 /*
  * en_take_encoder_snapshot()
  * en_get_encoder_snapshot_position()
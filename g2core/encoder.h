@@ -101,6 +101,8 @@
 #define ACCUMULATE_ENCODER(m)                     \
     en.en[m].encoder_steps += en.en[m].steps_run; \
     en.en[m].steps_run = 0;
+#define SET_ENCODER_COMMANDED_STEPS(m, s) en.en[m].commanded_steps = s;
+#define ADVANCE_ENCODER_SAMPLE() en.sample++;
 
 /**** Structures ****/
 
@@ -108,10 +110,12 @@ typedef struct enEncoder {          // one real or virtual encoder per controlle
     int8_t  step_sign;              // set to +1 or -1
     int16_t steps_run;              // + or - steps counted during stepper interrupt
     int32_t encoder_steps;          // counted encoder position	in steps
+    float commanded_steps;          // commanded position at the same point (start of the segment last loaded)
 } enEncoder_t;
 
 typedef struct enEncoders {
     magic_t     magic_start;
+    volatile uint32_t sample;       // advanced by the loader each time the encoders are sampled
     enEncoder_t en[MOTORS];         // runtime encoder structures
     float       snapshot[MOTORS];   // snapshot vector
     magic_t     magic_end;
@@ -129,6 +133,7 @@ stat_t encoder_test_assertions(void);
 
 void en_set_encoder_steps(uint8_t motor, float steps);
 float en_read_encoder(uint8_t motor);
+void en_read_following_error(float encoder_steps[], float commanded_steps[], float following_error[]);
 
 void en_take_encoder_snapshot();
 float en_get_encoder_snapshot_steps(uint8_t motor);
@@ -314,7 +314,7 @@ char *get_status_message(stat_t status);
 #define STAT_TEMPERATURE_CONTROL_ERROR 209      // temperature controls err'd out
 
 #define STAT_G29_NOT_CONFIGURED 210
-#define STAT_ERROR_211 211
+#define STAT_KINEMATICS_MOVE_UNREACHABLE 211   // move is out of reach of the kinematics - see kinematics.h
 #define STAT_ERROR_212 212
 #define STAT_ERROR_213 213
 #define STAT_ERROR_214 214
@@ -605,7 +605,7 @@ static const char stat_208[] = "No GPIO for this value";
 static const char stat_209[] = "209";
 
 static const char stat_210[] = "Marlin G29 command was not configured at compile-time";
-static const char stat_211[] = "211";
+static const char stat_211[] = "Move is out of reach of the kinematics";
 static const char stat_212[] = "212";
 static const char stat_213[] = "213";
 static const char stat_214[] = "214";
@@ -26,6 +26,7 @@
 #include "spindle.h"
 #include "coolant.h"
 #include "util.h"
+#include "profiler.h"
 #include "xio.h"                    // for char definitions
 
 #if MARLIN_COMPAT_ENABLED == true
@@ -127,6 +128,7 @@ typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
     uint8_t H_word;                 // H word - used by G43s
     uint8_t L_word;                 // L word - used by G10s
     float P_word;                   // P - parameter used for dwell time in seconds, G10 coord select...
+    float Q_word;                   // Q - G64 collinear merging tolerance
     float S_word;                   // S word - in RPM
 
     uint8_t feed_rate_mode;         // See cmFeedRateMode for settings
@@ -172,6 +174,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool H_word;
     bool L_word;
     bool P_word;
+    bool Q_word;
     bool S_word;
 
     bool feed_rate_mode;
@@ -244,6 +247,7 @@ void gcode_parser_init()
 
 stat_t gcode_parser(char *block)
 {
+    PROF_START(prof_start);
     char *str = block;                      // gcode command or NUL string
     char none = NUL;
     char *active_comment = &none;           // gcode comment or NUL string
@@ -251,6 +255,7 @@ stat_t gcode_parser(char *block)
 
     stat_t check_ret = _verify_checksum(str);
     if (check_ret != STAT_OK) {
+        PROF_END(prof_start, PROF_GCODE_PARSER);
         return check_ret;
     }
 
@@ -259,20 +264,26 @@ stat_t gcode_parser(char *block)
     // TODO, now MSG is put in the active comment, handle that.
 
     if (str[0] == NUL) {                    // normalization returned null string
+        PROF_END(prof_start, PROF_GCODE_PARSER);
         return (STAT_OK);                   // most likely a comment line
     }
 
     // Trap M30 and M2 as $clear conditions. This has no effect if not in ALARM or SHUTDOWN
     cm_parse_clear(str);                    // parse Gcode and clear alarms if M30 or M2 is found
-    ritorno(cm_is_alarmed());               // return error status if in alarm, shutdown or panic
-
-    // Block delete omits the line if a / char is present in the first space
-    // For now this is unconditional and will always delete
-//  if ((block_delete_flag == true) && (cm_get_block_delete_switch() == true)) {
-    if (block_delete_flag == true) {
-        return (STAT_NOOP);
+    stat_t status = cm_is_alarmed();        // return error status if in alarm, shutdown or panic
+
+    if (status == STAT_OK) {
+        // Block delete omits the line if a / char is present in the first space
+        // For now this is unconditional and will always delete
+//      if ((block_delete_flag == true) && (cm_get_block_delete_switch() == true)) {
+        if (block_delete_flag == true) {
+            status = STAT_NOOP;
+        } else {
+            status = _parse_gcode_block(block, active_comment);
+        }
     }
-    return(_parse_gcode_block(block, active_comment));
+    PROF_END(prof_start, PROF_GCODE_PARSER);
+    return (status);
 }
 
 /*
@@ -860,6 +871,7 @@ stat_t _parse_gcode_block(char *buf, char *active_comment)
             case 'T': SET_NON_MODAL (tool_select, (uint8_t)trunc(value));
             case 'F': SET_NON_MODAL (F_word, value);
             case 'P': SET_NON_MODAL (P_word, value);                // used for dwell time, G10 coord select
+            case 'Q': SET_NON_MODAL (Q_word, value);                // used for G64 merging tolerance
             case 'S': SET_NON_MODAL (S_word, value);
             case 'X': SET_NON_MODAL (target[AXIS_X], value);
             case 'Y': SET_NON_MODAL (target[AXIS_Y], value);
@@ -995,7 +1007,7 @@ stat_t _execute_gcode_block(char *active_comment)
     EXEC_FUNC(cm_set_coord_system, coord_system);           // G54, G55, G56, G57, G58, G59
 
     if (gf.path_control) {                                  // G61, G61.1, G64
-        status = cm_set_path_control(MODEL, gv.path_control);
+        ritorno(cm_set_path_control(MODEL, gv.path_control, gv.P_word, gf.P_word, gv.Q_word, gf.Q_word));
     }
 
     EXEC_FUNC(cm_set_distance_mode, distance_mode);         // G90, G91
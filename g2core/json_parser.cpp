@@ -34,6 +34,7 @@
 #include "canonical_machine.h"
 #include "report.h"
 #include "util.h"
+#include "profiler.h"
 #include "xio.h"
 
 /**** Allocation ****/
@@ -87,6 +88,7 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth);
 
 stat_t json_parser(char *str, bool suppress_response) // suppress_response defaults to false, see decalaration in .h
 {
+    PROF_START(prof_start);
     nvObj_t *nv = nv_reset_nv_list();               // get a fresh nvObj list
     stat_t status = _json_parser_kernal(nv, str);
     if (status == STAT_OK) {                        // execute the command
@@ -94,10 +96,12 @@ stat_t json_parser(char *str, bool suppress_response) // suppress_response defau
         status = _json_parser_execute(nv);
     }
     if (suppress_response || (status == STAT_COMPLETE)) {  // skip the print if returning from something that already did it.
+        PROF_END(prof_start, PROF_JSON_PARSER);
         return status;
     }
     nv_print_list(status, TEXT_NO_PRINT, JSON_RESPONSE_FORMAT);
     sr_request_status_report(SR_REQUEST_TIMED);     // generate incremental status report to show any changes
+    PROF_END(prof_start, PROF_JSON_PARSER);
     return STAT_OK;
 }
 
@@ -1,5 +1,5 @@
 /*
- * kinematics.cpp - inverse kinematics routines
+ * kinematics.cpp - inverse and forward kinematics
  * This file is part of the g2core project
  *
  * Copyright (c) 2010 - 2016 Alden S. Hart, Jr.
@@ -28,135 +28,798 @@
 #include "g2core.h"
 #include "config.h"
 #include "canonical_machine.h"
+#include "planner.h"
 #include "stepper.h"
 #include "kinematics.h"
+#include "profiler.h"
+#include "text_parser.h"
 #include "util.h"
 
-static void _inverse_kinematics(const float travel[], float joint[]);
+/**** Allocate Structures ****/
+
+knKinematics_t kn;
+
+// the tower angles of a delta - A, B and C counter-clockwise seen from above
+static const float _tower_angle[3] = { 210, 330, 90 };
+
+static void _cartesian_inverse(const float travel[], float joint[]);
+static void _cartesian_forward(const float joint[], float travel[]);
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
 
 /*
- * kn_kinematics() - wrapper routine for inverse kinematics
+ * _unwrap_angle() - return an atan2() angle (degrees) within 180 degrees of the last one
  *
- *	Calls kinematics function(s).
- *	Performs axis mapping & conversion of length units to steps (and deals with inhibited axes)
+ *	atan2() jumps from +180 to -180 as the arm passes the -X axis. The joint can't, so
+ *	the angle is moved by whole turns to stay next to where the joint already is.
+ */
+
+static float _unwrap_angle(float angle, float *last)
+{
+    angle += 360 * roundf((*last - angle) / 360);
+    *last = angle;
+    return (angle);
+}
+
+/*
+ * _center_closest() - closest approach of a line to the origin of X and Y
+ * _passes_center()  - true if a line passes through the origin
  *
- *	The reason steps are returned as floats (as opposed to, say, uint32_t) is to accommodate
- *	fractional DDA steps. The DDA deals with fractional step values as fixed-point binary in
- *	order to get the smoothest possible operation. Steps are passed to the move prep routine
- *	as floats and converted to fixed-point binary during queue loading. See stepper.c for details.
+ *	SCARA and polar joints turn about the origin as the angle of the tool from it. Along a
+ *	line d from the origin that turns d / r^2 radians per mm at radius r, which is worst
+ *	where the line comes closest. _center_closest() sets cross to d times the XY length of
+ *	the line. A line with its ends on either side of the origin turns by half a turn in no
+ *	distance at all; one that only starts or ends there doesn't turn.
  */
 
-void kn_inverse_kinematics(const float travel[], float steps[]) {
-    float joint[AXES];
+static float _center_closest(const float start[], const float length[], float *cross)
+{
+    const float length_sq = square(length[AXIS_X]) + square(length[AXIS_Y]);
+
+    *cross = 0;
+    if (length_sq < EPSILON * EPSILON) {                // no move in XY, no turn
+        return (hypotf(start[AXIS_X], start[AXIS_Y]));
+    }
+    const float t = -(start[AXIS_X] * length[AXIS_X] + start[AXIS_Y] * length[AXIS_Y]) / length_sq;
+    const float clamped = min(max(t, (float)0), (float)1);
+    *cross = fabs(start[AXIS_X] * length[AXIS_Y] - start[AXIS_Y] * length[AXIS_X]);
+    return (hypotf(start[AXIS_X] + length[AXIS_X] * clamped, start[AXIS_Y] + length[AXIS_Y] * clamped));
+}
+
+static bool _passes_center(const float start[], const float end[], float *closest)
+{
+    float length[AXES];
+    float cross;
+    length[AXIS_X] = end[AXIS_X] - start[AXIS_X];
+    length[AXIS_Y] = end[AXIS_Y] - start[AXIS_Y];
+    *closest = _center_closest(start, length, &cross);
+    return ((*closest < EPSILON3) && (hypotf(start[AXIS_X], start[AXIS_Y]) > EPSILON3) &&
+            (hypotf(end[AXIS_X], end[AXIS_Y]) > EPSILON3));
+}
+
+/*
+ * _center_joint_lengths() - SCARA and polar: the axis lengths, but slow the turn about the origin
+ *
+ *	The joint that turns (kn.center_joint) is given the degrees it would turn if it turned
+ *	all along the line at its peak rate (see _center_closest()), so the block runs that
+ *	axis' rate limit in degrees. Lines far from the origin turn less than a degree a mm and
+ *	keep their axis lengths. kn_center_split() keeps the slow part short.
+ */
+
+static void _center_joint_lengths(const float start[], const float length[], float joint_length[])
+{
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        joint_length[axis] = fabs(length[axis]);
+    }
+    float cross;
+    const float closest = _center_closest(start, length, &cross);
+    if (closest < EPSILON3) {                           // starts or ends at the origin, or through it
+        return;
+    }
+    joint_length[kn.center_joint] = max(joint_length[kn.center_joint], (float)RADIAN * cross / square(closest));
+}
+
+/*
+ * Cartesian - joint = axis
+ */
+
+static void _cartesian_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);  // the compiler inlines this
+}
+
+static void _cartesian_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+}
+
+/*
+ * CoreXY - the A (X) and B (Y) motors drive crossed belts
+ */
+
+static void _corexy_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);
+    joint[AXIS_X] = travel[AXIS_X] + travel[AXIS_Y];
+    joint[AXIS_Y] = travel[AXIS_X] - travel[AXIS_Y];
+}
+
+static void _corexy_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+    travel[AXIS_X] = (joint[AXIS_X] + joint[AXIS_Y]) / 2;
+    travel[AXIS_Y] = (joint[AXIS_X] - joint[AXIS_Y]) / 2;
+}
+
+/*
+ * Linear delta - joints X, Y and Z are the heights of the carriages on towers A, B and C
+ *
+ *	Each rod spans the horizontal distance from its tower to the effector, so the carriage
+ *	sits sqrt(rod^2 - horizontal^2) above the effector. The forward transform finds the
+ *	point a rod length from all three carriages (trilateration), below the carriages.
+ */
+
+static void _delta_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);
+    for (uint8_t tower = 0; tower < 3; tower++) {
+        float height_sq = kn.rod_sq - square(travel[AXIS_X] - kn.tower_x[tower])
+                                    - square(travel[AXIS_Y] - kn.tower_y[tower]);
+        joint[AXIS_X + tower] = travel[AXIS_Z] + sqrt(max(height_sq, 0.0f));   // clamp out-of-reach
+    }
+}
+
+static void _delta_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+    double p[3][3];
+    for (uint8_t tower = 0; tower < 3; tower++) {
+        p[tower][0] = kn.tower_x[tower];
+        p[tower][1] = kn.tower_y[tower];
+        p[tower][2] = joint[AXIS_X + tower];
+    }
+    double ex[3], ey[3], ez[3], v13[3];
+    double d = 0, i = 0, j = 0, ey_len = 0;
+    for (uint8_t k = 0; k < 3; k++) {
+        ex[k] = p[1][k] - p[0][k];
+        v13[k] = p[2][k] - p[0][k];
+        d += ex[k] * ex[k];
+    }
+    d = sqrt(d);
+    for (uint8_t k = 0; k < 3; k++) {
+        ex[k] /= d;
+        i += ex[k] * v13[k];
+    }
+    for (uint8_t k = 0; k < 3; k++) {
+        ey[k] = v13[k] - i * ex[k];
+        ey_len += ey[k] * ey[k];
+    }
+    ey_len = sqrt(ey_len);
+    for (uint8_t k = 0; k < 3; k++) {
+        ey[k] /= ey_len;
+        j += ey[k] * v13[k];
+    }
+    ez[0] = ex[1] * ey[2] - ex[2] * ey[1];
+    ez[1] = ex[2] * ey[0] - ex[0] * ey[2];
+    ez[2] = ex[0] * ey[1] - ex[1] * ey[0];
 
-    _inverse_kinematics(travel, joint);  // insert inverse kinematics transformations here
-
-// We'll time-test each and see if unrolling is worth it.
-#if 0
-    // Map motors to axes and convert length units to steps
-    // Most of the conversion math has already been done in during config in steps_per_unit()
-    // which takes axis travel, step angle and microsteps into account.
-    for (uint8_t axis=0; axis<AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) { joint[axis] = 0;}
-        if (st_cfg.mot[MOTOR_1].motor_map == axis) {
-            steps[MOTOR_1] = joint[axis] * st_cfg.mot[MOTOR_1].steps_per_unit;
+    double x = d / 2;                       // all three spheres have the rod length as radius
+    double y = (i * i + j * j) / (2 * j) - (i / j) * x;
+    double z = -sqrt(std::max((double)kn.rod_sq - x * x - y * y, 0.0));
+    travel[AXIS_X] = p[0][0] + x * ex[0] + y * ey[0] + z * ez[0];
+    travel[AXIS_Y] = p[0][1] + x * ex[1] + y * ey[1] + z * ez[1];
+    travel[AXIS_Z] = p[0][2] + x * ex[2] + y * ey[2] + z * ez[2];
+}
+
+static bool _delta_point_reachable(const float travel[])
+{
+    for (uint8_t tower = 0; tower < 3; tower++) {
+        if (square(travel[AXIS_X] - kn.tower_x[tower]) + square(travel[AXIS_Y] - kn.tower_y[tower]) > kn.rod_sq) {
+            return (false);
         }
-        if (st_cfg.mot[MOTOR_2].motor_map == axis) {
-            steps[MOTOR_2] = joint[axis] * st_cfg.mot[MOTOR_2].steps_per_unit;
+    }
+    return (true);
+}
+
+static bool _delta_reachable(const float start[], const float end[])     // the reach is convex
+{
+    return (_delta_point_reachable(start) && _delta_point_reachable(end));
+}
+
+/*
+ * SCARA - joint X is the shoulder angle from the +X axis, joint Y the elbow angle
+ *
+ *	The elbow is solved with the law of cosines and always bends the same way (positive
+ *	elbow angle), so the arm never flips configuration in the middle of a move.
+ */
+
+static void _scara_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);
+    float x = travel[AXIS_X];
+    float y = travel[AXIS_Y];
+    float cos_elbow = (x*x + y*y - square(kn.scara_proximal) - square(kn.scara_distal)) /
+                      (2 * kn.scara_proximal * kn.scara_distal);
+    cos_elbow = min(max(cos_elbow, -1.0f), 1.0f);                           // clamp out-of-reach
+    float sin_elbow = sqrt(1 - cos_elbow * cos_elbow);
+    float shoulder = atan2(y, x) - atan2(kn.scara_distal * sin_elbow, kn.scara_proximal + kn.scara_distal * cos_elbow);
+    joint[AXIS_X] = _unwrap_angle(shoulder * RADIAN, &kn.angle[0]);
+    joint[AXIS_Y] = atan2(sin_elbow, cos_elbow) * RADIAN;
+}
+
+static void _scara_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+    double shoulder = joint[AXIS_X] / RADIAN;
+    double elbow = shoulder + joint[AXIS_Y] / RADIAN;
+    travel[AXIS_X] = kn.scara_proximal * cos(shoulder) + kn.scara_distal * cos(elbow);
+    travel[AXIS_Y] = kn.scara_proximal * sin(shoulder) + kn.scara_distal * sin(elbow);
+}
+
+static bool _scara_reachable(const float start[], const float end[])
+{
+    float closest;
+    if (_passes_center(start, end, &closest)) {
+        return (false);
+    }
+    if (closest < kn.reach_min - EPSILON3) {                                // through the inner limit
+        return (false);
+    }
+    return ((hypotf(start[AXIS_X], start[AXIS_Y]) <= kn.reach_max + EPSILON3) &&    // the outer reach
+            (hypotf(end[AXIS_X], end[AXIS_Y]) <= kn.reach_max + EPSILON3));         // is convex
+}
+
+/*
+ * Polar - joint X is the radius, joint Y the bed angle
+ *
+ *	At the center the angle is undefined and is left where it was.
+ */
+
+static void _polar_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);
+    float radius = sqrt(square(travel[AXIS_X]) + square(travel[AXIS_Y]));
+    joint[AXIS_X] = radius;
+    if (radius > EPSILON4) {
+        joint[AXIS_Y] = _unwrap_angle(atan2(travel[AXIS_Y], travel[AXIS_X]) * RADIAN, &kn.angle[0]);
+    } else {
+        joint[AXIS_Y] = kn.angle[0];
+    }
+}
+
+static void _polar_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+    double angle = joint[AXIS_Y] / RADIAN;
+    travel[AXIS_X] = joint[AXIS_X] * cos(angle);
+    travel[AXIS_Y] = joint[AXIS_X] * sin(angle);
+}
+
+static bool _polar_reachable(const float start[], const float end[])
+{
+    float closest;
+    return (!_passes_center(start, end, &closest));
+}
+
+/*
+ * Trunnion - RTCP for a rotary table (C) on a tilting trunnion (A or B) - see kinematics.h
+ *
+ *	_trunnion_tilt_axis() - the axis of the tilt joint, A or B
+ *	_tilt()               - tilt a vector by the trunnion angle; the derivative if d is true
+ *	_rotate()             - rotate a vector about Z by the table angle
+ *
+ *	Angles are in radians here. The rotation derivative about Z is (-y, x, 0) of the rotated
+ *	vector, so it needs no function of its own.
+ */
+
+static uint8_t _trunnion_tilt_axis() { return ((kn.trunnion_tilt == 0) ? AXIS_A : AXIS_B); }
+
+static void _tilt(const float v[], const float cos_t, const float sin_t, const bool d, float out[])
+{
+    float c = d ? -sin_t : cos_t;       // d/dt of cos is -sin, of sin is cos
+    float s = d ? cos_t : sin_t;
+    if (kn.trunnion_tilt == 0) {        // A about X
+        out[0] = d ? 0 : v[0];
+        out[1] = c * v[1] - s * v[2];
+        out[2] = s * v[1] + c * v[2];
+    } else {                            // B about Y
+        out[0] = c * v[0] + s * v[2];
+        out[1] = d ? 0 : v[1];
+        out[2] = -s * v[0] + c * v[2];
+    }
+}
+
+static void _rotate(const float v[], const float cos_c, const float sin_c, float out[])
+{
+    out[0] = cos_c * v[0] - sin_c * v[1];
+    out[1] = sin_c * v[0] + cos_c * v[1];
+    out[2] = v[2];
+}
+
+static void _trunnion_inverse(const float travel[], float joint[])
+{
+    memcpy(joint, travel, sizeof(float) * AXES);
+    const float tilt = travel[_trunnion_tilt_axis()] / RADIAN;
+    const float table = travel[AXIS_C] / RADIAN;
+    float v[3], u[3], w[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        v[i] = travel[AXIS_X + i] - kn.pivot[i];
+    }
+    _rotate(v, cos(table), sin(table), u);
+    _tilt(u, cos(tilt), sin(tilt), false, w);
+    for (uint8_t i = 0; i < 3; i++) {
+        joint[AXIS_X + i] = kn.pivot[i] + w[i];
+    }
+}
+
+static void _trunnion_forward(const float joint[], float travel[])
+{
+    memcpy(travel, joint, sizeof(float) * AXES);
+    const float tilt = joint[_trunnion_tilt_axis()] / RADIAN;
+    const float table = joint[AXIS_C] / RADIAN;
+    float w[3], u[3], v[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        w[i] = joint[AXIS_X + i] - kn.pivot[i];
+    }
+    _tilt(w, cos(tilt), -sin(tilt), false, u);      // the transpose undoes the rotation
+    _rotate(u, cos(table), -sin(table), v);
+    for (uint8_t i = 0; i < 3; i++) {
+        travel[AXIS_X + i] = kn.pivot[i] + v[i];
+    }
+}
+
+/*
+ * _trunnion_joint_lengths() - the most each machine axis moves per block, at block speed
+ *
+ *	Along the block the part point is p(s) = start + s * length and the angles move the
+ *	same way, for s from 0 to 1. The machine point is q = pivot + T(tilt) Z(table) (p - pivot),
+ *	so its rate along the block is the Jacobian times the block's length vector:
+ *
+ *	    dq/ds = T Z dp + T' Z (p - pivot) dtilt + T Z' (p - pivot) dtable
+ *
+ *	|dq/ds| is sampled at both ends and every TRUNNION_SAMPLE_DEGREES of rotation between,
+ *	and the largest value of each axis is returned - this is the axis "length" that moving
+ *	at that peak rate for the whole block would take. The samples are close enough that the
+ *	peak between them is under 1% higher; that much is added back.
+ */
+
+#define TRUNNION_SAMPLE_DEGREES 8           // rotation between Jacobian samples
+#define TRUNNION_SAMPLES_MAX 24             // ...but no more samples than this
+#define TRUNNION_SAMPLE_MARGIN 1.01         // covers the peak between samples
+
+static void _trunnion_joint_lengths(const float start[], const float length[], float joint_length[])
+{
+    const uint8_t tilt_axis = _trunnion_tilt_axis();
+    const float d_tilt = length[tilt_axis] / RADIAN;
+    const float d_table = length[AXIS_C] / RADIAN;
+    float turn = (fabs(length[tilt_axis]) + fabs(length[AXIS_C])) / TRUNNION_SAMPLE_DEGREES;
+    uint8_t samples = (uint8_t)min((float)TRUNNION_SAMPLES_MAX, ceil(turn)) + 1;
+
+    memcpy(joint_length, length, sizeof(float) * AXES);
+    for (uint8_t i = 0; i < 3; i++) {
+        joint_length[AXIS_X + i] = 0;
+    }
+    for (uint8_t k = 0; k < samples; k++) {
+        float s = (samples > 1) ? (float)k / (samples - 1) : 0;
+        float tilt = (start[tilt_axis] / RADIAN) + s * d_tilt;
+        float table = (start[AXIS_C] / RADIAN) + s * d_table;
+        float cos_t = cos(tilt), sin_t = sin(tilt);
+        float cos_c = cos(table), sin_c = sin(table);
+
+        float v[3], u[3], dp[3], a[3], b[3], c[3];
+        for (uint8_t i = 0; i < 3; i++) {
+            v[i] = start[AXIS_X + i] + s * length[AXIS_X + i] - kn.pivot[i];
+            dp[i] = length[AXIS_X + i];
         }
-        if (st_cfg.mot[MOTOR_3].motor_map == axis) {
-            steps[MOTOR_3] = joint[axis] * st_cfg.mot[MOTOR_3].steps_per_unit;
+        _rotate(dp, cos_c, sin_c, u);
+        _tilt(u, cos_t, sin_t, false, a);           // T Z dp
+        _rotate(v, cos_c, sin_c, u);
+        _tilt(u, cos_t, sin_t, true, b);            // T' Z (p - pivot)
+        float u_prime[3] = { -u[1], u[0], 0 };
+        _tilt(u_prime, cos_t, sin_t, false, c);     // T Z' (p - pivot)
+        for (uint8_t i = 0; i < 3; i++) {
+            float rate = fabs(a[i] + b[i] * d_tilt + c[i] * d_table) * TRUNNION_SAMPLE_MARGIN;
+            joint_length[AXIS_X + i] = max(joint_length[AXIS_X + i], rate);
         }
-        if (st_cfg.mot[MOTOR_4].motor_map == axis) {
-            steps[MOTOR_4] = joint[axis] * st_cfg.mot[MOTOR_4].steps_per_unit;
+    }
+}
+
+/*
+ * kn_configure() - bind the $kty module and derive its geometry
+ *
+ *	Called by the setters and by the benches. The joint angle history is cleared, so the
+ *	step position should be reset after this (the setters do).
+ */
+
+void kn_configure()
+{
+    kn.inverse = _cartesian_inverse;
+    kn.forward = _cartesian_forward;
+    kn.reachable = NULL;
+    kn.joint_lengths = NULL;
+    kn.center_joint = AXES;
+    kn.linear = true;
+
+    switch (kn.type) {
+        case KINEMATICS_COREXY: {
+            kn.inverse = _corexy_inverse;
+            kn.forward = _corexy_forward;
+            break;
+        }
+        case KINEMATICS_DELTA: {
+            kn.inverse = _delta_inverse;
+            kn.forward = _delta_forward;
+            kn.reachable = _delta_reachable;
+            kn.linear = false;
+            break;
+        }
+        case KINEMATICS_SCARA: {
+            kn.inverse = _scara_inverse;
+            kn.forward = _scara_forward;
+            kn.reachable = _scara_reachable;
+            kn.joint_lengths = _center_joint_lengths;
+            kn.center_joint = AXIS_X;       // the shoulder
+            kn.linear = false;
+            break;
         }
-#if (MOTORS >= 5)
-        if (st_cfg.mot[MOTOR_5].motor_map == axis) {
-            steps[MOTOR_5] = joint[axis] * st_cfg.mot[MOTOR_5].steps_per_unit;
+        case KINEMATICS_POLAR: {
+            kn.inverse = _polar_inverse;
+            kn.forward = _polar_forward;
+            kn.reachable = _polar_reachable;
+            kn.joint_lengths = _center_joint_lengths;
+            kn.center_joint = AXIS_Y;       // the bed
+            kn.linear = false;
+            break;
         }
-#endif
-#if (MOTORS >= 6)
-        if (st_cfg.mot[MOTOR_6].motor_map == axis) {
-            steps[MOTOR_6] = joint[axis] * st_cfg.mot[MOTOR_6].steps_per_unit;
+        case KINEMATICS_TRUNNION: {
+            kn.inverse = _trunnion_inverse;
+            kn.forward = _trunnion_forward;
+            kn.joint_lengths = _trunnion_joint_lengths;
+            kn.linear = false;
+            break;
         }
-#endif
+        default: { break; }
     }
+    for (uint8_t tower = 0; tower < 3; tower++) {
+        kn.tower_x[tower] = kn.delta_radius * cos(_tower_angle[tower] / RADIAN);
+        kn.tower_y[tower] = kn.delta_radius * sin(_tower_angle[tower] / RADIAN);
+    }
+    kn.rod_sq = square(kn.delta_rod_length);
+    kn.reach_min = fabs(kn.scara_proximal - kn.scara_distal);
+    kn.reach_max = kn.scara_proximal + kn.scara_distal;
+    kn.angle[0] = 0;
+    kn.angle[1] = 0;
+    kn_map_motors();                    // also drops the forward cache
+}
 
-#else
+/*
+ * kn_map_motors() - build the motor mapping tables used by the inverse and forward kinematics
+ *
+ *	map[] lists the motors that take steps - those mapped to an axis that isn't inhibited -
+ *	with their joint and steps per unit, so the per-segment mapping is one multiply per motor
+ *	with no lookups into the axis and motor configs.
+ *
+ *	joint_map[] lists the motors the forward kinematics reads each joint from: the ones with
+ *	the finest resolution on that joint, each with its share of the average if several tie.
+ *
+ *	The tables must be rebuilt whenever a motor map ($1ma), steps per unit ($1sa, $1tr,
+ *	$1mi, $1su) or axis mode ($xam) changes; the setters do this. Both tables are built
+ *	aside and copied in with interrupts off, so the exec and the forward kinematics never
+ *	see one table partly copied, or one table old and the other new.
+ */
+
+void kn_map_motors()
+{
+    knMotorMap_t map[MOTORS];
+    knJointMap_t joint_map[MOTORS];
+    uint8_t motors = 0;
+    uint8_t joint_motors = 0;
+    float best_steps_per_unit[AXES];
+    uint8_t best_count[AXES];
 
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) {
-            joint[axis] = 0;
+        best_steps_per_unit[axis] = -1.0;
+        best_count[axis] = 0;
+    }
+    for (uint8_t motor = 0; motor < MOTORS; motor++) {
+        uint8_t axis = st_cfg.mot[motor].motor_map;
+        if ((axis >= AXES) || (cm.a[axis].axis_mode == AXIS_INHIBITED)) {
             continue;
         }
-        for (uint8_t motor = 0; motor < MOTORS; motor++) {
-            if (st_cfg.mot[motor].motor_map == axis) {
-                steps[motor] = joint[axis] * st_cfg.mot[motor].steps_per_unit;
-            }
+        map[motors].motor = motor;
+        map[motors].joint = axis;
+        map[motors].steps_per_unit = st_cfg.mot[motor].steps_per_unit;
+        motors++;
+
+        if (fp_EQ(best_steps_per_unit[axis], st_cfg.mot[motor].steps_per_unit)) {
+            best_count[axis]++;
+        } else if (best_steps_per_unit[axis] < st_cfg.mot[motor].steps_per_unit) {
+            best_steps_per_unit[axis] = st_cfg.mot[motor].steps_per_unit;
+            best_count[axis] = 1;
         }
     }
-#endif
+    for (uint8_t i = 0; i < motors; i++) {
+        uint8_t axis = map[i].joint;
+        if (fp_EQ(best_steps_per_unit[axis], map[i].steps_per_unit)) {
+            joint_map[joint_motors].motor = map[i].motor;
+            joint_map[joint_motors].joint = axis;
+            joint_map[joint_motors].units_per_step = st_cfg.mot[map[i].motor].units_per_step / best_count[axis];
+            joint_motors++;
+        }
+    }
+
+    __disable_irq();                    // the exec runs the tables from an interrupt
+    memcpy(kn.map, map, sizeof(knMotorMap_t) * motors);
+    kn.motors = motors;
+    memcpy(kn.joint_map, joint_map, sizeof(knJointMap_t) * joint_motors);
+    kn.joint_motors = joint_motors;
+    kn.forward_valid = false;
+    __enable_irq();
 }
 
 /*
- * _inverse_kinematics() - inverse kinematics - example is for a cartesian machine
+ * kn_inverse_kinematics() - wrapper routine for inverse kinematics
  *
- *	You can glue in inverse kinematics here, but be aware of time budget constraints.
- *	This function is run during the _exec() portion of the cycle and will therefore
- *	be run once per interpolation segment. The total time for the segment load,
- *	including the inverse kinematics transformation cannot exceed the segment time,
- *	and ideally should be no more than 25-50% of the segment time. Currently segments
- *	run every 1.5 ms, but this might be lowered. To profile this time look at the
- *	time it takes to complete the mp_exec_move() function.
+ *	Calls kinematics function(s).
+ *	Performs axis mapping & conversion of length units to steps from the table built by
+ *	kn_map_motors(). Motors on inhibited axes are not in the table and keep their steps.
  *
- *	Note: the compiler will  inline trivial functions (like memcpy) so there is no
- *	size or performance penalty for breaking this out
+ *	The reason steps are returned as floats (as opposed to, say, uint32_t) is to accommodate
+ *	fractional DDA steps. The DDA deals with fractional step values as fixed-point binary in
+ *	order to get the smoothest possible operation. Steps are passed to the move prep routine
+ *	as floats and converted to fixed-point binary during queue loading. See stepper.c for details.
  */
-static void _inverse_kinematics(const float travel[], float joint[]) {
-    memcpy(joint, travel, sizeof(float) * AXES);  // just do a memcpy for Cartesian machines
 
-    //	for (uint8_t i=0; i<AXES; i++) {
-    //		joint[i] = travel[i];
-    //	}
+void kn_inverse_kinematics(const float travel[], float steps[]) {
+    PROF_START(prof_start);
+    float joint[AXES];
+
+    kn.inverse(travel, joint);          // the $kty module - see kn_configure()
+    for (uint8_t i = 0; i < kn.motors; i++) {   // map joints to motors - see kn_map_motors()
+        const knMotorMap_t *m = &kn.map[i];
+        steps[m->motor] = joint[m->joint] * m->steps_per_unit;
+    }
+    PROF_END(prof_start, PROF_KINEMATICS);
 }
 
 /*
- * kn_forward_kinematics() - forward kinematics for a cartesian machine
+ * kn_kinematics_are_linear() - true if a straight line in axis space is straight in joint space
  *
- * This is designed for PRECISION, not PERFORMANCE!
+ *	The exec uses this to decide if long segments are safe in constant velocity sections.
+ *	Cartesian and CoreXY machines are linear. Delta, SCARA and polar bend lines and return false.
+ */
+
+bool kn_kinematics_are_linear() { return (kn.linear); }
+
+/*
+ * kn_reach_is_limited() - true if the $kty module can't make some moves
+ * kn_move_is_reachable() - false if the $kty module can't make a straight move
  *
- * This function is NOT to be used where high-speed is important. If that becomes the case,
- * there are many opportunities for caching and optimization for performance here.
+ *	start[] and end[] are axis positions in absolute machine coordinates. The whole line
+ *	between them is tested, as the exec will run it - see kinematics.h.
+ */
+
+bool kn_reach_is_limited() { return (kn.reachable != NULL); }
+
+bool kn_move_is_reachable(const float start[], const float end[])
+{
+    if (kn.reachable == NULL) {
+        return (true);
+    }
+    return (kn.reachable(start, end));
+}
+
+/*
+ * kn_joint_lengths() - the most each joint moves along a straight block, if the module can say
  *
+ *	Returns false if the joints move in proportion to the axes (or the module doesn't bound
+ *	them), and the planner should use the axis lengths. Otherwise fills joint_length[] with
+ *	the peak joint rate along the block times one block - see _trunnion_joint_lengths().
+ *	start[] and length[] are the block's start and axis lengths in absolute machine coordinates.
  */
 
-void kn_forward_kinematics(const float steps[], float travel[]) {
-    float best_steps_per_unit[AXES];
+bool kn_joint_lengths(const float start[], const float length[], float joint_length[])
+{
+    if (kn.joint_lengths == NULL) {
+        return (false);
+    }
+    kn.joint_lengths(start, length, joint_length);
+    return (true);
+}
 
-    // Setup
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        travel[axis]              = 0.0;
-        best_steps_per_unit[axis] = -1.0;
+/*
+ * kn_center_split() - where to split a line that turns fast about the origin, if the module has one
+ *
+ *	SCARA and polar blocks are slowed to their peak turn about the origin (see
+ *	_center_joint_lengths()). A line that passes close to it would run all of its length
+ *	at the speed of its closest point, so it is queued in up to three pieces instead: the
+ *	part that turns more than a degree a mm - where r^2 < RADIAN * d - and the parts either
+ *	side, which turn less and run faster.
+ *
+ *	Fills split[] with the points to split at, in order, and returns how many (0 to 2).
+ *	Lines through the origin, or that start or end at it, aren't split.
+ */
+
+uint8_t kn_center_split(const float start[], const float end[], float split[][AXES])
+{
+    if (kn.center_joint >= AXES) {
+        return (0);
     }
+    const float dx = end[AXIS_X] - start[AXIS_X];
+    const float dy = end[AXIS_Y] - start[AXIS_Y];
+    const float length = hypotf(dx, dy);
+    if (length < EPSILON3) {
+        return (0);
+    }
+    const float offset = fabs(start[AXIS_X] * dy - start[AXIS_Y] * dx) / length;
+    if ((offset < EPSILON3) || (offset >= RADIAN)) {
+        return (0);
+    }
+    const float foot = -(start[AXIS_X] * dx + start[AXIS_Y] * dy) / square(length);  // closest, as a fraction
+    const float half = sqrt(offset * ((float)RADIAN - offset)) / length;
+    const float margin = EPSILON3 / length;
+    const float at[2] = { foot - half, foot + half };
+    uint8_t splits = 0;
+    for (uint8_t i = 0; i < 2; i++) {
+        const float t = at[i];
+        if ((t > margin) && (t < 1 - margin)) {
+            for (uint8_t axis = 0; axis < AXES; axis++) {
+                split[splits][axis] = start[axis] + (end[axis] - start[axis]) * t;
+            }
+            splits++;
+        }
+    }
+    return (splits);
+}
+
+/*
+ * kn_forward_kinematics() - forward kinematics
+ *
+ *	Steps are mapped back to joints through joint_map[] - the best resolution motor of each
+ *	joint, or the average of the motors that tie for it - and the $kty module turns joints
+ *	into axes. Axes with no motor, or an inhibited one, come back as zero.
+ *
+ *	The last steps, joints and axes are kept. A joint is only summed again if one of its
+ *	motors moved, and the module is only run if a joint changed, so polling the position
+ *	of a machine at rest is cheap. Only call this from the main loop - the cache isn't
+ *	protected from interrupts.
+ */
+
+void kn_forward_kinematics(const float steps[], float travel[]) {
+    bool joint_moved[AXES];
+    bool moved = !kn.forward_valid;
 
-    // Scan through each axis, and then through each motor
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (cm.a[axis].axis_mode == AXIS_INHIBITED) {
-            travel[axis] = 0.0;
-            continue;
+        joint_moved[axis] = moved;
+    }
+    for (uint8_t i = 0; i < kn.joint_motors; i++) {
+        const knJointMap_t *m = &kn.joint_map[i];
+        if (steps[m->motor] != kn.forward_steps[m->motor]) {
+            joint_moved[m->joint] = true;
+            moved = true;
         }
-        for (uint8_t motor = 0; motor < MOTORS; motor++) {
-            if (st_cfg.mot[motor].motor_map == axis) {
-                // If this motor has a better (or the only) resolution, then we use this motor's value
-                if (best_steps_per_unit[axis] < st_cfg.mot[motor].steps_per_unit) {
-                    best_steps_per_unit[axis] = st_cfg.mot[motor].steps_per_unit;
-                    travel[axis]              = steps[motor] * st_cfg.mot[motor].units_per_step;
-
-                    // If a econd motor has the same reolution for the same axis, we'll average their values
-                } else if (fp_EQ(best_steps_per_unit[axis], st_cfg.mot[motor].steps_per_unit)) {
-                    travel[axis] = (travel[axis] + (steps[motor] * st_cfg.mot[motor].units_per_step)) / 2.0;
-                }
+    }
+    if (moved) {
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            if (joint_moved[axis]) {
+                kn.forward_joint[axis] = 0;
             }
         }
+        for (uint8_t i = 0; i < kn.joint_motors; i++) {
+            const knJointMap_t *m = &kn.joint_map[i];
+            kn.forward_steps[m->motor] = steps[m->motor];
+            if (joint_moved[m->joint]) {
+                kn.forward_joint[m->joint] += steps[m->motor] * m->units_per_step;
+            }
+        }
+        kn.forward(kn.forward_joint, kn.forward_travel);
+        kn.forward_valid = true;
+    }
+    memcpy(travel, kn.forward_travel, sizeof(float) * AXES);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * _test_idle()     - refuse a change while the machine is in a cycle
+ * kn_set_kty()      - set the kinematics module
+ * kn_set_geometry() - set a delta or SCARA length
+ * kn_set_ktt()      - set the trunnion tilt axis
+ * kn_set_pivot()    - set a coordinate of the trunnion pivot
+ */
+
+static stat_t _test_idle(nvObj_t *nv)
+{
+    if (cm_get_machine_state() == MACHINE_CYCLE) {      // can't change the motor mapping under a move
+        nv->valuetype = TYPE_NULL;
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    return (STAT_OK);
+}
+
+stat_t kn_set_kty(nvObj_t *nv)
+{
+    if (nv->value < KINEMATICS_CARTESIAN) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value >= KINEMATICS_TYPES) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
     }
+    ritorno(_test_idle(nv));
+    ritorno(set_ui8(nv));
+    kn_configure();
+    mp_set_steps_to_runtime_position();
+    return (STAT_OK);
 }
+
+stat_t kn_set_geometry(nvObj_t *nv)
+{
+    if (nv->value <= 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    ritorno(_test_idle(nv));
+    ritorno(set_flu(nv));
+    kn_configure();
+    mp_set_steps_to_runtime_position();
+    return (STAT_OK);
+}
+
+stat_t kn_set_ktt(nvObj_t *nv)
+{
+    ritorno(_test_idle(nv));
+    ritorno(set_01(nv));
+    kn_configure();
+    mp_set_steps_to_runtime_position();
+    return (STAT_OK);
+}
+
+stat_t kn_set_pivot(nvObj_t *nv)
+{
+    ritorno(_test_idle(nv));
+    ritorno(set_flu(nv));
+    kn_configure();
+    mp_set_steps_to_runtime_position();
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char msg_units0[] = " in";    // used by generic print functions
+static const char msg_units1[] = " mm";
+static const char msg_units2[] = " deg";
+static const char *const msg_units[] = { msg_units0, msg_units1, msg_units2 };
+
+static const char fmt_kty[] = "[kty] kinematics%19d [0=cartesian,1=corexy,2=delta,3=scara,4=polar,5=trunnion]\n";
+static const char fmt_kdr[] = "[kdr] delta radius%17.3f%s\n";
+static const char fmt_kdl[] = "[kdl] delta rod length%13.3f%s\n";
+static const char fmt_ksp[] = "[ksp] scara proximal arm%11.3f%s\n";
+static const char fmt_ksd[] = "[ksd] scara distal arm%13.3f%s\n";
+static const char fmt_ktt[] = "[ktt] trunnion tilt axis%11d [0=A about X,1=B about Y]\n";
+static const char fmt_kpx[] = "[kpx] trunnion pivot X%13.3f%s\n";
+static const char fmt_kpy[] = "[kpy] trunnion pivot Y%13.3f%s\n";
+static const char fmt_kpz[] = "[kpz] trunnion pivot Z%13.3f%s\n";
+
+void kn_print_kty(nvObj_t *nv) { text_print(nv, fmt_kty);}     // TYPE_INT
+void kn_print_kdr(nvObj_t *nv) { text_print_flt_units(nv, fmt_kdr, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_kdl(nvObj_t *nv) { text_print_flt_units(nv, fmt_kdl, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_ksp(nvObj_t *nv) { text_print_flt_units(nv, fmt_ksp, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_ksd(nvObj_t *nv) { text_print_flt_units(nv, fmt_ksd, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_ktt(nvObj_t *nv) { text_print(nv, fmt_ktt);}     // TYPE_INT
+void kn_print_kpx(nvObj_t *nv) { text_print_flt_units(nv, fmt_kpx, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_kpy(nvObj_t *nv) { text_print_flt_units(nv, fmt_kpy, GET_UNITS(ACTIVE_MODEL));}
+void kn_print_kpz(nvObj_t *nv) { text_print_flt_units(nv, fmt_kpz, GET_UNITS(ACTIVE_MODEL));}
+
+#endif // __TEXT_MODE
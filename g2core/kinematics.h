@@ -1,5 +1,5 @@
 /*
- * kinematics.h - inverse kinematics routines
+ * kinematics.h - inverse and forward kinematics
  * This file is part of the g2core project
  *
  * Copyright (c) 2013 - 2016 Alden S. Hart, Jr.
@@ -25,14 +25,207 @@
  * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+/*
+ * KINEMATICS
+ *
+ *	Kinematics turn axis positions (the Cartesian travel the planner works in) into joint
+ *	positions, and the existing motor map turns joints into steps. Joints use the axis
+ *	slots, so a motor mapped to X drives joint X whatever that joint is. Axes a module
+ *	doesn't use are passed through unchanged.
+ *
+ *	Modules ($kty):
+ *
+ *	  0 = Cartesian   joint = axis
+ *	  1 = CoreXY      X = x+y, Y = x-y (belt travel of the A and B motors)
+ *	  2 = delta       X, Y, Z = carriage heights of towers A (210 deg), B (330 deg), C (90 deg)
+ *	                  $kdr is the horizontal distance from the tower carriages to the effector
+ *	                  center (effector and carriage offsets included), $kdl the diagonal rod length
+ *	  3 = SCARA       X = shoulder angle from the +X axis, Y = elbow angle relative to the
+ *	                  proximal arm, both in degrees (set the motor travel per revolution to 360).
+ *	                  $ksp and $ksd are the proximal and distal arm lengths
+ *	  4 = polar       X = radius, Y = bed angle in degrees
+ *	  5 = trunnion    5 axis table with tool centre point control (RTCP) - see below
+ *
+ *	The inverse transform runs once per segment in the exec interrupt. Cartesian and CoreXY
+ *	are a copy and an add. Delta is three square roots, SCARA and polar take atan2() and
+ *	acos() and are the most expensive - without an FPU (M3 boards) these are library calls
+ *	of several microseconds each. Measure with {profi:n} on the board or --kin on the
+ *	posix-sim before settling on a module. Delta, SCARA and polar bend straight lines in
+ *	joint space, so kn_kinematics_are_linear() returns false and the exec keeps bodies at
+ *	NOM_SEGMENT_MS rather than stretching them.
+ *
+ *	Moves a module can't make are refused by cm_test_soft_limits() (lines) and cm_arc_feed()
+ *	(arcs, chord by chord at the chordal tolerance $ct) before they are queued - the exec
+ *	never has to clamp a joint. The refusal is STAT_KINEMATICS_MOVE_UNREACHABLE, an error
+ *	like any other bad target and not an alarm. kn_move_is_reachable() tests the whole
+ *	line, not just its end, against the module's limits:
+ *
+ *	  - delta     both ends inside every tower's rod reach. Each reach is a disk in XY, so
+ *	              a line between two points inside all of them stays inside
+ *	  - SCARA     both ends inside the outer reach ($ksp + $ksd, also a disk), and the
+ *	              closest approach of the line to the shoulder not inside |$ksp - $ksd|
+ *	  - SCARA and polar: a line through the origin (the shoulder or the bed) is refused -
+ *	              the joint would turn half a turn in no distance. Split it at the origin,
+ *	              or go around. Lines may start or end there
+ *
+ *	The line starts at the model position, which is only where the machine powered up until
+ *	it is homed. So moves are tested once X and Y are homed (G28.2, or set with G28.3), and
+ *	the homing cycle's own moves never are (see cm_reach_is_tested()) - a SCARA or polar
+ *	machine homes from wherever it is, the origin included, and its search may run past
+ *	the reach.
+ *
+ *	SCARA and polar lines near the origin are slowed instead. Along a line d from the
+ *	origin the joint turns v d / r^2 radians a unit of time at radius r, far faster than
+ *	the tool moves as r gets small. Each block is slowed so the turn in degrees stays inside
+ *	the turning axis' rate limit ($xvm and $xfr for the SCARA shoulder, $yvm and $yfr for
+ *	the polar bed - see kn_joint_lengths()), and a line that passes closer than a radian
+ *	(57.3 mm) is queued in pieces so only the part near the origin is slow
+ *	(kn_center_split()). That part still runs at the speed of its closest point: a line
+ *	0.01 mm from the origin takes seconds to cross it.
+ *
+ *	Velocity, jerk and travel limits otherwise apply to the axes, not the joints, except
+ *	as described for the trunnion.
+ *
+ *	Trunnion (RTCP): the part sits on a rotary table (C) carried by a tilting trunnion - A
+ *	about X, or B about Y if $ktt is 1. Gcode X, Y and Z are in the part's frame, as if
+ *	the rotaries were at zero, so a CAM post doesn't have to linearize 5 axis moves: the
+ *	machine X, Y and Z are
+ *
+ *	    machine = pivot + tilt(a or b) * rotate(c) * (part - pivot)
+ *
+ *	with right-handed rotations and the pivot ($kpx, $kpy, $kpz, machine coordinates) where
+ *	the tilt and rotary axes cross - the axes are assumed to intersect. The rotary joints
+ *	are the Gcode angles. The exec interpolates the part coordinates and the angles together
+ *	and transforms every segment, so the tool centre point follows the programmed line on
+ *	the part while the table turns under it. Feed rate is tool speed over the part.
+ *	Turning the table swings the part, so the machine axes can move much faster than the
+ *	programmed feed. kn_joint_lengths() gives the planner the most any machine axis moves
+ *	per unit of the block (the Jacobian of the transform along the block, sampled every
+ *	few degrees of rotation) and _calculate_vmaxes() slows the block so every machine axis
+ *	stays inside its velocity limit. Jerk is still planned in the part's frame.
+ *
+ *	Joints are mapped to motors through a table kept by kn_map_motors(), so the exec does
+ *	one multiply per motor instead of searching the motor and axis configs each segment.
+ *	kn_forward_kinematics() has its own table of the best resolution motors of each joint,
+ *	and caches its last result: only joints whose motors moved are recomputed, and the
+ *	module's forward transform is skipped if none did. Repeated calls on a machine at rest
+ *	cost a compare per motor.
+ *
+ *	Changing $kty or the geometry is refused during a cycle. It keeps the axis position and
+ *	resets the step counts to match it, so the machine should be homed again.
+ *
+ *	The settings are the kin group ({kin:n} or $kin in text mode), not sys, which has no
+ *	room left for them in one NV list (see get_grp()).
+ */
+
 #ifndef KINEMATICS_H_ONCE
 #define KINEMATICS_H_ONCE
 
-/*
- * Global Scope Functions
- */
+/**** Configs and Constants ****/
+
+typedef enum {
+    KINEMATICS_CARTESIAN = 0,               // joint = axis
+    KINEMATICS_COREXY,                      // X and Y motors on crossed belts
+    KINEMATICS_DELTA,                       // linear delta, 3 vertical towers
+    KINEMATICS_SCARA,                       // 2 link arm in the XY plane
+    KINEMATICS_POLAR,                       // radial arm over a rotating bed
+    KINEMATICS_TRUNNION,                    // 5 axis tilting rotary table with RTCP
+    KINEMATICS_TYPES                        // count of kinematics modules
+} knType;
+
+/**** Structures ****/
+
+typedef struct knMotorMap {                 // one motor that takes steps - see kn_map_motors()
+    uint8_t motor;                          // motor index
+    uint8_t joint;                          // joint (axis slot) the motor drives
+    float steps_per_unit;                   // from st_cfg.mot[motor]
+} knMotorMap_t;
+
+typedef struct knJointMap {                 // one motor that positions a joint - see kn_map_motors()
+    uint8_t motor;                          // motor index
+    uint8_t joint;                          // joint (axis slot) the motor positions
+    float units_per_step;                   // from st_cfg.mot[motor], divided among equal motors
+} knJointMap_t;
+
+typedef struct knKinematics {
+    // configuration
+    uint8_t type;                           // knType - $kty
+    float delta_radius;                     // $kdr
+    float delta_rod_length;                 // $kdl
+    float scara_proximal;                   // $ksp
+    float scara_distal;                     // $ksd
+    uint8_t trunnion_tilt;                  // $ktt - 0 = A about X, 1 = B about Y
+    float pivot[3];                         // $kpx, $kpy, $kpz - where the trunnion axes cross
+
+    // derived from the configuration - see kn_configure()
+    void (*inverse)(const float travel[], float joint[]);   // bound module functions
+    void (*forward)(const float joint[], float travel[]);
+    bool (*reachable)(const float start[], const float end[]);    // or NULL if all moves are
+    void (*joint_lengths)(const float start[], const float length[], float joint_length[]);    // or NULL
+    uint8_t center_joint;                   // SCARA and polar joint that turns about the origin, or AXES
+    bool linear;                            // straight axis lines are straight joint lines
+    float tower_x[3];                       // delta tower positions
+    float tower_y[3];
+    float rod_sq;                           // delta rod length squared
+    float reach_min;                        // SCARA reach limits
+    float reach_max;
+
+    uint8_t motors;                         // entries in map[]
+    knMotorMap_t map[MOTORS];               // motors on joints that aren't inhibited
+    uint8_t joint_motors;                   // entries in joint_map[]
+    knJointMap_t joint_map[MOTORS];         // the best resolution motors of each joint
 
+    // runtime
+    float angle[2];                         // last joint angles, to unwrap atan2() across +/-180 deg
+    bool forward_valid;                     // the forward cache below is for the current config
+    float forward_steps[MOTORS];            // steps, joints and axes of the last forward transform
+    float forward_joint[AXES];
+    float forward_travel[AXES];
+} knKinematics_t;
+
+extern knKinematics_t kn;
+
+/**** FUNCTION PROTOTYPES ****/
+
+void kn_configure(void);
+void kn_map_motors(void);
 void kn_inverse_kinematics(const float travel[], float steps[]);
 void kn_forward_kinematics(const float steps[], float travel[]);
+bool kn_kinematics_are_linear(void);
+bool kn_reach_is_limited(void);
+bool kn_move_is_reachable(const float start[], const float end[]);
+bool kn_joint_lengths(const float start[], const float length[], float joint_length[]);
+uint8_t kn_center_split(const float start[], const float end[], float split[][AXES]);
+
+stat_t kn_set_kty(nvObj_t *nv);
+stat_t kn_set_geometry(nvObj_t *nv);
+stat_t kn_set_ktt(nvObj_t *nv);
+stat_t kn_set_pivot(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void kn_print_kty(nvObj_t *nv);
+    void kn_print_kdr(nvObj_t *nv);
+    void kn_print_kdl(nvObj_t *nv);
+    void kn_print_ksp(nvObj_t *nv);
+    void kn_print_ksd(nvObj_t *nv);
+    void kn_print_ktt(nvObj_t *nv);
+    void kn_print_kpx(nvObj_t *nv);
+    void kn_print_kpy(nvObj_t *nv);
+    void kn_print_kpz(nvObj_t *nv);
+
+#else
+
+    #define kn_print_kty tx_print_stub
+    #define kn_print_kdr tx_print_stub
+    #define kn_print_kdl tx_print_stub
+    #define kn_print_ksp tx_print_stub
+    #define kn_print_ksd tx_print_stub
+    #define kn_print_ktt tx_print_stub
+    #define kn_print_kpx tx_print_stub
+    #define kn_print_kpy tx_print_stub
+    #define kn_print_kpz tx_print_stub
+
+#endif // __TEXT_MODE
 
 #endif  // End of include Guard: KINEMATICS_H_ONCE
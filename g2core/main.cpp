@@ -29,8 +29,11 @@
 #include "json_parser.h"			// required for unit tests only
 #include "report.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "stepper.h"
 #include "encoder.h"
+#include "step_trace.h"
+#include "profiler.h"
 #include "spindle.h"
 #include "temperature.h"
 #include "gpio.h"
@@ -102,8 +105,11 @@ void application_init_machine(void)
 {
     cm.machine_state = MACHINE_INITIALIZING;
 
+    kn_configure();                 // kinematics - Cartesian until config_init() applies $kty
     stepper_init();                 // stepper subsystem
     encoder_init();                 // virtual encoders
+    st_trace_init();                // step pulse trace recorder
+    prof_init();                    // hot path profiler
     gpio_init();                    // inputs and outputs
     pwm_init();                     // pulse width modulation drivers
     planner_init();                 // motion planning subsystem
@@ -156,7 +162,9 @@ void loop() {
  * Traps for debugging. These must be in main.cpp for proper linker ordering
  */
 
+#ifndef __POSIX_SIM__
 void MemManage_Handler  ( void ) { __asm__("BKPT"); }
 void BusFault_Handler   ( void ) { __asm__("BKPT"); }
 void UsageFault_Handler ( void ) { __asm__("BKPT"); }
 void HardFault_Handler  ( void ) { __asm__("BKPT"); }
+#endif
@@ -22,6 +22,7 @@
 #include "canonical_machine.h"
 #include "plan_arc.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "util.h"
 
 // Allocate arc planner singleton structure
@@ -31,9 +32,14 @@ arc_t arc;
 // Local functions
 
 static stat_t _compute_arc(const bool radius_f);
+static void _compute_arc_segments(void);
 static void _compute_arc_offsets_from_radius(void);
-static float _estimate_arc_time (float arc_time);
+static bool _arc_is_native(void);
+static void _queue_native_arc(void);
+static float _estimate_arc_time(void);
+static float _get_arc_segment_length(void);
 static stat_t _test_arc_soft_limits(void);
+static stat_t _test_arc_reach(void);
 
 /*****************************************************************************
  * Canonical Machining arc functions (arc prep for planning and runtime)
@@ -82,8 +88,15 @@ stat_t cm_arc_callback()
         return (STAT_EAGAIN);
     }
     arc.theta += arc.segment_theta;
-    arc.gm.target[arc.plane_axis_0] = arc.center_0 + sin(arc.theta) * arc.radius;
-    arc.gm.target[arc.plane_axis_1] = arc.center_1 + cos(arc.theta) * arc.radius;
+    if ((--arc.resync_count == 0) || (arc.segment_count == 1)) {
+        arc.resync_count = ARC_RESYNC_SEGMENTS;
+        arc.vector_0 = sin(arc.theta) * arc.radius;
+        arc.vector_1 = cos(arc.theta) * arc.radius;
+    } else {
+        arc_rotate(arc.vector_0, arc.vector_1, arc.sin_step, arc.cos_step);
+    }
+    arc.gm.target[arc.plane_axis_0] = arc.center_0 + arc.vector_0;
+    arc.gm.target[arc.plane_axis_1] = arc.center_1 + arc.vector_1;
     arc.gm.target[arc.linear_axis] += arc.segment_linear_travel;
 
     mp_aline(&arc.gm);                              // run the line
@@ -99,8 +112,9 @@ stat_t cm_arc_callback()
 /*
  * cm_arc_feed() - canonical machine entry point for arcs
  *
- * Generates an arc by queuing line segments to the move buffer. The arc is
- * approximated by generating a large number of tiny, linear segments.
+ * Queues the arc to the planner as a single arc block (see mp_arc()), or if it can't
+ * run natively generates the arc by queuing line segments to the move buffer. The arc is
+ * then approximated by generating a large number of tiny, linear segments.
  */
 
 stat_t cm_arc_feed(const float target[], const bool target_f[],     // target endpoint
@@ -257,7 +271,12 @@ stat_t cm_arc_feed(const float target[], const bool target_f[],     // target en
     }
 
     cm_cycle_start();                                   // if not already started
-    arc.run_state = BLOCK_ACTIVE;                       // enable arc to be run from the callback
+    if (_arc_is_native()) {
+        _queue_native_arc();                            // queue the whole arc as one block
+    } else {
+        _compute_arc_segments();
+        arc.run_state = BLOCK_ACTIVE;                   // enable arc to be run from the callback
+    }
     cm_finalize_move();
     return (STAT_OK);
 }
@@ -339,13 +358,20 @@ static stat_t _compute_arc(const bool radius_f)
     arc.linear_travel = arc.gm.target[arc.linear_axis] - arc.position[arc.linear_axis];
     arc.planar_travel = arc.angular_travel * arc.radius;
     arc.length = hypotf(arc.planar_travel, fabs(arc.linear_travel));
+    arc.center_0 = arc.position[arc.plane_axis_0] - sin(arc.theta) * arc.radius;
+    arc.center_1 = arc.position[arc.plane_axis_1] - cos(arc.theta) * arc.radius;
+    return (STAT_OK);
+}
+
+/*
+ * _compute_arc_segments() - set up an arc to be chopped into lines by cm_arc_callback()
+ */
 
-    // Find the minimum number of segments that meet accuracy and time constraints...
+static void _compute_arc_segments()
+{
+    // Find the number of segments that meets accuracy, velocity and time constraints...
     // Note: removed segment_length test as segment_time accounts for this (build 083.37)
-    float arc_time;
-    float segments_for_minimum_time = _estimate_arc_time(arc_time) * (MICROSECONDS_PER_MINUTE / MIN_ARC_SEGMENT_USEC);
-    float segments_for_chordal_accuracy = arc.length / sqrt(4*cm.chordal_tolerance * (2 * arc.radius - cm.chordal_tolerance));
-    arc.segments = floor(min(segments_for_chordal_accuracy, segments_for_minimum_time));
+    arc.segments = floor(arc.length / _get_arc_segment_length());
     arc.segments = max(arc.segments, (float)1.0);        //...but is at least 1 segment
 
     if (arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {
@@ -355,10 +381,67 @@ static stat_t _compute_arc(const bool radius_f)
     arc.segment_count = (int32_t)arc.segments;
     arc.segment_theta = arc.angular_travel / arc.segments;
     arc.segment_linear_travel = arc.linear_travel / arc.segments;
-    arc.center_0 = arc.position[arc.plane_axis_0] - sin(arc.theta) * arc.radius;
-    arc.center_1 = arc.position[arc.plane_axis_1] - cos(arc.theta) * arc.radius;
+    arc.sin_step = sin(arc.segment_theta);              // see Incremental arc interpolation in plan_arc.h
+    arc.cos_step = cos(arc.segment_theta);
+    arc.vector_0 = sin(arc.theta) * arc.radius;
+    arc.vector_1 = cos(arc.theta) * arc.radius;
+    arc.resync_count = ARC_RESYNC_SEGMENTS;
     arc.gm.target[arc.linear_axis] = arc.position[arc.linear_axis];    // initialize the linear target
-    return (STAT_OK);
+}
+
+/*
+ * _arc_is_native() - return true if the arc can be queued as a single arc block
+ *
+ *  The planner runs arcs natively (see mp_arc()) unless NATIVE_ARCS_ENABLED is false, the
+ *  arc also moves an axis other than its plane and linear axes, or a coordinate rotation
+ *  is in effect (see cm_set_tram()) - which would tip the arc out of its plane. Anything
+ *  else is chopped into lines by cm_arc_callback().
+ */
+
+static bool _arc_is_native()
+{
+#if (NATIVE_ARCS_ENABLED == true)
+    if (!cm_rotation_is_identity()) {
+        return (false);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        if ((axis != arc.plane_axis_0) && (axis != arc.plane_axis_1) && (axis != arc.linear_axis) &&
+            (fp_NE(arc.gm.target[axis], arc.position[axis]))) {
+            return (false);
+        }
+    }
+    return (true);
+#else
+    return (false);
+#endif
+}
+
+/*
+ * _queue_native_arc() - queue the arc to the planner as a single block
+ *
+ *  The arc ends where the arc equations put it - as the last chopped segment would -
+ *  which is within the radius tolerance of the programmed endpoint.
+ */
+
+static void _queue_native_arc()
+{
+    mpArcGeometry_t geometry = mpArcGeometry_t();
+    geometry.plane_axis_0 = arc.plane_axis_0;
+    geometry.plane_axis_1 = arc.plane_axis_1;
+    geometry.linear_axis = arc.linear_axis;
+    geometry.center_0 = arc.center_0;
+    geometry.center_1 = arc.center_1;
+    geometry.radius = arc.radius;
+    geometry.theta = arc.theta;
+    geometry.angular_travel = arc.angular_travel;
+    geometry.linear_start = arc.position[arc.linear_axis];
+    geometry.linear_travel = arc.linear_travel;
+
+    float theta_end = arc.theta + arc.angular_travel;
+    arc.gm.target[arc.plane_axis_0] = arc.center_0 + sin(theta_end) * arc.radius;
+    arc.gm.target[arc.plane_axis_1] = arc.center_1 + cos(theta_end) * arc.radius;
+    TRAJECTORY_PATH(arc.position, arc.gm.target, &geometry, 0);
+    mp_arc(&arc.gm, &geometry);
 }
 
 /*
@@ -478,7 +561,7 @@ static void _compute_arc_offsets_from_radius()
 }
 
 /*
- * _estimate_arc_time ()
+ * _estimate_arc_time()
  *
  *  Returns a naiive estimate of arc execution time to inform segment calculation.
  *  The arc time is computed not to exceed the time taken in the slowest dimension
@@ -487,9 +570,10 @@ static void _compute_arc_offsets_from_radius()
  *  where the unit vector is 1 in that dimension. This is not true for any arbitrary arc,
  *  with the result that the time returned may be less than optimal.
  */
-static float _estimate_arc_time (float arc_time)
+static float _estimate_arc_time()
 {
     // Determine move time at requested feed rate
+    float arc_time;
     if (arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {
         arc_time = arc.gm.feed_rate;    // inverse feed rate has been normalized to minutes
     } else {
@@ -505,6 +589,43 @@ static float _estimate_arc_time (float arc_time)
     return (arc_time);
 }
 
+/*
+ * _get_arc_segment_length() - length of the lines the arc is chopped into
+ *
+ *  See Arc segmentation in plan_arc.h. Working in the arc's velocity v from _estimate_arc_time():
+ *
+ *    - A chord of length s turns the path by s/r, so the junction between two chords allows
+ *      max_junction_accel * r / s (see _calculate_junction_vmax()). Chords no longer than
+ *      junction_length let the arc run at v.
+ *    - A jerk-limited stop from v covers v * sqrt(v/J), which the usable planner buffers must
+ *      hold. J is the lower jerk of the plane axes.
+ *    - Each segment must run at least MIN_ARC_SEGMENT_USEC.
+ *
+ *  If the last two (the floor) allow a chord no longer than junction_length the arc runs at v
+ *  with the longest chord the tolerance allows. Otherwise no chord length reaches v, and the
+ *  fastest is the one where the junction velocity meets the floor velocity - solving
+ *  a*r/s = s/t and a*r/s = (B*s)^(2/3) * J^(1/3) for s and taking the longer, with a the
+ *  max_junction_accel, t the minimum segment time and B the usable planner buffers.
+ */
+static float _get_arc_segment_length()
+{
+    float velocity = arc.length / _estimate_arc_time();
+    float buffers = PLANNER_BUFFER_POOL_SIZE - PLANNER_BUFFER_HEADROOM;
+    float jerk = min(cm.a[arc.plane_axis_0].jerk_max, cm.a[arc.plane_axis_1].jerk_max) * JERK_MULTIPLIER;
+    float junction_accel = min(cm.a[arc.plane_axis_0].max_junction_accel, cm.a[arc.plane_axis_1].max_junction_accel);
+    float segment_time = MIN_ARC_SEGMENT_USEC / MICROSECONDS_PER_MINUTE;
+
+    float tolerance_length = sqrt(4*cm.chordal_tolerance * (2 * arc.radius - cm.chordal_tolerance));
+    float junction_length = junction_accel * arc.radius / velocity;
+    float floor_length = max(velocity * segment_time, velocity * sqrt(velocity / jerk) / buffers);
+
+    if (floor_length <= junction_length) {
+        return (max(min(tolerance_length, junction_length), floor_length));
+    }
+    return (max(sqrt(junction_accel * arc.radius * segment_time),
+                pow(junction_accel * arc.radius, (float)0.6) / (pow(buffers, (float)0.4) * pow(jerk, (float)0.2))));
+}
+
 /*
  * _test_arc_soft_limits() - return error code if soft limit is exceeded
  *
@@ -590,5 +711,43 @@ static stat_t _test_arc_soft_limits()
         ritorno(_test_arc_soft_limit_plane_axis(arc.center_1, arc.plane_axis_1));
     }
 */
-    return(STAT_OK);
+    return(_test_arc_reach());
+}
+
+/*
+ * _test_arc_reach() - refuse an arc the kinematics can't make (see kinematics.h)
+ *
+ *  Like lines this is tested whether or not soft limits are enabled, once the reach is known
+ *  (see cm_reach_is_tested()). The arc is tested as chords that stray no more than the
+ *  chordal tolerance ($ct) from it - the tolerance the arc is cut to anyway - so the test
+ *  is that close to the arc itself.
+ */
+
+static stat_t _test_arc_reach()
+{
+    if (!cm_reach_is_tested()) {
+        return (STAT_OK);
+    }
+    const float tolerance = min(cm.chordal_tolerance, arc.radius);
+    const float chord_theta = 2 * acos(1 - tolerance / arc.radius);
+    const uint32_t chords = max((uint32_t)ceil(fabs(arc.angular_travel) / chord_theta), (uint32_t)1);
+
+    float start[AXES];
+    float end[AXES];
+    copy_vector(start, arc.position);
+    copy_vector(end, arc.position);
+    for (uint32_t i = 1; i < chords; i++) {
+        const float theta = arc.theta + arc.angular_travel * i / chords;
+        end[arc.plane_axis_0] = arc.center_0 + sin(theta) * arc.radius;
+        end[arc.plane_axis_1] = arc.center_1 + cos(theta) * arc.radius;
+        end[arc.linear_axis] = arc.position[arc.linear_axis] + arc.linear_travel * i / chords;
+        if (!kn_move_is_reachable(start, end)) {
+            return (STAT_KINEMATICS_MOVE_UNREACHABLE);
+        }
+        copy_vector(start, end);
+    }
+    if (!kn_move_is_reachable(start, arc.gm.target)) {
+        return (STAT_KINEMATICS_MOVE_UNREACHABLE);
+    }
+    return (STAT_OK);
 }
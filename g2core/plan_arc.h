@@ -22,7 +22,40 @@
 
 #define MIN_ARC_RADIUS ((float)0.1)             // min radius that can be executed
 #define MIN_ARC_SEGMENT_LENGTH ((float)0.05)    // Arc segment size (mm).(0.03)
-#define MIN_ARC_SEGMENT_USEC ((float)10000)     // minimum arc segment time
+#define MIN_ARC_SEGMENT_USEC ((float)10000)     // minimum arc segment time (see Arc segmentation)
+
+/* Arc segmentation
+ *
+ *  Arcs that are chopped into lines (see _arc_is_native()) pick their segment length from
+ *  the feed rate, the machine's jerk and junction settings and the planner pool, as well as
+ *  the chordal tolerance:
+ *    - Every chord corner is a junction, and the junction velocity falls as the chords get
+ *      longer, so segments are kept short enough not to hold the arc below its feed rate.
+ *    - Segments must be at least MIN_ARC_SEGMENT_USEC long, so the main loop generates and
+ *      plans them well ahead of the runtime.
+ *    - Look-ahead sees no further than the queue, so the segments that fit in the planner
+ *      pool must add up to the machine's stopping distance, or it slows down on the arc.
+ *  Within those the segments are as long as the chordal tolerance allows, so tight-tolerance
+ *  arcs at high feed merge segments past the tolerance only as far as the last two need. If
+ *  the feed rate can't be reached at any length, the length that allows the highest velocity
+ *  is used. See _get_arc_segment_length() for the details.
+ */
+
+/* Incremental arc interpolation
+ *
+ *  Arc points are generated by rotating the radius vector - from the center of the arc to
+ *  the current point, on plane axes 0 and 1 - through each segment's angle rather than by
+ *  calling sin() and cos() for every segment. The rotation is exact when the angle is the
+ *  same for every segment (cm_arc_callback() takes its sin and cos once per arc), and uses
+ *  the third order small angle approximations of sin and cos when it is not (native arcs,
+ *  see plan_exec.cpp). Either way the rounding error grows with each step, so every
+ *  ARC_RESYNC_SEGMENTS segments - and on the last segment - the point is recomputed exactly.
+ */
+#define ARC_RESYNC_SEGMENTS 12                  // segments between exact sin/cos resyncs
+
+#ifndef NATIVE_ARCS_ENABLED
+#define NATIVE_ARCS_ENABLED true                // queue arcs as single blocks (see mp_arc()). false chops them into lines
+#endif
 
 // Arc radius tests. See http://linuxcnc.org/docs/html/gcode/gcode.html#sec:G2-G3-Arc
 //#define ARC_RADIUS_ERROR_MAX ((float)0.5)     // max allowable mm between start and end radius
@@ -54,6 +87,11 @@ typedef struct arArcSingleton {                 // persistent planner and runtim
     int32_t segment_count;          // count of running segments
     float   segment_theta;          // angular motion per segment
     float   segment_linear_travel;  // linear motion per segment
+    float   sin_step;               // sin and cos of segment_theta
+    float   cos_step;
+    float   vector_0;               // radius vector from the center to the current point
+    float   vector_1;
+    uint8_t resync_count;           // segments until the next exact resync
     float   center_0;               // center of circle at plane axis 0 (e.g. X for G17)
     float   center_1;               // center of circle at plane axis 1 (e.g. Y for G17)
 
@@ -70,6 +108,21 @@ extern arc_t arc;
 
 /* arc function prototypes */
 
+// rotate the radius vector (vector_0, vector_1) clockwise by an angle given by its sin and cos
+inline void arc_rotate(float &vector_0, float &vector_1, const float sin_step, const float cos_step)
+{
+    const float v_0 = vector_0;
+    vector_0 = v_0 * cos_step + vector_1 * sin_step;
+    vector_1 = vector_1 * cos_step - v_0 * sin_step;
+}
+
+// ...or by a small angle in radians
+inline void arc_rotate_small(float &vector_0, float &vector_1, const float step)
+{
+    const float step_sq = step * step;
+    arc_rotate(vector_0, vector_1, step * (1 - step_sq * (float)(1.0/6.0)), 1 - step_sq * (float)0.5);
+}
+
 void   cm_arc_init(void);
 void   cm_abort_arc(void);
 stat_t cm_arc_callback(void);
@@ -30,12 +30,14 @@
 #include "config.h"
 #include "controller.h"
 #include "planner.h"
+#include "plan_arc.h"
 #include "kinematics.h"
 #include "stepper.h"
 #include "encoder.h"
 #include "report.h"
 #include "util.h"
 #include "spindle.h"
+#include "profiler.h"
 #include "xio.h"    //+++++DIAGNOSTIC
 
 // execute routines (NB: These are all called from the LO interrupt)
@@ -43,8 +45,16 @@ static stat_t _exec_aline_head(mpBuf_t *bf); // passing bf because body might ne
 static stat_t _exec_aline_body(mpBuf_t *bf); // passing bf so that body can extend itself if the exit velocity rises.
 static stat_t _exec_aline_tail(mpBuf_t *bf);
 static stat_t _exec_aline_segment(void);
+static void _get_arc_point(const float distance, float point[]);
+static void _advance_arc_point(const float step, float point[]);
+static void _set_arc_waypoints(void);
+static float _get_remaining_length(void);
 
 static void _init_forward_diffs(float v_0, float v_1);
+static void _init_scurve(const float v_0, const float v_1, const float dv_plateau);
+static void _next_ramp_velocity(void);
+static void _set_section_segments(const float section_time, const float max_segment_usec, const float velocity_change);
+static void _load_runtime_model(const mpMotionState_t *ms);
 
 /*******************************************************************************
  * mp_forward_plan() - plan commands and moves ahead of exec; call ramping for moves
@@ -216,17 +226,17 @@ stat_t mp_forward_plan()
     }
 
     // bf points to command; start cases 1f, 1g, 1h, 1i, 1j, 1k, 2c, 2d, 2e, 2h, 2i, 2j
-    if (bf->block_type != BLOCK_TYPE_ALINE) {       // meaning it's a COMMAND
+    if (!mp_block_is_move(bf)) {                    // meaning it's a COMMAND
         bf = _plan_commands(bf);                    // plan commands or skip past already planned commands
         // bf now points to the first non-command buffer past the command(s)
-        if ((bf->block_type == BLOCK_TYPE_ALINE) && (bf->buffer_state > MP_BUFFER_PREPPED )) { // case 1i
+        if (mp_block_is_move(bf) && (bf->buffer_state > MP_BUFFER_PREPPED )) { // case 1i
             entry_velocity = mr.r->exit_velocity;   // set entry_velocity for Note 1a
         }        
     } 
     // bf will always be on a non-command at this point - either a move or empty buffer
 
     // process move                           
-    if (bf->block_type == BLOCK_TYPE_ALINE) {       // do cases 1a - 1e; finish cases 1f - 1k
+    if (mp_block_is_move(bf)) {                     // do cases 1a - 1e; finish cases 1f - 1k
         if (bf->buffer_state == MP_BUFFER_PREPPED) {// do 1a; finish 1f, 1j, 2d, 2i
             return (_plan_move(bf, entry_velocity));
         } else {
@@ -253,7 +263,7 @@ stat_t mp_exec_move()
         return (STAT_NOOP);
     }
 
-    if (bf->block_type == BLOCK_TYPE_ALINE) {             // cycle auto-start for lines only
+    if (mp_block_is_move(bf)) {                           // cycle auto-start for lines and arcs only
 
         // first-time operations
         if (bf->buffer_state != MP_BUFFER_RUNNING) {
@@ -273,6 +283,7 @@ stat_t mp_exec_move()
 
             if (bf->buffer_state == MP_BUFFER_PREPPED) {
                 if (cm.motion_state == MOTION_RUN) {
+                    BENCH_COUNT(starvations);
 #if IN_DEBUGGER == 1
 //                    __asm__("BKPT"); // we are running but don't have a block planned
 #endif
@@ -359,7 +370,7 @@ stat_t mp_exec_move()
  *  Important distinction to note:
  *    - mp_plan move() is called for every type of move
  *    - mp_exec_move() is called for every type of move
- *    - mp_exec_aline() is only called for alines
+ *    - mp_exec_aline() is only called for alines and arcs (arcs interpolate in _exec_aline_segment())
  */
 /* Synchronization of run BUFFER and run BLOCK
  *
@@ -398,6 +409,27 @@ stat_t mp_exec_move()
  **
  **** NOTICE ** NOTICE ** NOTICE ****/
 
+/*
+ * _load_runtime_model() - set mr.gm from a block's state and its Gcode state table entry
+ */
+static void _load_runtime_model(const mpMotionState_t *ms)
+{
+    if (ms->modal != mr.modal_seq) {            // the rest of the model changed - see Gcode state table
+        mr.gm = mp.modal[ms->modal % PLANNER_MODAL_STATES];
+        mr.modal_seq = ms->modal;
+    }
+    mr.gm.linenum = ms->linenum;
+    mr.gm.motion_mode = ms->motion_mode;
+    copy_vector(mr.gm.target, ms->target);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        mr.gm.target_comp[axis] = 0;
+    }
+    mr.gm.feed_rate = ms->feed_rate;
+    mr.gm.feed_rate_mode = ms->feed_rate_mode;
+    mr.gm.path_control = ms->path_control;
+    mr.gm.tool = ms->tool;
+}
+
 stat_t mp_exec_aline(mpBuf_t *bf)
 {
     if (bf->block_state == BLOCK_INACTIVE) {
@@ -415,7 +447,8 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         }
 
         // Start a new move by setting up the runtime singleton (mr)
-        memcpy(&mr.gm, &(bf->gm), sizeof(GCodeState_t)); // copy in the gcode model state
+        _load_runtime_model(bf->gm);                     // copy in the gcode model state
+        mr.ramp_profile = bf->ramp_profile;
         bf->block_state = BLOCK_ACTIVE;                  // note that this buffer is running
                                                          // note the planner doesn't look at block_state
         mr.block_state = BLOCK_INITIAL_ACTION;
@@ -497,15 +530,24 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         }
 
         copy_vector(mr.unit, bf->unit);
-        copy_vector(mr.target, bf->gm.target);          // save the final target of the move
+        copy_vector(mr.target, bf->gm->target);         // save the final target of the move
         copy_vector(mr.axis_flags, bf->axis_flags);
+        mr.block_type = bf->block_type;
 
         // generate the way points for position correction at section ends
-        for (uint8_t axis=0; axis<AXES; axis++) {
-            mr.waypoint[SECTION_HEAD][axis] = mr.position[axis] + mr.unit[axis] * mr.r->head_length;
-            mr.waypoint[SECTION_BODY][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length);
-            mr.waypoint[SECTION_TAIL][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length + mr.r->tail_length);
+        if (mr.block_type == BLOCK_TYPE_ARC) {
+            mr.arc = *bf->arc;
+            mr.distance = mr.arc.offset;                // non-zero if restarting after a feedhold
+            mr.arc_resync_count = 1;                    // start from an exact point
+            _set_arc_waypoints();
+        } else {
+            for (uint8_t axis=0; axis<AXES; axis++) {
+                mr.waypoint[SECTION_HEAD][axis] = mr.position[axis] + mr.unit[axis] * mr.r->head_length;
+                mr.waypoint[SECTION_BODY][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length);
+                mr.waypoint[SECTION_TAIL][axis] = mr.position[axis] + mr.unit[axis] * (mr.r->head_length + mr.r->body_length + mr.r->tail_length);
+            }
         }
+        TRAJECTORY_BLOCK(bf);
     }
 
     // Feed Override Processing - We need to handle the following cases (listed in rough sequence order):
@@ -554,7 +596,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         if (cm.hold_state == FEEDHOLD_DECEL_END) {
             mr.block_state = BLOCK_INACTIVE;                                    // invalidate mr buffer to reset the new move
             bf->block_state = BLOCK_INITIAL_ACTION;                             // tell _exec to re-use the bf buffer
-            bf->length = get_axis_vector_length(mr.target, mr.position);// reset length
+            bf->length = _get_remaining_length();                       // reset length
             //bf->entry_vmax = 0;                                         // set bp+0 as hold point
 
             cm.hold_state = FEEDHOLD_PENDING;
@@ -593,8 +635,8 @@ stat_t mp_exec_aline(mpBuf_t *bf)
                 mr.r->head_length = 0;
                 mr.r->body_length = 0;
 
-                float available_length = get_axis_vector_length(mr.target, mr.position);
-                mr.r->tail_length = mp_get_target_length(0, mr.r->cruise_velocity, bf);  // braking length
+                float available_length = _get_remaining_length();
+                mr.r->tail_length = mp_get_target_length(0, mr.r->cruise_velocity, &bf->tail);  // braking length
 
                 if (fp_ZERO(available_length - mr.r->tail_length)) {    // (1c) the deceleration time is almost exactly the remaining of the current move
                     cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
@@ -604,7 +646,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
                 } else if (available_length < mr.r->tail_length) {      // (1b) the deceleration has to span multiple moves
                     cm.hold_state = FEEDHOLD_DECEL_CONTINUE;
                     mr.r->tail_length = available_length;
-                    mr.r->exit_velocity = mp_get_decel_velocity(mr.r->cruise_velocity, mr.r->tail_length, bf);
+                    mr.r->exit_velocity = mp_get_decel_velocity(mr.r->cruise_velocity, mr.r->tail_length, &bf->tail);
 
                 } else {                                                // (1a)the deceleration will fit into the current move
                     cm.hold_state = FEEDHOLD_DECEL_TO_ZERO;
@@ -637,6 +679,9 @@ stat_t mp_exec_aline(mpBuf_t *bf)
     if ((cm.hold_state == FEEDHOLD_DECEL_TO_ZERO) && (status == STAT_OK)) {
         cm.hold_state = FEEDHOLD_DECEL_END;
         bf->block_state = BLOCK_INITIAL_ACTION;                      // reset bf so it can restart the rest of the move
+        if (mr.block_type == BLOCK_TYPE_ARC) {
+            bf->arc->offset = mr.distance;                           // ...from where the arc stopped
+        }
     }
 
     // There are 4 things that can happen here depending on return conditions:
@@ -660,7 +705,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         if (bf->block_state == BLOCK_ACTIVE) {
             if (mp_free_run_buffer()) { // returns true of the buffer is empty
                 if (cm.hold_state == FEEDHOLD_OFF) {
-                    cm_cycle_end();    // free buffer & end cycle if planner is empty
+                    st_prep_cycle_end();    // free buffer & end cycle once the steppers have run it
                 }
             } else {
                 st_request_forward_plan();
@@ -865,6 +910,78 @@ static void _init_forward_diffs(const float v_0, const float v_1)
     mr.segment_velocity = half_Ah_5 + half_Bh_4 + half_Ch_3 + v_0;
 }
 
+/*********************************************************************************************
+ * _init_scurve()        - set up an S-curve head or tail (see Ramp profiles in planner.h)
+ * _next_ramp_velocity() - advance segment_velocity to the next segment of a head or tail
+ *
+ *  An S-curve section jerks for a share p of its time at each end and holds its acceleration
+ *  in between. At normalized time t (0 to 1) the velocity is
+ *
+ *        V(t) = V_0 + dV t^2 / (2p(1-p))               t <= p
+ *        V(t) = V_0 + dV (t - p/2) / (1-p)             p <= t <= 1-p
+ *        V(t) = V_1 - dV (1-t)^2 / (2p(1-p))           t >= 1-p
+ *
+ *  A section that ramps by dV <= dV* never reaches the plateau: p = 1/2. Past that the
+ *  jerking takes a/J = T dV* / (dV + dV*) of the section time T. Either way the curve is
+ *  point symmetric, so the section time the planner set (2L / (V_0 + V_1)) still fits, and
+ *  a section stretched by a merged body simply runs at lower jerk. Like the forward
+ *  differences each segment runs at the velocity of its midpoint.
+ */
+
+static void _init_scurve(const float v_0, const float v_1, const float dv_plateau)
+{
+    const float dv = v_1 - v_0;
+    float p = 0.5;
+    if ((dv_plateau > 0) && (fabs(dv) > dv_plateau)) {
+        p = dv_plateau / (fabs(dv) + dv_plateau);
+    }
+    mr.ramp_jerk_share = p;
+    mr.ramp_v_0 = v_0;
+    mr.ramp_v_1 = v_1;
+    mr.ramp_curve = dv / (2 * p * (1 - p));
+    mr.ramp_slope = dv / (1 - p);
+    mr.ramp_step = 1 / mr.segments;
+    mr.ramp_time = -0.5 * mr.ramp_step;
+    _next_ramp_velocity();
+}
+
+static void _next_ramp_velocity()
+{
+    if (mr.ramp_profile != RAMP_SCURVE) {
+        mr.segment_velocity += mr.forward_diff_5;
+        return;
+    }
+    mr.ramp_time += mr.ramp_step;
+    const float t = mr.ramp_time;
+    const float p = mr.ramp_jerk_share;
+    if (t <= p) {
+        mr.segment_velocity = mr.ramp_v_0 + mr.ramp_curve * t * t;
+    } else if (t >= (1 - p)) {
+        mr.segment_velocity = mr.ramp_v_1 - mr.ramp_curve * (1 - t) * (1 - t);
+    } else {
+        mr.segment_velocity = mr.ramp_v_0 + mr.ramp_slope * (t - 0.5 * p);
+    }
+}
+
+/*********************************************************************************************
+ * _set_section_segments() - divide a head, body or tail into segments of equal time
+ *
+ *  Segments are at most max_segment_usec long. With ADAPTIVE_SEGMENTS_ENABLED sections with
+ *  a large velocity_change are cut finer, down to MIN_SEGMENT_MS (see planner.h).
+ */
+
+static void _set_section_segments(const float section_time, const float max_segment_usec, const float velocity_change)
+{
+    mr.segments = ceil(uSec(section_time) / max_segment_usec);
+#if (ADAPTIVE_SEGMENTS_ENABLED == true)
+    float velocity_segments = std::min(ceil(fabs(velocity_change) / SEGMENT_VELOCITY_STEP),
+                                       floor(uSec(section_time) / MIN_SEGMENT_USEC));
+    mr.segments = std::max(mr.segments, velocity_segments);
+#endif
+    mr.segment_count = (uint32_t)mr.segments;
+    mr.segment_time = section_time / mr.segments;               // time to advance for each segment
+}
+
 /*********************************************************************************************
  * _exec_aline_head()
  */
@@ -878,13 +995,13 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
             mr.section = SECTION_BODY;
             return(_exec_aline_body(bf));                            // skip ahead to the body generator
         }
-        mr.segments = ceil(uSec(mr.r->head_time) / NOM_SEGMENT_USEC);// # of segments for the section
-        mr.segment_count = (uint32_t)mr.segments;
-        mr.segment_time = mr.r->head_time / mr.segments;             // time to advance for each segment
+        _set_section_segments(mr.r->head_time, NOM_SEGMENT_USEC, mr.r->cruise_velocity - mr.entry_velocity);
 
         if (mr.segment_count == 1) {
             // We will only have one segment, simply average the velocities
             mr.segment_velocity = mr.r->head_length / mr.segment_time;
+        } else if (mr.ramp_profile == RAMP_SCURVE) {
+            _init_scurve(mr.entry_velocity, mr.r->cruise_velocity, bf->head.dv_plateau);
         } else {
             _init_forward_diffs(mr.entry_velocity, mr.r->cruise_velocity); // <-- sets inital segment_velocity
         }
@@ -895,7 +1012,7 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
         mr.section = SECTION_HEAD;
         mr.section_state = SECTION_RUNNING;
     } else {
-        mr.segment_velocity += mr.forward_diff_5;
+        _next_ramp_velocity();
     }
 
     if (_exec_aline_segment() == STAT_OK) {                     // set up for second half
@@ -905,7 +1022,7 @@ static stat_t _exec_aline_head(mpBuf_t *bf)
 
         mr.section = SECTION_BODY;
         mr.section_state = SECTION_NEW;
-    } else if (!first_pass) {
+    } else if ((!first_pass) && (mr.ramp_profile != RAMP_SCURVE)) {
         mr.forward_diff_5 += mr.forward_diff_4;
         mr.forward_diff_4 += mr.forward_diff_3;
         mr.forward_diff_3 += mr.forward_diff_2;
@@ -928,11 +1045,15 @@ static stat_t _exec_aline_body(mpBuf_t *bf)
             return(_exec_aline_tail(bf));                   // skip ahead to tail periods
         }
 
-        float body_time = mr.r->body_time;
-        mr.segments = ceil(uSec(body_time) / NOM_SEGMENT_USEC);
-        mr.segment_time = body_time / mr.segments;
+        // constant velocity - use long segments unless the kinematics bend the line,
+        // or the chords of an arc would stray from it by more than the chordal tolerance
+        float segment_usec = kn_kinematics_are_linear() ? MAX_SEGMENT_USEC : NOM_SEGMENT_USEC;
+        if (mr.block_type == BLOCK_TYPE_ARC) {
+            float chord_usec = uSec(sqrt(8 * mr.arc.radius * cm.chordal_tolerance) / mr.r->cruise_velocity);
+            segment_usec = max(NOM_SEGMENT_USEC, min(segment_usec, chord_usec));
+        }
+        _set_section_segments(mr.r->body_time, segment_usec, 0);
         mr.segment_velocity = mr.r->cruise_velocity;
-        mr.segment_count = (uint32_t)mr.segments;
         if (mr.segment_time < MIN_SEGMENT_TIME) {
             _debug_trap("mr.segment_time < MIN_SEGMENT_TIME");
             return(STAT_OK);                                // exit without advancing position, say we're done
@@ -965,12 +1086,12 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
         bf->plannable = false;
 
         if (fp_ZERO(mr.r->tail_length)) { return(STAT_OK);}         // end the move
-        mr.segments = ceil(uSec(mr.r->tail_time) / NOM_SEGMENT_USEC);// # of segments for the section
-        mr.segment_count = (uint32_t)mr.segments;
-        mr.segment_time = mr.r->tail_time / mr.segments;             // time to advance for each segment
+        _set_section_segments(mr.r->tail_time, NOM_SEGMENT_USEC, mr.r->cruise_velocity - mr.r->exit_velocity);
 
         if (mr.segment_count == 1) {
             mr.segment_velocity = mr.r->tail_length / mr.segment_time;
+        } else if (mr.ramp_profile == RAMP_SCURVE) {
+            _init_scurve(mr.r->cruise_velocity, mr.r->exit_velocity, bf->tail.dv_plateau);
         } else {
             _init_forward_diffs(mr.r->cruise_velocity, mr.r->exit_velocity); // <-- sets inital segment_velocity
         }
@@ -982,12 +1103,12 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
         mr.section = SECTION_TAIL;
         mr.section_state = SECTION_RUNNING;
     } else {
-        mr.segment_velocity += mr.forward_diff_5;
+        _next_ramp_velocity();
     }
 
     if (_exec_aline_segment() == STAT_OK) {
         return(STAT_OK);                                        // STAT_OK completes the move
-    } else if (!first_pass) {
+    } else if ((!first_pass) && (mr.ramp_profile != RAMP_SCURVE)) {
         mr.forward_diff_5 += mr.forward_diff_4;
         mr.forward_diff_4 += mr.forward_diff_3;
         mr.forward_diff_3 += mr.forward_diff_2;
@@ -1001,8 +1122,9 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
  *
  * NOTES ON STEP ERROR CORRECTION:
  *
- *  The commanded_steps are the target_steps delayed by one more segment.
- *  This lines them up in time with the encoder readings so a following error can be generated
+ *  The commanded_steps are the start position of the segment the loader last loaded, latched
+ *  by the loader together with the encoder reading (see en_read_following_error()). This lines
+ *  them up in time with the encoder readings however far the exec is running ahead of the steppers.
  *
  *  The following_error term is positive if the encoder reading is greater than (ahead of)
  *  the commanded steps, and negative (behind) if the encoder reading is less than the
@@ -1018,6 +1140,7 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
 
 static stat_t _exec_aline_segment()
 {
+    PROF_START(prof_start);
     float travel_steps[MOTORS];
 
     // Set target position for the segment
@@ -1027,6 +1150,10 @@ static stat_t _exec_aline_segment()
 
     if ((--mr.segment_count == 0) && (cm.motion_state != MOTION_HOLD)) {
         copy_vector(mr.gm.target, mr.waypoint[mr.section]);
+        mr.distance = mr.waypoint_distance[mr.section];
+        mr.arc_resync_count = 1;                            // the next section of an arc starts exact
+    } else if (mr.block_type == BLOCK_TYPE_ARC) {
+        _advance_arc_point(mr.segment_velocity * mr.segment_time, mr.gm.target);
     } else {
         float segment_length = mr.segment_velocity * mr.segment_time;
         // see https://en.wikipedia.org/wiki/Kahan_summation_algorithm
@@ -1046,16 +1173,14 @@ static stat_t _exec_aline_segment()
     // Convert target position to steps
     // Bucket-brigade the old target down the chain before getting the new target from kinematics
     //
-    // NB: The direct manipulation of steps to compute travel_steps only works for Cartesian kinematics.
-    //       Other kinematics may require transforming travel distance as opposed to simply subtracting steps.
-
+    // NB: Targets go through the kinematics and travel is the difference in motor space, so this
+    //     holds for any $kty module. Non-linear modules only need short enough segments for the
+    //     straight step lines between joint targets to stay on the path - see _exec_aline_body().
 
     for (uint8_t m=0; m<MOTORS; m++) {
-        mr.commanded_steps[m] = mr.position_steps[m];       // previous segment's position, delayed by 1 segment
         mr.position_steps[m] = mr.target_steps[m];          // previous segment's target becomes position
-        mr.encoder_steps[m] = en_read_encoder(m);           // get current encoder position (time aligns to commanded_steps)
-        mr.following_error[m] = mr.encoder_steps[m] - mr.commanded_steps[m];
     }
+    en_read_following_error(mr.encoder_steps, mr.commanded_steps, mr.following_error);
     kn_inverse_kinematics(mr.gm.target, mr.target_steps);   // now determine the target steps...
     for (uint8_t m=0; m<MOTORS; m++) {                      // and compute the distances to be traveled
         travel_steps[m] = mr.target_steps[m] - mr.position_steps[m];
@@ -1068,10 +1193,86 @@ static stat_t _exec_aline_segment()
     }
 
     // Call the stepper prep function
-    ritorno(st_prep_line(travel_steps, mr.following_error, mr.segment_time));
+    stat_t status = st_prep_line(mr.position_steps, travel_steps, mr.following_error, mr.segment_time);
+    if (status != STAT_OK) {
+        PROF_END(prof_start, PROF_EXEC_SEGMENT);
+        return (status);
+    }
+    BENCH_COUNT(segments);
+    TRAJECTORY_SEGMENT();
     copy_vector(mr.position, mr.gm.target);                 // update position from target
+    PROF_END(prof_start, PROF_EXEC_SEGMENT);
     if (mr.segment_count == 0) {
         return (STAT_OK);                                   // this section has run all its segments
     }
     return (STAT_EAGAIN);                                   // this section still has more segments to run
 }
+
+/*********************************************************************************************
+ * _get_arc_point()        - position on the running arc a given length along it
+ * _advance_arc_point()    - advance the running arc's segment target by step mm
+ * _set_arc_waypoints()    - set the head/body/tail waypoints of the running arc
+ * _get_remaining_length() - length left to run in the running line or arc
+ *
+ *  Arc lengths are measured from the start of the arc as planned, so they hold across the
+ *  restart of a block after a feedhold (see mpArcGeometry_t offset). The end of the move
+ *  is snapped to the target, exactly as lines are.
+ */
+
+static void _get_arc_point(const float distance, float point[])
+{
+    const float fraction = distance / mr.arc.length;
+    const float theta = mr.arc.theta + fraction * mr.arc.angular_travel;
+
+    point[mr.arc.plane_axis_0] = mr.arc.center_0 + sin(theta) * mr.arc.radius;
+    point[mr.arc.plane_axis_1] = mr.arc.center_1 + cos(theta) * mr.arc.radius;
+    point[mr.arc.linear_axis]  = mr.arc.linear_start + fraction * mr.arc.linear_travel;
+}
+
+static void _advance_arc_point(const float step, float point[])
+{
+    const float advance = min(step, mr.arc.length - mr.distance);  // rounding over a long section must not run past the end
+    mr.distance += advance;
+    const float fraction = mr.distance / mr.arc.length;
+
+    if (--mr.arc_resync_count == 0) {                   // see Incremental arc interpolation in plan_arc.h
+        const float theta = mr.arc.theta + fraction * mr.arc.angular_travel;
+        mr.arc_vector_0 = sin(theta) * mr.arc.radius;
+        mr.arc_vector_1 = cos(theta) * mr.arc.radius;
+        mr.arc_resync_count = ARC_RESYNC_SEGMENTS;
+    } else {
+        arc_rotate_small(mr.arc_vector_0, mr.arc_vector_1, advance / mr.arc.length * mr.arc.angular_travel);
+    }
+    point[mr.arc.plane_axis_0] = mr.arc.center_0 + mr.arc_vector_0;
+    point[mr.arc.plane_axis_1] = mr.arc.center_1 + mr.arc_vector_1;
+    point[mr.arc.linear_axis]  = mr.arc.linear_start + fraction * mr.arc.linear_travel;
+}
+
+static void _set_arc_waypoints()
+{
+    mr.waypoint_distance[SECTION_HEAD] = mr.distance + mr.r->head_length;
+    mr.waypoint_distance[SECTION_BODY] = mr.waypoint_distance[SECTION_HEAD] + mr.r->body_length;
+    mr.waypoint_distance[SECTION_TAIL] = mr.arc.length;
+
+    for (uint8_t section = SECTION_HEAD; section <= SECTION_TAIL; section++) {
+        copy_vector(mr.waypoint[section], mr.target);   // also sets the axes the arc doesn't move
+    }
+    if (fp_NOT_ZERO(mr.r->tail_length)) {               // the last section with any length ends on the target
+        _get_arc_point(mr.waypoint_distance[SECTION_BODY], mr.waypoint[SECTION_BODY]);
+    } else {
+        mr.waypoint_distance[SECTION_BODY] = mr.arc.length;
+    }
+    if (fp_NOT_ZERO(mr.r->tail_length) || fp_NOT_ZERO(mr.r->body_length)) {
+        _get_arc_point(mr.waypoint_distance[SECTION_HEAD], mr.waypoint[SECTION_HEAD]);
+    } else {
+        mr.waypoint_distance[SECTION_HEAD] = mr.arc.length;
+    }
+}
+
+static float _get_remaining_length()
+{
+    if (mr.block_type == BLOCK_TYPE_ARC) {
+        return (mr.arc.length - mr.distance);
+    }
+    return (get_axis_vector_length(mr.target, mr.position));
+}
@@ -36,6 +36,8 @@
 #include "util.h"
 #include "spindle.h"
 #include "settings.h"
+#include "profiler.h"
+#include "kinematics.h"
 
 #include "xio.h"
 
@@ -50,16 +52,27 @@ extern OutputPin<kDebug3_PinNumber> debug_pin3;
 
 // planner helper functions
 static mpBuf_t* _plan_block(mpBuf_t* bf);
+static stat_t _queue_line(GCodeState_t* gm_in, const float target[], const uint16_t modal);
+static bool _merge_collinear(const GCodeState_t* gm_in, const float target[], const uint16_t modal);
+static void _blend_corner(GCodeState_t* gm_in, const float target[]);
+static bool _line_can_change(const mpBuf_t* bf);
+static bool _assert_line_can_change(const mpBuf_t* bf, const char* msg);
 static void _calculate_override(mpBuf_t* bf);
-static void _calculate_jerk(mpBuf_t* bf);
-static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const float axis_square[]);
+static void _calculate_jerk(mpBuf_t* bf, const float unit[]);
+static void _calculate_vmaxes(mpBuf_t* bf, const float start[], const float axis_length[], const float axis_square[],
+                              const mpArcGeometry_t* arc);
+static bool _arc_joint_lengths(const mpArcGeometry_t* arc, const float start[], float joint_length[]);
+static void _calculate_arc_vmax(mpBuf_t* bf);
 static void _calculate_junction_vmax(mpBuf_t* bf);
+#if (ARC_CURVATURE_JUNCTION_LIMIT == true)
+static void _add_arc_curvature(const mpBuf_t* bf, const bool at_exit, const float sign, float curvature[]);
+#endif
 
 //+++++DIAGNOSTICS
 #pragma GCC optimize("O0")  // this pragma is required to force the planner to actually set these unused values
 //#pragma GCC reset_options
 static void _set_bf_diagnostics(mpBuf_t* bf) {
-    bf->linenum = bf->gm.linenum;
+    bf->linenum = bf->gm->linenum;
 //  UPDATE_BF_DIAGNOSTICS(bf);   //+++++
 }
 #pragma GCC reset_options
@@ -121,6 +134,21 @@ bool mp_get_runtime_busy()
 
 bool mp_runtime_is_idle() { return (!st_runtime_isbusy()); }
 
+/*
+ * _set_motion_state() - copy the part of the Gcode model a block carries (see Gcode state table)
+ */
+static void _set_motion_state(mpMotionState_t* ms, const GCodeState_t* gm_in, const float target[], const uint16_t modal)
+{
+    ms->linenum        = gm_in->linenum;
+    ms->motion_mode    = gm_in->motion_mode;
+    copy_vector(ms->target, target);
+    ms->feed_rate      = gm_in->feed_rate;
+    ms->feed_rate_mode = gm_in->feed_rate_mode;
+    ms->path_control   = gm_in->path_control;
+    ms->tool           = gm_in->tool;
+    ms->modal          = modal;
+}
+
 /****************************************************************************************
  * mp_aline() - plan a line with acceleration / deceleration
  *
@@ -135,17 +163,21 @@ bool mp_runtime_is_idle() { return (!st_runtime_isbusy()); }
  *  Note: Returning a status that is not STAT_OK means the endpoint is NOT advanced. So lines
  *        that are too short to move will accumulate and get executed once the accumulated error
  *        exceeds the minimums.
+ *
+ *  Note: In G64 with a Q tolerance a line in line with the previous one may be merged into it
+ *        instead of being queued (see Collinear merging in planner.h).
+ *
+ *  Note: In G64 with a P tolerance the corner with the previous line may be blended with an
+ *        arc first (see Corner blending in planner.h), which moves the start of this line.
+ *
+ *  Note: A SCARA or polar line that passes close to the origin is queued in pieces, so only
+ *        the piece nearest the origin is slowed (see kn_center_split() in kinematics.cpp).
  */
 
 stat_t mp_aline(GCodeState_t* gm_in) 
 {
-    mpBuf_t* bf;  // current move pointer
     float target_rotated[AXES] = {0, 0, 0, 0, 0, 0};
-    float axis_square[AXES]    = {0, 0, 0, 0, 0, 0};
-    float axis_length[AXES];
-    bool  flags[AXES];
-    float length_square = 0;
-    float length;
+    float split[2][AXES];
 
     // A few notes about the rotated coordinate space:
     // These are positions PRE-rotation:
@@ -184,8 +216,40 @@ stat_t mp_aline(GCodeState_t* gm_in)
     target_rotated[4] = gm_in->target[4];
     target_rotated[5] = gm_in->target[5];
 
+    uint16_t modal;
+    ritorno(mp_get_modal_state(gm_in, &modal));        // the rest of the model goes in the state table
+    TRAJECTORY_PATH(mp.position, target_rotated, NULL, gm_in->path_tolerance + gm_in->merge_tolerance);
+
+    if (fp_NOT_ZERO(gm_in->merge_tolerance) && _merge_collinear(gm_in, target_rotated, modal)) {
+        return (STAT_OK);
+    }
+    if (fp_NOT_ZERO(gm_in->path_tolerance)) {
+        _blend_corner(gm_in, target_rotated);           // may queue an arc and move mp.position
+    }
+    const uint8_t splits = kn_center_split(mp.position, target_rotated, split);
+    for (uint8_t i = 0; i < splits; i++) {
+        ritorno(_queue_line(gm_in, split[i], modal));
+    }
+    return (_queue_line(gm_in, target_rotated, modal));
+}
+
+/*
+ * _queue_line() - queue a line from the planner position to the target
+ *
+ *  The target is rotated. The whole Gcode line, or a piece of it, after any merge or blend.
+ */
+
+static stat_t _queue_line(GCodeState_t* gm_in, const float target[], const uint16_t modal)
+{
+    mpBuf_t* bf;  // current move pointer
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+    float axis_length[AXES];
+    bool  flags[AXES];
+    float length_square = 0;
+    float length;
+
     for (uint8_t axis = 0; axis < AXES; axis++) {
-        axis_length[axis] = target_rotated[axis] - mp.position[axis];
+        axis_length[axis] = target[axis] - mp.position[axis];
         if ((flags[axis] = fp_NOT_ZERO(axis_length[axis]))) {  // yes, this supposed to be = not ==
             axis_square[axis] = square(axis_length[axis]);
             length_square += axis_square[axis];
@@ -205,9 +269,8 @@ stat_t mp_aline(GCodeState_t* gm_in)
     if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
         return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "aline()"));
     }
-    memcpy(&bf->gm, gm_in, sizeof(GCodeState_t));
-    // Since bf->gm.target is being used all over the place, we'll make it the rotated target
-    copy_vector(bf->gm.target, target_rotated);  // copy the rotated taget in place
+    // Since bf->gm->target is being used all over the place, we'll make it the rotated target
+    _set_motion_state(bf->gm, gm_in, target, modal);
 
     // setup the buffer
     bf->bf_func = mp_exec_aline;                        // register the callback to the exec function
@@ -217,16 +280,414 @@ stat_t mp_aline(GCodeState_t* gm_in)
             bf->unit[axis] = axis_length[axis] / length;// nb: bf-> unit was cleared by mp_get_write_buffer()
         }
     }
-    _calculate_jerk(bf);                              // compute bf->jerk values
-    _calculate_vmaxes(bf, axis_length, axis_square);  // compute cruise_vmax and absolute_vmax
+    _calculate_jerk(bf, bf->unit);                    // compute bf->jerk values
+    _calculate_vmaxes(bf, mp.position, axis_length, axis_square, NULL);  // compute cruise_vmax and absolute_vmax
     _set_bf_diagnostics(bf);                          //+++++DIAGNOSTIC
 
     // Note: these next lines must remain in exact order. Position must update before committing the buffer.
-    copy_vector(mp.position, bf->gm.target);   // set the planner position
+    copy_vector(mp.position, bf->gm->target);   // set the planner position
+    mp.merge_deviation = 0;                    // nothing is merged into the new block yet
+    copy_vector(mp.merge_unit, bf->unit);
     mp_commit_write_buffer(BLOCK_TYPE_ALINE);  // commit current block (must follow the position update)
     return (STAT_OK);
 }
 
+/****************************************************************************************
+ * mp_arc() - plan an arc or helix with acceleration / deceleration
+ *
+ *  Queues the whole arc as a single BLOCK_TYPE_ARC block instead of the chain of short
+ *  lines cm_arc_callback() generates. The block is planned like a line of the arc's length
+ *  and the exec interpolates the arc as it runs the segments (see plan_exec.cpp). It differs
+ *  from a line in these ways:
+ *
+ *    - bf->unit is the tangent at the start of the arc and bf->arc->exit_unit the tangent
+ *      at the end. Junctions use whichever faces the junction.
+ *    - Jerk and axis rate limits use the most any axis takes of the path over the arc:
+ *      the planar travel for both plane axes and the linear travel for the linear axis.
+ *    - Velocity is limited by the centripetal jerk of the circle (_calculate_arc_vmax()),
+ *      and junctions by the change in curvature as well as direction.
+ *
+ *  The caller sets gm_in->target to the end of the arc, and all of the arc geometry other
+ *  than length, offset and exit_unit. Targets are not rotated - see cm_arc_feed().
+ */
+
+stat_t mp_arc(GCodeState_t* gm_in, const mpArcGeometry_t* arc)
+{
+    mpBuf_t* bf;
+    float envelope[AXES]    = {0, 0, 0, 0, 0, 0};  // largest share of the path any axis takes
+    float axis_length[AXES] = {0, 0, 0, 0, 0, 0};
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+    const uint8_t p0  = arc->plane_axis_0;
+    const uint8_t p1  = arc->plane_axis_1;
+    const uint8_t lin = arc->linear_axis;
+
+    const float planar_travel = fabs(arc->angular_travel) * arc->radius;
+    const float length = hypotf(planar_travel, arc->linear_travel);
+
+    if (fp_ZERO(length)) {
+        sr_request_status_report(SR_REQUEST_TIMED_FULL);
+        return (STAT_MINIMUM_LENGTH_MOVE);
+    }
+    uint16_t modal;
+    ritorno(mp_get_modal_state(gm_in, &modal));
+
+    if ((bf = mp_get_write_buffer()) == NULL) {         // never supposed to fail
+        return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "arc()"));
+    }
+    _set_motion_state(bf->gm, gm_in, gm_in->target, modal);
+    *bf->arc = *arc;
+    bf->arc->length = length;
+    bf->arc->offset = 0;
+
+    // tangents at the start and end. theta runs clockwise from plane axis 1 (see _compute_arc())
+    const float planar_unit = copysignf(planar_travel / length, arc->angular_travel);
+    const float theta_end = arc->theta + arc->angular_travel;
+    bf->unit[p0]  =  planar_unit * cos(arc->theta);
+    bf->unit[p1]  = -planar_unit * sin(arc->theta);
+    bf->unit[lin] = arc->linear_travel / length;
+    bf->arc->exit_unit[p0]  =  planar_unit * cos(theta_end);
+    bf->arc->exit_unit[p1]  = -planar_unit * sin(theta_end);
+    bf->arc->exit_unit[lin] = bf->unit[lin];
+
+    envelope[p0] = envelope[p1] = planar_travel / length;
+    envelope[lin] = fabs(arc->linear_travel) / length;
+    axis_length[p0] = axis_length[p1] = planar_travel;
+    axis_length[lin] = arc->linear_travel;
+    axis_square[p0] = square(planar_travel);            // the plane counts once in the feed length
+    axis_square[lin] = square(arc->linear_travel);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        bf->axis_flags[axis] = fp_NOT_ZERO(axis_length[axis]);
+    }
+
+    bf->bf_func = mp_exec_aline;                        // arcs run through the line exec
+    bf->length  = length;
+    _calculate_jerk(bf, envelope);
+    _calculate_vmaxes(bf, mp.position, axis_length, axis_square, bf->arc);
+    _calculate_arc_vmax(bf);
+    _set_bf_diagnostics(bf);                            //+++++DIAGNOSTIC
+
+    // Note: these next lines must remain in exact order. Position must update before committing the buffer.
+    copy_vector(mp.position, bf->gm->target);
+    mp_commit_write_buffer(BLOCK_TYPE_ARC);
+    return (STAT_OK);
+}
+
+/*
+ * _merge_collinear() - extend the last line queued to the target of a new line in line with it
+ *
+ *  See Collinear merging in planner.h. Returns true if the new line was merged, in which
+ *  case it is done. The corner V is the end of the last line, which runs from S = V - u1*L1.
+ *  V's deviation from the merged line S->T is the part of V - S at right angles to it.
+ *
+ *  The merged block gets the new target and line number, and its unit vector, jerk and
+ *  vmaxes are recomputed (the feed rate mode can't be inverse time, so _calculate_vmaxes()
+ *  may run again). The planner is backed up to prime it again, which recomputes the
+ *  junction with the block before it and the feed override, then back-plans from it.
+ *
+ *  A block only has one line number, so the runtime (and the line reported in status
+ *  reports) goes straight from the line before the run to the last line merged. The line
+ *  numbers of the lines merged into it in between are never reported as running.
+ */
+
+static bool _merge_collinear(const GCodeState_t* gm_in, const float target[], const uint16_t modal)
+{
+    mpBuf_t* bf = mb.w->pv;                             // the last block queued
+
+    if ((gm_in->path_control != PATH_CONTINUOUS) || (gm_in->motion_mode != MOTION_MODE_STRAIGHT_FEED) ||
+        (gm_in->feed_rate_mode == INVERSE_TIME_MODE) || (cm.hold_state != FEEDHOLD_OFF)) {
+        return (false);
+    }
+    if ((bf->block_type != BLOCK_TYPE_ALINE) || (bf->gm->path_control != PATH_CONTINUOUS) ||
+        (bf->gm->motion_mode != gm_in->motion_mode) || (bf->gm->feed_rate_mode != gm_in->feed_rate_mode) ||
+        fp_NE(bf->gm->feed_rate, gm_in->feed_rate) || (bf->gm->tool != gm_in->tool) ||
+        (bf->gm->modal != modal) || !_line_can_change(bf)) {
+        return (false);
+    }
+
+    // the merged line from the start of the last line to the new target
+    float axis_length[AXES];
+    float axis_square[AXES] = {0, 0, 0, 0, 0, 0};
+    float length_square = 0;
+    float along = 0;                                    // merged line projected onto the last line
+    float new_length = 0;                               // length of the new line
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        new_length += square(target[axis] - mp.position[axis]);
+        axis_length[axis] = target[axis] - (bf->gm->target[axis] - bf->unit[axis] * bf->length);
+        if (fp_NOT_ZERO(axis_length[axis])) {
+            axis_square[axis] = square(axis_length[axis]);
+            length_square += axis_square[axis];
+            along += axis_length[axis] * bf->unit[axis];
+        } else {
+            axis_length[axis] = 0;
+        }
+    }
+    const float length = sqrt(length_square);
+    new_length = sqrt(new_length);
+    if (along <= bf->length) {                          // the new line doesn't carry on past the corner
+        return (false);
+    }
+    float start[AXES];
+    float split[2][AXES];
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        start[axis] = bf->gm->target[axis] - bf->unit[axis] * bf->length;
+    }
+    if (kn_center_split(start, target, split)) {        // don't undo a split near the origin
+        return (false);
+    }
+    const float foot = bf->length * along / length;     // distance along the merged line to the corner
+    float deviation = 0;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        const float unit = axis_length[axis] / length;
+        deviation += square(bf->unit[axis] * bf->length - unit * foot);
+
+        // the merged line turns the corners at either end of the block. Don't turn them by
+        // more than a corner taken at the feed rate may turn (see _calculate_junction_vmax())
+        const float turn_max = cm.a[axis].max_junction_accel * MERGE_TURN_SHARE / gm_in->feed_rate;
+        if ((fabs(unit - mp.merge_unit[axis]) > turn_max) ||
+            (fabs(unit - (target[axis] - mp.position[axis]) / new_length) > turn_max)) {
+            return (false);
+        }
+    }
+    deviation = sqrt(deviation);
+    if ((mp.merge_deviation + deviation) > gm_in->merge_tolerance) {
+        return (false);
+    }
+
+    // extend the last line. Like a blend this needs it out of reach of the runtime
+    if (!_assert_line_can_change(bf, "_merge_collinear() line in reach of the runtime")) {
+        return (false);
+    }
+    mp.merge_deviation += deviation;
+    BENCH_ADD(length, length - bf->length);
+    BENCH_COUNT(merges);
+    bf->gm->linenum = gm_in->linenum;
+    copy_vector(bf->gm->target, target);
+    bf->length = length;
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        bf->axis_flags[axis] = fp_NOT_ZERO(axis_length[axis]);
+        bf->unit[axis] = axis_length[axis] / length;
+    }
+    _calculate_jerk(bf, bf->unit);
+    _calculate_vmaxes(bf, start, axis_length, axis_square, NULL);
+    _set_bf_diagnostics(bf);
+    mp.queued_usec -= bf->queued_usec;
+    bf->queued_usec = (uint32_t)(bf->block_time * 60000000);
+    mp.queued_usec += bf->queued_usec;
+
+    // prime it again. The junction before it is recomputed only if that block is plannable
+    bf->cruise_velocity = 0;
+    bf->hint = NO_HINT;
+    bf->plannable = true;
+    if (bf->buffer_state == MP_BUFFER_PREPPED) {
+        bf->buffer_state = MP_BUFFER_IN_PROCESS;
+    }
+    if (mp_block_is_move(bf->pv) && (bf->pv->buffer_state != MP_BUFFER_EMPTY) &&
+        (bf->pv->buffer_state < MP_BUFFER_PLANNED)) {
+        bf->pv->plannable = true;
+    }
+    if (mp.p == mb.w) {
+        mp.p = bf;
+    }
+    copy_vector(mp.position, target);
+    mp.request_planning = true;
+    mp.block_timeout.set(BLOCK_TIMEOUT_MS);
+    return (true);
+}
+
+/*
+ * _blend_corner() - round the corner between the last line queued and a new line
+ *
+ *  See Corner blending in planner.h. The corner V has turn angle phi between the unit
+ *  vectors u1 (last line) and u2 (new line). An arc of radius R tangent to both lines
+ *  starts and ends d = R*tan(phi/2) from V and its midpoint is R*(1/cos(phi/2) - 1) from V,
+ *  which sets R for the tolerance - unless that leaves too little of a line, in which
+ *  case d sets R. The center is R/cos(phi/2) from V along the bisector (u2 - u1).
+ *
+ *  The last line is cut back to the start of the arc in place: its unit vector is unchanged,
+ *  so only its length, target and the vmaxes that depend on the length (block time and the
+ *  minimum block time limit) change, and it is made plannable again so back-planning
+ *  revisits it. Priming the arc recomputes its junction with the line.
+ */
+
+static void _blend_corner(GCodeState_t* gm_in, const float target[])
+{
+    mpBuf_t* bf = mb.w->pv;                             // the last block queued
+
+    if ((gm_in->path_control != PATH_CONTINUOUS) || (gm_in->motion_mode != MOTION_MODE_STRAIGHT_FEED) ||
+        (gm_in->feed_rate_mode == INVERSE_TIME_MODE) || (cm.hold_state != FEEDHOLD_OFF) ||
+        !cm_rotation_is_identity()) {                   // blend targets are not rotated (see mp_arc())
+        return;
+    }
+    if ((bf->block_type != BLOCK_TYPE_ALINE) || (bf->gm->path_control != PATH_CONTINUOUS) ||
+        (bf->gm->motion_mode != MOTION_MODE_STRAIGHT_FEED) || !_line_can_change(bf)) {
+        return;
+    }
+
+    // find the plane - both lines may only move the axes of one of XY, XZ or YZ
+    float u2[AXES];
+    float length = 0;
+    bool moving[AXES];
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        u2[axis] = target[axis] - mp.position[axis];
+        moving[axis] = bf->axis_flags[axis] || fp_NOT_ZERO(u2[axis]);
+        length += square(u2[axis]);
+    }
+    length = sqrt(length);
+    if (moving[AXIS_A] || moving[AXIS_B] || moving[AXIS_C] || fp_ZERO(length)) {
+        return;
+    }
+    mpArcGeometry_t arc = mpArcGeometry_t();
+    if (!moving[AXIS_Z]) {
+        arc.plane_axis_0 = AXIS_X; arc.plane_axis_1 = AXIS_Y; arc.linear_axis = AXIS_Z;
+    } else if (!moving[AXIS_Y]) {
+        arc.plane_axis_0 = AXIS_X; arc.plane_axis_1 = AXIS_Z; arc.linear_axis = AXIS_Y;
+    } else if (!moving[AXIS_X]) {
+        arc.plane_axis_0 = AXIS_Y; arc.plane_axis_1 = AXIS_Z; arc.linear_axis = AXIS_X;
+    } else {
+        return;
+    }
+    const uint8_t p0 = arc.plane_axis_0;
+    const uint8_t p1 = arc.plane_axis_1;
+    const float* u1 = bf->unit;
+    u2[p0] /= length;
+    u2[p1] /= length;
+
+    // size the blend
+    const float phi = acos(min(max(u1[p0]*u2[p0] + u1[p1]*u2[p1], (float)-1.0), (float)1.0));
+    if ((phi < BLEND_MIN_ANGLE) || (phi > (float)(M_PI - BLEND_MIN_ANGLE))) {
+        return;                                         // straight enough, or a reversal
+    }
+    const float cos_half = cos(phi/2);
+    const float tan_half = tan(phi/2);
+    float radius = gm_in->path_tolerance * cos_half / (1 - cos_half);
+    float trim = radius * tan_half;
+    const float trim_max = min(bf->length - max(BLEND_MIN_LENGTH, gm_in->feed_rate * MIN_BLOCK_TIME), length / 2);
+    if (trim > trim_max) {
+        trim = trim_max;
+        radius = trim / tan_half;
+    }
+    if ((trim <= 0) || ((radius * phi) < BLEND_MIN_LENGTH)) {
+        return;
+    }
+
+    // only blend if the arc is much faster than the corner (see _calculate_junction_vmax()).
+    // Near reversals the radius gets so small that the arc is the slower of the two
+    float corner_vmax = gm_in->feed_rate;
+    for (uint8_t axis = p0; axis <= p1; axis += (p1 - p0)) {
+        const float delta = fabs(u2[axis] - u1[axis]);
+        if (delta > EPSILON) {
+            corner_vmax = min(corner_vmax, cm.a[axis].max_junction_accel / delta);
+        }
+    }
+    const float jerk = min(cm.a[p0].jerk_max, cm.a[p1].jerk_max) * JERK_MULTIPLIER;
+    if (min(cbrt(jerk * square(radius)), gm_in->feed_rate) <= (corner_vmax * BLEND_MIN_GAIN)) {
+        return;
+    }
+
+    // the arc - theta and angular travel as in _compute_arc(): clockwise from plane axis 1
+    const float bisector_0 = u2[p0] - u1[p0];
+    const float bisector_1 = u2[p1] - u1[p1];
+    const float bisector = hypotf(bisector_0, bisector_1);
+    const float center_distance = radius / cos_half / bisector;
+    arc.center_0 = mp.position[p0] + bisector_0 * center_distance;
+    arc.center_1 = mp.position[p1] + bisector_1 * center_distance;
+    arc.radius = radius;
+    arc.theta = atan2(mp.position[p0] - u1[p0]*trim - arc.center_0, mp.position[p1] - u1[p1]*trim - arc.center_1);
+    arc.angular_travel = ((u1[p0]*u2[p1] - u1[p1]*u2[p0]) < 0) ? phi : -phi;   // right turns are clockwise
+    arc.linear_start = mp.position[arc.linear_axis];
+
+    // cut back the last line. It must still be out of reach of the exec and forward planner.
+    // Nothing is queued yet, so a failed check just leaves the corner sharp
+    if (!_assert_line_can_change(bf, "_blend_corner() line in reach of the runtime")) {
+        return;
+    }
+    const float line_length = bf->length - trim;
+    const float line_time = max(bf->block_time * line_length / bf->length, MIN_BLOCK_TIME);
+    BENCH_ADD(length, -trim);
+    BENCH_COUNT(blends);
+    bf->gm->target[p0] -= u1[p0] * trim;
+    bf->gm->target[p1] -= u1[p1] * trim;
+    bf->length = line_length;
+    bf->block_time = line_time;
+    bf->cruise_vset = line_length / line_time;
+    bf->cruise_vmax = fp_ZERO(bf->override_factor) ? bf->cruise_vset : bf->override_factor * bf->cruise_vset;
+    bf->cruise_velocity = min(bf->cruise_velocity, bf->cruise_vmax);
+    bf->absolute_vmax = min(bf->absolute_vmax, line_length / MIN_BLOCK_TIME);
+    mp.queued_usec -= bf->queued_usec;
+    bf->queued_usec = (uint32_t)(line_time * 60000000);
+    mp.queued_usec += bf->queued_usec;
+    bf->hint = NO_HINT;
+    bf->plannable = true;
+    if (bf->buffer_state == MP_BUFFER_PREPPED) {
+        bf->buffer_state = MP_BUFFER_IN_PROCESS;
+    }
+
+    // queue the arc. mp_arc() leaves mp.position at its end, the start of the new line.
+    // The arc goes in before mp_aline() has decided to accept the new line. That can't
+    // leave the arc dangling: the new line is now at least trim long so it isn't dropped
+    // as a zero length move, and failing to get its buffer is a panic anyway
+    GCodeState_t gm = *gm_in;
+    copy_vector(gm.target, mp.position);
+    gm.target[p0] += u2[p0] * trim;
+    gm.target[p1] += u2[p1] * trim;
+    mp_arc(&gm, &arc);
+}
+
+/*
+ * _line_can_change() - true if the last line queued can still be cut back or extended
+ *
+ *  _blend_corner() and _merge_collinear() change the last line queued in place. That is only
+ *  safe while neither the exec nor the forward planner can reach it:
+ *
+ *    - mp_exec_move() only runs a block once it is PLANNED, and the forward planner (from
+ *      the exec interrupt) only plans the first move past the running block, and nothing
+ *      at all in STARTUP.
+ *    - So a line that is not PLANNED, with BLEND_MIN_QUEUED unplanned moves before it, can't
+ *      be reached until the exec has run at least one whole block. Commands don't count as
+ *      they are planned along with the move after them.
+ *
+ *  The exec may move on while a change is being worked out, so callers test this first to
+ *  decide, then again with _assert_line_can_change() right before they write to the buffer.
+ */
+
+static bool _line_can_change(const mpBuf_t* bf)
+{
+    if (bf->buffer_state >= MP_BUFFER_PLANNED) {
+        return (false);
+    }
+    if (mp.planner_state <= PLANNER_STARTUP) {
+        return (true);
+    }
+    for (uint8_t queued = 0; queued < BLEND_MIN_QUEUED; ) {
+        bf = bf->pv;
+        if ((bf->buffer_state == MP_BUFFER_EMPTY) || (bf->buffer_state >= MP_BUFFER_PLANNED)) {
+            return (false);
+        }
+        if (mp_block_is_move(bf)) {
+            queued++;
+        }
+    }
+    return (true);
+}
+
+/*
+ * _assert_line_can_change() - check the invariant of _line_can_change() before a change
+ *
+ *  Returns true if the line may still be written. Otherwise the exec got to within
+ *  BLEND_MIN_QUEUED moves of it while the change was worked out, which is a planner error:
+ *  report it, trap in the debugger and leave the line as it was.
+ */
+
+static bool _assert_line_can_change(const mpBuf_t* bf, const char* msg)
+{
+    if ((bf != mb.r) && (bf != mb.w) && _line_can_change(bf)) {
+        return (true);
+    }
+    rpt_exception(STAT_PLANNER_ASSERTION_FAILURE, msg);
+    _debug_trap(msg);
+    return (false);
+}
+
 /*
  * mp_plan_block_list() - plan all the blocks in the list
  *
@@ -257,7 +718,10 @@ void mp_plan_block_list()
             return;
         }
 
+        PROF_START(prof_start);
         bf = _plan_block(bf);  // returns next block to plan
+        PROF_END(prof_start, PROF_PLAN_BLOCK);
+        BENCH_COUNT(plan_blocks);
 
         planned_something = true;
         mp.p              = bf;  //+++++ DIAGNOSTIC - this is not needed but is set here for debugging purposes
@@ -282,8 +746,11 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
         // Timings from *here*
 
         if (bf->pv->plannable) {
+            if (mp.dirty == NULL) {
+                mp.dirty = bf->pv;             // the earliest block back-planning must revisit
+            }
             _calculate_junction_vmax(bf->pv);  // compute maximum junction velocity constraint
-            if (bf->pv->gm.path_control == PATH_EXACT_STOP) {
+            if (bf->pv->gm->path_control == PATH_EXACT_STOP) {
                 bf->pv->exit_vmax = 0;
             } else {
                 bf->pv->exit_vmax = min3(bf->pv->junction_vmax, bf->pv->cruise_vmax, bf->cruise_vmax);
@@ -310,18 +777,33 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
     // If it reaches cruise_vmax generate perfect cruises instead
     // Note: Vmax's are already set by the time you get here
     // Hint options from back-planning: COMMAND_BLOCK, PERFECT_DECELERATION, PERFECT_CRUISE, MIXED_DECELERATION
+    //
+    // Back-planning is incremental. A block's plan depends only on its own constraints and on the
+    // plan of the block after it. Once the pass is behind the earliest block whose constraints
+    // changed (mp.dirty, set by priming) and a block comes out exactly as it was planned last time,
+    // every block before it would too, so the pass stops there. A pass only visits the blocks whose
+    // plan actually changes, plus the blocks the optimal flag is being carried back to (which run
+    // to the end so plannable is cleared as before).
 
     if (mp.planner_state == PLANNER_BACK_PLANNING) {
         // NOTE: We stop when the previous block is no longer plannable.
         // We will alter the previous block's exit_velocity.
         float braking_velocity = 0;  // we use this to stre the previous entry velocity, start at 0
         bool optimal = false;  // we use the optimal flag (as the opposite of plannable) to carry plan-ability backward.
+        bool past_dirty = false;  // true once the pass has replanned mp.dirty
 
         // We test for (braking_velocity < bf->exit_velocity) in case of an inversion, and plannable is then violated.
         for (; bf->plannable || (braking_velocity < bf->exit_velocity); bf = bf->pv) {
             // Timings from *here*
 
             bf->iterations++;
+            BENCH_COUNT(back_plans);
+
+            // the plan this block had, to test for convergence
+            const float exit_was   = bf->exit_velocity;
+            const float cruise_was = bf->cruise_velocity;
+            const blockHint hint_was = bf->hint;
+
             bf->plannable = bf->plannable && !optimal;  // Don't accidentally enable plannable!
 
             // Let's be mindful that forward planning may change exit_vmax, and our exit velocity may be lowered
@@ -383,7 +865,7 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
 
             // Ok, now we can test deceleration cases
             else {
-                braking_velocity = mp_get_target_velocity(bf->exit_velocity, bf->length, bf);
+                braking_velocity = mp_get_target_velocity(bf->exit_velocity, bf->length, &bf->tail);
 
                 if (bf->pv->exit_vmax > braking_velocity) {  // remember, exit vmax already is min of
                                                              // pv_group->cruise_vmax, cruise_vmax, and
@@ -428,7 +910,17 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
             if (bf->buffer_state < MP_BUFFER_PREPPED) {
                 bf->buffer_state = MP_BUFFER_PREPPED;
             }
+
+            // converged - nothing before this block will change
+            if (past_dirty && !optimal && (bf->exit_velocity == exit_was) &&
+                (bf->cruise_velocity == cruise_was) && (bf->hint == hint_was)) {
+                break;
+            }
+            if (bf == mp.dirty) {
+                past_dirty = true;
+            }
         }  // for loop
+        mp.dirty = NULL;
     }      // exits with bf pointing to a locked or EMPTY block
 
     mp.planner_state = PLANNER_PRIMING;  // revert to initial state
@@ -450,6 +942,9 @@ static void _calculate_override(mpBuf_t* bf)  // execute ramp to adjust cruise v
     // pull in override factor from previous block or seed initial value from the system setting
     bf->override_factor = fp_ZERO(bf->pv->override_factor) ? cm.gmx.mfo_factor : bf->pv->override_factor;
     bf->cruise_vmax     = bf->override_factor * bf->cruise_vset;
+    if (bf->block_type == BLOCK_TYPE_ARC) {   // an override can't take an arc past its centripetal limit
+        bf->cruise_vmax = min(bf->cruise_vmax, bf->absolute_vmax);
+    }
 
     // generate ramp term is a ramp is active
     if (mp.ramp_active) {
@@ -496,34 +991,113 @@ static void _calculate_override(mpBuf_t* bf)  // execute ramp to adjust cruise v
  *  Set the jerk scaling to the lowest axis with a non-zero unit vector.
  *  Go through the axes one by one and compute the scaled jerk, then pick
  *  the highest jerk that does not violate any of the axes in the move.
+ *  Lines pass bf->unit. Arcs pass the largest share of the path each axis takes.
+ *
+ *  If the unit vector and the axis jerk limits are the same as the last block that
+ *  computed them the jerk terms are copied from mp.jerk_cache (see Jerk cache).
+ *
+ *  The head and tail ramp terms follow from the jerk and cm.ramp_profile (see Ramp profiles).
+ *  S-curve ramps also take the block's acceleration limit, found the same way as the jerk.
  *
  * Cost about ~65 uSec
  */
 
-static void _calculate_jerk(mpBuf_t* bf) 
+static float _axis_jerk(const mpBuf_t* bf, const uint8_t axis)
 {
-    // compute the jerk as the largest jerk that still meets axis constraints
-    bf->jerk   = 8675309;  // a ridiculously large number
-    float jerk = 0;
-
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        if (fabs(bf->unit[axis]) > 0) {  // if this axis is participating in the move
-            float axis_jerk = 0;
 #ifdef TRAVERSE_AT_HIGH_JERK
 #warning using experimental feature TRAVERSE_AT_HIGH_JERK!
-            switch (bf->gm.motion_mode) {
-                case MOTION_MODE_STRAIGHT_TRAVERSE:
-                //case MOTION_MODE_STRAIGHT_PROBE: // <-- not sure on this one
-                    axis_jerk = cm.a[axis].jerk_high;
-                    break;
-                default:
-                    axis_jerk = cm.a[axis].jerk_max;
-            }
+    switch (bf->gm->motion_mode) {
+        case MOTION_MODE_STRAIGHT_TRAVERSE:
+        //case MOTION_MODE_STRAIGHT_PROBE: // <-- not sure on this one
+            return (cm.a[axis].jerk_high);
+        default:
+            return (cm.a[axis].jerk_max);
+    }
 #else
-            axis_jerk = cm.a[axis].jerk_max;
+    return (cm.a[axis].jerk_max);
 #endif
+}
+
+static bool _jerk_cache_hit(const mpBuf_t* bf, const float unit[])
+{
+    mpJerkCache_t *jc = &mp.jerk_cache;
+
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        const float u = fabs(unit[axis]);
+        if (u != jc->unit[axis]) {
+            return (false);
+        }
+        if ((u > 0) && (_axis_jerk(bf, axis) != jc->axis_jerk[axis])) {
+            return (false);
+        }
+    }
+    return (jc->jerk > 0);      // the cache starts out empty
+}
+
+void mp_reset_jerk_cache()
+{
+    mp.jerk_cache.jerk = 0;
+}
+
+static void _set_ramp(mpRamp_t* ramp, const float jerk, const float dv_plateau)
+{
+    const float q          = 2.40281141413;  // (sqrt(10)/(3^(1/4)))
+    const float sqrt_j     = sqrt(jerk);
+    ramp->jerk             = jerk;
+    ramp->sqrt_j           = sqrt_j;
+    ramp->q_recip_2_sqrt_j = q / (2 * sqrt_j);
+    ramp->dv_plateau       = dv_plateau;
+    ramp->plateau_k        = (dv_plateau > 0) ? ramp->q_recip_2_sqrt_j / (2 * sqrt(dv_plateau)) : 0;
+}
+
+static void _set_scurve_ramps(mpBuf_t* bf, const float unit[])
+{
+    float accel = 0;                        // 0 is no limit
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        const float u = fabs(unit[axis]);
+        if ((u > 0) && (cm.a[axis].accel_max > 0)) {
+            const float axis_accel = cm.a[axis].accel_max * ACCEL_MULTIPLIER / u;
+            if ((accel == 0) || (axis_accel < accel)) {
+                accel = axis_accel;
+            }
+        }
+    }
+    const float accel_sq  = accel * accel;
+    const float tail_jerk = bf->jerk * cm.decel_jerk_ratio;
+    _set_ramp(&bf->head, bf->jerk * SCURVE_JERK_FACTOR, accel_sq / bf->jerk);
+    _set_ramp(&bf->tail, tail_jerk * SCURVE_JERK_FACTOR, accel_sq / tail_jerk);
+}
+
+static void _calculate_jerk(mpBuf_t* bf, const float unit[])
+{
+    PROF_START(prof_start);
+    BENCH_COUNT(jerk_calls);
+    mpJerkCache_t *jc = &mp.jerk_cache;
+
+    bf->ramp_profile = (rampProfile)cm.ramp_profile;
+
+    if (_jerk_cache_hit(bf, unit)) {
+        bf->jerk = jc->jerk;
+        bf->head = jc->head;
+        bf->tail = jc->tail;
+        BENCH_COUNT(jerk_hits);
+        PROF_END(prof_start, PROF_JERK_HIT);
+        return;
+    }
+
+    // compute the jerk as the largest jerk that still meets axis constraints
+    bf->jerk   = 8675309;  // a ridiculously large number
+    float jerk = 0;
 
-            jerk = axis_jerk / fabs(bf->unit[axis]);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        const float u = fabs(unit[axis]);
+        jc->unit[axis] = u;
+        jc->axis_jerk[axis] = 0;
+        if (u > 0) {  // if this axis is participating in the move
+            const float axis_jerk = _axis_jerk(bf, axis);
+            jc->axis_jerk[axis] = axis_jerk;
+
+            jerk = axis_jerk / u;
             if (jerk < bf->jerk) {
                 bf->jerk = jerk;
                 //              bf->jerk_axis = axis;           // +++ diagnostic
@@ -531,13 +1105,18 @@ static void _calculate_jerk(mpBuf_t* bf)
         }
     }
     bf->jerk *= JERK_MULTIPLIER;           // goose it!
-    bf->jerk_sq    = bf->jerk * bf->jerk;  // pre-compute terms used multiple times during planning
-    bf->recip_jerk = 1 / bf->jerk;
 
-    const float q        = 2.40281141413;  // (sqrt(10)/(3^(1/4)))
-    const float sqrt_j   = sqrt(bf->jerk);
-    bf->sqrt_j           = sqrt_j;
-    bf->q_recip_2_sqrt_j = q / (2 * sqrt_j);
+    if (bf->ramp_profile == RAMP_SCURVE) {
+        _set_scurve_ramps(bf, unit);
+    } else {
+        _set_ramp(&bf->head, bf->jerk, 0);
+        bf->tail = bf->head;
+    }
+
+    jc->jerk = bf->jerk;
+    jc->head = bf->head;
+    jc->tail = bf->tail;
+    PROF_END(prof_start, PROF_JERK_MISS);
 }
 
 /*
@@ -564,6 +1143,11 @@ static void _calculate_jerk(mpBuf_t* bf)
  *  Prerequisites for calling this function:
  *    - Targets must be set via cm_set_target(). Axis modes are taken into account by this.
  *    - The unit vector and associated flags were computed.
+ *
+ *  start[] is where the block starts. axis_length[] is the block's length on each axis for
+ *  a line, and the envelope (the most of the path each axis takes) for an arc, in which
+ *  case arc is its geometry and only the axes the arc doesn't move are read from start[].
+ *  Lines pass NULL.
  */
 /* --- NIST RS274NGC_v3 Guidance ---
  *
@@ -599,36 +1183,58 @@ static void _calculate_jerk(mpBuf_t* bf)
  *       so that the elapsed time from the start to the end of the motion is T plus
  *       any time required for acceleration or deceleration.
  */
-static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const float axis_square[]) 
+/* --- Joint rate limits ---
+ *
+ *  The axis rate limits are limits on the motors, so with a non-linear kinematics module the
+ *  times come from how far the joints move rather than the axes. kn_joint_lengths() gives the
+ *  peak joint rate along the block times one block, for modules where it differs from the
+ *  axis length (a trunnion's XYZ swing with A and C, or SCARA and polar turning about the
+ *  origin - see kinematics.h). The block is then
+ *  slow enough that no joint exceeds its limit anywhere along it, not only on average.
+ *
+ *  An arc is not a straight block, so its joint lengths come from chords of it no more than
+ *  ARC_JOINT_CHORD_RADIANS apart: the peak over the chords, scaled from one chord to the
+ *  whole arc and from the chord's length to the arc's (see _arc_joint_lengths()).
+ */
+static void _calculate_vmaxes(mpBuf_t* bf, const float start[], const float axis_length[], const float axis_square[],
+                              const mpArcGeometry_t* arc)
 {
     float feed_time = 0;        // one of: XYZ time, ABC time or inverse time. Mutually exclusive
     float max_time  = 0;        // time required for the rate-limiting axis
     float tmp_time  = 0;        // temp value used in computation
     float min_time  = 8675309;  // looking for fastest possible execution (seed w/arbitrarily large number)
     float block_time;           // resulting move time
+    float joint_length[AXES];
 
     // compute feed time for feeds and probe motion
-    if (bf->gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) {
-        if (bf->gm.feed_rate_mode == INVERSE_TIME_MODE) {
-            feed_time             = bf->gm.feed_rate;  // NB: feed rate was un-inverted to minutes by cm_set_feed_rate()
-            bf->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    if (bf->gm->motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) {
+        if (bf->gm->feed_rate_mode == INVERSE_TIME_MODE) {
+            feed_time             = bf->gm->feed_rate;  // NB: feed rate was un-inverted to minutes by cm_set_feed_rate()
+            bf->gm->feed_rate_mode = UNITS_PER_MINUTE_MODE;
         } else {
             // compute length of linear move in millimeters. Feed rate is provided as mm/min
-            feed_time = sqrt(axis_square[AXIS_X] + axis_square[AXIS_Y] + axis_square[AXIS_Z]) / bf->gm.feed_rate;
+            feed_time = sqrt(axis_square[AXIS_X] + axis_square[AXIS_Y] + axis_square[AXIS_Z]) / bf->gm->feed_rate;
             // if no linear axes, compute length of multi-axis rotary move in degrees. Feed rate is provided as
             // degrees/min
             if (fp_ZERO(feed_time)) {
-                feed_time = sqrt(axis_square[AXIS_A] + axis_square[AXIS_B] + axis_square[AXIS_C]) / bf->gm.feed_rate;
+                feed_time = sqrt(axis_square[AXIS_A] + axis_square[AXIS_B] + axis_square[AXIS_C]) / bf->gm->feed_rate;
             }
         }
     }
+    // use the joint lengths if the kinematics has them (see Joint rate limits)
+    const float *length = axis_length;
+    if ((arc == NULL) ? kn_joint_lengths(start, axis_length, joint_length)
+                      : _arc_joint_lengths(arc, start, joint_length)) {
+        length = joint_length;
+    }
+
     // compute rate limits and absolute maximum limit
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
-        if (bf->axis_flags[axis]) {
-            if (bf->gm.motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
-                tmp_time = fabs(axis_length[axis]) / cm.a[axis].velocity_max;
+        if (bf->axis_flags[axis] || fp_NOT_ZERO(length[axis])) {
+            if (bf->gm->motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
+                tmp_time = fabs(length[axis]) / cm.a[axis].velocity_max;
             } else {  // gm.motion_mode == MOTION_MODE_STRAIGHT_FEED
-                tmp_time = fabs(axis_length[axis]) / cm.a[axis].feedrate_max;
+                tmp_time = fabs(length[axis]) / cm.a[axis].feedrate_max;
             }
             max_time = max(max_time, tmp_time);
 
@@ -645,6 +1251,81 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
     bf->block_time    = block_time;               // initial estimate - used for ramp computations
 }
 
+/*
+ * _arc_joint_lengths() - kn_joint_lengths() for an arc, from chords of it
+ *
+ *  The arc is cut into chords no more than ARC_JOINT_CHORD_RADIANS long, as the exec runs
+ *  it: theta clockwise from plane axis 1, the linear axis in proportion, and the other axes
+ *  at start[]. The plane and linear axes come from the geometry, not start[], as a blend
+ *  arc starts short of the planner position (see _blend_corner()). Each chord is a straight
+ *  block to the kinematics, and its joint lengths times the number of chords are what the
+ *  whole arc would take at that chord's peak rate. The arc is a little longer than its
+ *  chords, so that is scaled up by the ratio.
+ *  Returns false, as kn_joint_lengths() does, if the axis lengths should be used.
+ */
+
+static bool _arc_joint_lengths(const mpArcGeometry_t* arc, const float start[], float joint_length[])
+{
+    const uint8_t chords = (uint8_t)min((float)ARC_JOINT_CHORDS_MAX,
+                                        max(ceil(fabs(arc->angular_travel) / ARC_JOINT_CHORD_RADIANS), (float)1));
+    const float half = fabs(arc->angular_travel) / chords / 2;
+    const float scale = (half > EPSILON) ? chords * half / sin(half) : chords;
+    float from[AXES];
+    float to[AXES];
+    float length[AXES];
+    float chord_length[AXES];
+
+    copy_vector(to, start);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        joint_length[axis] = 0;
+    }
+    for (uint8_t i = 0; i <= chords; i++) {
+        const float theta = arc->theta + arc->angular_travel * i / chords;
+        to[arc->plane_axis_0] = arc->center_0 + sin(theta) * arc->radius;
+        to[arc->plane_axis_1] = arc->center_1 + cos(theta) * arc->radius;
+        to[arc->linear_axis] = arc->linear_start + arc->linear_travel * i / chords;
+        if (i == 0) {
+            copy_vector(from, to);
+            continue;
+        }
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            length[axis] = to[axis] - from[axis];
+        }
+        if (!kn_joint_lengths(from, length, chord_length)) {
+            return (false);
+        }
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            joint_length[axis] = max(joint_length[axis], fabs(chord_length[axis]) * scale);
+        }
+        copy_vector(from, to);
+    }
+    return (true);
+}
+
+/*
+ * _calculate_arc_vmax() - limit an arc to the centripetal jerk of its plane axes
+ *
+ *  Running a circle of radius r at velocity v swings each plane axis through a sine wave
+ *  with a jerk amplitude of v^3/r^2 (times the planar share of the path cubed for a helix).
+ *  The velocity that keeps this within the jerk of both plane axes caps cruise_vset and
+ *  absolute_vmax so feed overrides can't exceed it either. The step in acceleration where
+ *  the arc starts and ends is a junction constraint - see _calculate_junction_vmax().
+ */
+
+static void _calculate_arc_vmax(mpBuf_t* bf)
+{
+    const float planar_share = fabs(bf->arc->angular_travel) * bf->arc->radius / bf->length;
+    const float jerk = min(cm.a[bf->arc->plane_axis_0].jerk_max, cm.a[bf->arc->plane_axis_1].jerk_max) * JERK_MULTIPLIER;
+    const float vmax = cbrt(jerk * square(bf->arc->radius)) / planar_share;
+
+    if (bf->cruise_vset > vmax) {
+        bf->cruise_vset = vmax;
+        bf->cruise_vmax = vmax;
+        bf->block_time  = bf->length / vmax;
+    }
+    bf->absolute_vmax = min(bf->absolute_vmax, vmax);
+}
+
 /*
  * _calculate_junction_vmax() - Giseburt's Algorithm ;-)
  *
@@ -684,6 +1365,16 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
  *  We then compute (4) for each axis, and use the smallest (most limited) result or
  *  vmax, whichever is smaller.
  */
+/* Arcs:
+ *  Where either block is an arc the acceleration also steps at the junction, even when the
+ *  tangents line up: by v^2 times the change in curvature, axis by axis. Treating this step
+ *  like the change in velocity above - delivered over the integration time T - gives
+ *
+ *      Velocity[i] = sqrt(max_junction_accel[i] / (T * CurvatureDelta[i]))      (5)
+ *
+ *  Consecutive arcs around the same center have no curvature delta and aren't limited.
+ *  This limit is only applied with ARC_CURVATURE_JUNCTION_LIMIT (see planner.h).
+ */
 /* Note 1:
  *  junction_integration_time is the integration Time quantum expressed in minutes.
  *  This is roughly on the order of 1 DDA clock tick to integrate jerk to acceleration.
@@ -702,9 +1393,12 @@ static void _calculate_junction_vmax(mpBuf_t* bf)
     // uint8_t jerk_axis = AXIS_X;
     // cmAxes jerk_axis = AXIS_X;
 
+    // arcs meet the next block with the tangent at their end
+    const float* unit = (bf->block_type == BLOCK_TYPE_ARC) ? bf->arc->exit_unit : bf->unit;
+
     for (uint8_t axis = 0; axis < AXES; axis++) {
         if (bf->axis_flags[axis] || bf->nx->axis_flags[axis]) {       // skip axes with no movement
-            float delta = fabs(bf->unit[axis] - bf->nx->unit[axis]);  // formula (1)
+            float delta = fabs(unit[axis] - bf->nx->unit[axis]);      // formula (1)
 
             // Corner case: If an axis has zero delta, we might have a straight line.
             // Corner case: An axis doesn't change (and it's not a straight line).
@@ -720,5 +1414,43 @@ static void _calculate_junction_vmax(mpBuf_t* bf)
             }
         }
     }
+
+#if (ARC_CURVATURE_JUNCTION_LIMIT == true)
+    if ((bf->block_type == BLOCK_TYPE_ARC) || (bf->nx->block_type == BLOCK_TYPE_ARC)) {
+        float curvature[AXES] = {0, 0, 0, 0, 0, 0};
+        const float T = cm.junction_integration_time / 1000.0;    // as in _cm_recalc_max_junction_accel()
+        _add_arc_curvature(bf, true, 1.0, curvature);
+        _add_arc_curvature(bf->nx, false, -1.0, curvature);
+
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            float delta = fabs(curvature[axis]);
+            if (delta > EPSILON) {                                     // formula (5)
+                velocity = min(velocity, (float)sqrt(cm.a[axis].max_junction_accel / (T * delta)));
+            }
+        }
+    }
+#endif
     bf->junction_vmax = velocity;
 }
+
+/*
+ * _add_arc_curvature() - add the curvature vector at the start or end of an arc, times sign
+ *
+ *  The curvature points at the center and has a magnitude of (planar share)^2 / r.
+ *  Lines have no curvature and add nothing.
+ */
+
+#if (ARC_CURVATURE_JUNCTION_LIMIT == true)
+static void _add_arc_curvature(const mpBuf_t* bf, const bool at_exit, const float sign, float curvature[])
+{
+    if (bf->block_type != BLOCK_TYPE_ARC) {
+        return;
+    }
+    const float theta = at_exit ? (bf->arc->theta + bf->arc->angular_travel) : bf->arc->theta;
+    const float planar_share = fabs(bf->arc->angular_travel) * bf->arc->radius / bf->arc->length;
+    const float k = sign * square(planar_share) / bf->arc->radius;
+
+    curvature[bf->arc->plane_axis_0] -= k * sin(theta);
+    curvature[bf->arc->plane_axis_1] -= k * cos(theta);
+}
+#endif
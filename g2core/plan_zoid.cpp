@@ -65,11 +65,6 @@
 /* local functions */
 
 // static float _get_target_length_min(const float v_0, const float v_1, const mpBuf_t *bf, const float min);
-static float _get_meet_velocity(const float          v_0,
-                                const float          v_2,
-                                const float          L,
-                                mpBuf_t*             bf,
-                                mpBlockRuntimeBuf_t* block);
 
 /****************************************************************************************
  * mp_calculate_ramps() - calculate trapezoid-like ramp parameters for a block
@@ -202,7 +197,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
         // MIXED_DECELERATION (2d) 2 segment BT deceleration move
         // Only possible if the entry has not changed since hinting.
         else if (bf->hint == MIXED_DECELERATION) {
-            block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, bf);
+            block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, &bf->tail);
             block->body_length = bf->length - block->tail_length;
             block->head_length = 0;
 
@@ -239,7 +234,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
             accel_velocity      = test_velocity;
             test_velocity_valid = false;
         } else {
-            accel_velocity = mp_get_target_velocity(entry_velocity, bf->length, bf);
+            accel_velocity = mp_get_target_velocity(entry_velocity, bf->length, &bf->head);
         }
 
         if (accel_velocity < block->exit_velocity) {  // still accelerating
@@ -275,7 +270,7 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
                 bf->hint = MIXED_ACCELERATION;
 
                 // MIXED_ACCELERATION (2a) 2 segment HB acceleration move
-                block->head_length = mp_get_target_length(entry_velocity, block->cruise_velocity, bf);
+                block->head_length = mp_get_target_length(entry_velocity, block->cruise_velocity, &bf->head);
                 block->body_length = bf->length - block->head_length;
                 block->tail_length = 0;  // we just set it, now we unset it
                 block->head_time   = (block->head_length * 2.0) / (entry_velocity + block->cruise_velocity);
@@ -295,14 +290,14 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
     // MIXED_DECELERATION
 
     // All that remains is ASYMMETRIC_BUMP and SYMMETRIC_BUMP.
-    // We don't really care if it's symmetric, since the first test that _get_meet_velocity
+    // We don't really care if it's symmetric, since the first test that mp_get_meet_velocity
     //  does is for a symmetric move. It's cheaper to just let it do that then to try and prevent it.
 
     // *** Requested-Fit cases (2) ***
 
     // Prepare the head and tail lengths for evaluating cases (nb: zeros head / tail < min length)
-    block->head_length = mp_get_target_length(entry_velocity, block->cruise_velocity, bf);
-    block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, bf);
+    block->head_length = mp_get_target_length(entry_velocity, block->cruise_velocity, &bf->head);
+    block->tail_length = mp_get_target_length(block->exit_velocity, block->cruise_velocity, &bf->tail);
 
     if ((bf->length - 0.0001) > (block->head_length + block->tail_length)) {
         // 3 segment HBT move (2c) - either with a body or just a symmetric bump
@@ -324,10 +319,10 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 
     // Rate-limited asymmetric cases (3)
     // compute meet velocity to see if the cruise velocity rises above the entry and/or exit velocities
-    block->cruise_velocity = _get_meet_velocity(entry_velocity, block->exit_velocity, bf->length, bf, block);
+    block->cruise_velocity = mp_get_meet_velocity(entry_velocity, block->exit_velocity, bf->length, bf, block);
     TRAP_ZERO(block->cruise_velocity, "zoid() Vc=0 asymmetric HT case");
 
-    // We now store the head/tail lengths we computed in _get_meet_velocity.
+    // We now store the head/tail lengths we computed in mp_get_meet_velocity.
     // treat as a full up and down (head and tail)
     bf->hint = ASYMMETRIC_BUMP;
 
@@ -355,7 +350,11 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
  * mp_get_target_length()   - find accel/decel length from delta V and jerk
  * mp_get_target_velocity() - find velocity achievable from Vi, length and jerk
  * _get_target_length_min() - find target length with correction for minimum length moves
- * _get_meet_velocity()     - find velocity at which two lines intersect
+ * mp_get_decel_velocity()  - find velocity reached decelerating from Vi over a length
+ * mp_get_meet_velocity()   - find velocity at which two lines intersect
+ *
+ *  See Ramp solvers in planner.h for how the last two find their roots, and Ramp profiles
+ *  for the ramp (head or tail) each one is passed.
  *
  *  The get_target functions know 3 things and return the 4th:
  *    Jm = maximum jerk of the move
@@ -364,6 +363,11 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
  *    Vf = final velocity
  */
 
+static inline bool _on_plateau(const float dv, const mpRamp_t* ramp)    // true if a ramp by dv holds its acceleration
+{
+    return ((ramp->dv_plateau > 0) && (dv > ramp->dv_plateau));
+}
+
 /*
  * mp_get_target_length()   - find accel/decel length from delta V and jerk
  */
@@ -371,28 +375,35 @@ void mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float ent
 // Just calling this tl_constant. It's full name is:
 // static const float tl_constant = 1.201405707067378;                     // sqrt(5)/( sqrt(2)pow(3,4) )
 
-float mp_get_target_length(const float v_0, const float v_1, const mpBuf_t* bf) 
+float mp_get_target_length(const float v_0, const float v_1, const mpRamp_t* ramp)
 {
-    const float q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
-    return q_recip_2_sqrt_j * sqrt(fabs(v_1 - v_0)) * (v_1 + v_0);
+    const float dv = fabs(v_1 - v_0);
+    if (_on_plateau(dv, ramp)) {
+        return (ramp->plateau_k * (dv + ramp->dv_plateau) * (v_1 + v_0));
+    }
+    const float q_recip_2_sqrt_j = ramp->q_recip_2_sqrt_j;
+    return q_recip_2_sqrt_j * sqrt(dv) * (v_1 + v_0);
 }
 
 /*
  * mp_get_target_velocity() - find the velocity we would achieve if we *accelerated* from v_0
  *
  * Get "the velocity" that we would end up at if we *accelerated* from v_0
- * over the provided L (length) and J (jerk, provided in the bf structure).
+ * over the provided L (length) and J (jerk, provided in the ramp structure).
+ *
+ * If that takes the ramp onto its acceleration plateau the length is a quadratic in the
+ * velocity change instead: (2 v_0 + dV)(dV + dV*) = L / plateau_k.
  */
 
 // 14 *, 1 /, 1 sqrt, 1 cbrt
 // time: 68 us
-float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t* bf) 
+float mp_get_target_velocity(const float v_0, const float L, const mpRamp_t* ramp)
 {
     if (fp_ZERO(L)) {  // handle exception case
         return (0);
     }
 
-    const float j = bf->jerk;
+    const float j = ramp->jerk;
 
     const float a80 = 7.698003589195;    // 80 * a
     const float a_2 = 0.00925925925926;  // a^2
@@ -416,6 +427,11 @@ float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t* bf)
     //          v_1 =    1/3 ((const1a v_0^2)/b  +  b const2a  -  v_0)
     const float v_1 = const3 * ((const1a * v_0_2) / b + b * const2a - v_0);
 
+    if (_on_plateau(v_1 - v_0, ramp)) {
+        const float b_p = 2 * v_0 + ramp->dv_plateau;
+        const float c_p = L / ramp->plateau_k - 2 * v_0 * ramp->dv_plateau;    // > 0 on the plateau
+        return (v_0 + (2 * c_p) / (b_p + sqrt(b_p * b_p + 4 * c_p)));           // root of dV^2 + b_p dV = c_p
+    }
     return fabs(v_1);
 }
 
@@ -424,73 +440,218 @@ float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t* bf)
  * mp_get_decel_velocity() - mp_get_target_velocity but ONLY for deceleration
  *
  * Get "the velocity" that we would end up at if we *decelerated* from v_0,
- * over the provided L (length) and J (jerk, provided in the bf structure).
+ * over the provided L (length) and J (jerk, provided in the ramp structure).
+ *
+ * There are three possible solutions. With s = sqrt(v_0 - v_1) and s = sigma sqrt(v_0)
+ * the length equation becomes sigma^3 - 2 sigma + r = 0, where r = L / (k v_0^1.5) is the
+ * share of the length it takes to stop. One root is negative, and of the two positive ones
+ * the smaller is the deceleration - it is below 0.618 for r < 1. If L is enough to stop
+ * (r >= 1) the answer is zero.
  *
- * We have to use a root finding solution, since there is actually three possible
- * solutions. We can eliminate one quickly, since it's the acceleration case.
+ * The root is seeded by interpolating _decel_sigma[] and finished by Newton steps, which
+ * need no square roots: 1 sqrt, 4 / in all.
  *
- * The other two cases are occasionally the same value, but this is rare.
- * Otherwise there is a "high" value and a "low" value. The low value can be
- * negative and then eliminated.
+ * A stop that would reach the ramp's acceleration plateau takes longer than r = 1. With
+ * p = dV* / v_0 it takes r = (1 + p) / (2 sqrt(p)), and decelerations past r = (2 - p) sqrt(p)
+ * reach the plateau too, where the length is a quadratic: (2 - D)(D + p) = 2 sqrt(p) r for
+ * D = (v_0 - v_1) / v_0. Short of that r can still be over 1, up to where the two positive
+ * roots meet at sigma = sqrt(2/3), r = (4/3) sqrt(2/3). Close to there the table is no use
+ * and the seed is the quadratic about the double root instead: sigma = sqrt(2/3) -
+ * sqrt((r_max - r) / (3 sqrt(2/3))), which lies just right of the root. The first Newton
+ * step overshoots to the left of it and the next one comes back to float precision.
  */
 
-float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t* bf) 
-{
-    const float q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
-
-    float v_1        = 0;     // start the guess at zero
-    bool  first_pass = true;  // We may invert our guess based on the first pass results.
+static const float _decel_sigma[9] = {     // smaller root of sigma^3 - 2 sigma + r, for r = 0, 1/8 .. 1
+    0.000000000, 0.062622791, 0.126000193, 0.190983006, 0.258652023,
+    0.330560157, 0.409279026, 0.500000000, 0.618033989
+};
+static const float _decel_sigma_max = 0.816496581;     // sqrt(2/3), where the positive roots meet
+static const float _decel_r_max = 1.088662108;         // (4/3) sqrt(2/3), the r at which they do
 
-    int i = 0;          // limit the iterations
-    while (i++ < 10) {  // If it fails after 10, something's wrong
-        const float sqrt_delta_v_0 = sqrt(v_0 - v_1);
-        const float l_t            = q_recip_2_sqrt_j * (sqrt_delta_v_0 * (v_1 + v_0)) - L;
-
-        if (fabs(l_t) < 0.00001) {
-            break;
+float mp_get_decel_velocity(const float v_0, const float L, const mpRamp_t* ramp)
+{
+    if (v_0 <= 0) {
+        return (0);
+    }
+    const float sqrt_v_0 = sqrt(v_0);
+    const float r = L / (ramp->q_recip_2_sqrt_j * v_0 * sqrt_v_0);
+    if (_on_plateau(v_0, ramp)) {
+        const float p = ramp->dv_plateau / v_0;
+        const float sqrt_p = sqrt(p);
+        if (r >= (1 + p) / (2 * sqrt_p)) {
+            return (0);
         }
-        // For the first pass, we tested velocity 0.
-        // If velocity 0 yields a l_t > zero, then we need to start searching
-        // at v_1 instead. (We can't start AT v_1, so we start at v_1 - 0.1.)
-        if (first_pass && (l_t > 0)) {
-            v_1 = v_0 - 0.001;
-
-            continue;
+        if (r > (2 - p) * sqrt_p) {
+            const float b = 2 + p;
+            return (v_0 * (1 - 0.5 * ((2 - p) - sqrt(b * b - 8 * sqrt_p * r))));
         }
-
-        const float v_1x3     = 3 * v_1;
-        const float recip_l_t = (2 * sqrt_delta_v_0) / ((v_0 - v_1x3) * q_recip_2_sqrt_j);
-
-        v_1 = v_1 - (l_t * recip_l_t);
+    } else if (r >= 1.0) {
+        return (0);
     }
 
-    return v_1;
+    float sigma;
+    if (r < 1.0) {
+        const float x = r * 8;
+        const uint8_t i = (uint8_t)x;                   // r < 1, so i <= 7
+        sigma = _decel_sigma[i] + (_decel_sigma[i+1] - _decel_sigma[i]) * (x - i);
+    } else {                                            // plateau ramps only
+        sigma = _decel_sigma_max - sqrt(max(_decel_r_max - r, (float)0) / (3 * _decel_sigma_max));
+    }
+    for (uint8_t n = 0; n < DECEL_NEWTON_STEPS; n++) {
+        const float sigma_2 = sigma * sigma;
+        const float slope = 3 * sigma_2 - 2;
+        if (slope > -EPSILON) {                         // at the double root, which is the answer
+            break;
+        }
+        sigma -= (sigma * (sigma_2 - 2) + r) / slope;
+    }
+    return (v_0 * (1 - sigma * sigma));
 }
 
 /*
- * _get_meet_velocity() - find intersection velocity
+ * mp_get_meet_velocity() - find intersection velocity
  *
  * This function, when given two velocities (v_0 and v_2) along with a length (L)
  * and jerk (J), will locate the velocity v_1 that will allow acceleration from v_0
  * at jerk J to v_1 and then deceleration at jerk J to v_2, all over total length L.
  *
+ * With m = max(v_0, v_2), n = min(v_0, v_2), d = m - n and v_1 = m + y^2 the head and
+ * tail lengths over k are
+ *
+ *    F(y) = y (y^2 + 2m)  +  w (w^2 + 2n)      where w = sqrt(y^2 + d)
+ *
+ * F(0) is the length of a single ramp from n to m. If L/k doesn't exceed it there is no
+ * meet velocity and the whole move is a head or a tail. Otherwise F is convex and
+ * increasing, so Newton converges from any seed - from below the first step lands above
+ * the root and it comes down from there. Expanding the ramp from n to second order,
+ * F(y) ~ F(0) + 2my + ay^2 with a = 1.5 sqrt(d) + n / sqrt(d), gives the seed while the
+ * cubic terms are small. Past that F(y) >= y^3 + 2my + F(0) gives an upper bound.
+ *
+ * Per iteration: 1 sqrt, 1 /, about 15 * and +
+ *
+ * When the head and tail ramps differ (S-curve ramps, see Ramp profiles) _get_ramp_meet_velocity()
+ * runs the same iteration on the lengths themselves - each ramp is convex and increasing in its
+ * own y or w, and so is their sum.
+ */
+
+static float _cubic_root(const float p, const float q)  // real root of y^3 + p y = q, for p,q >= 0
+{
+    const float p_3 = p * 0.333333333333333;
+    const float t = cbrtf(q * 0.5 + sqrt(q * q * 0.25 + p_3 * p_3 * p_3));
+    const float t_2 = t * t;
+    return (q / (t_2 + p_3 + (p_3 * p_3) / t_2));      // Cardano's t - p/3t without the cancellation
+}
+
+// length of a ramp from u by x^2, and its slope in x
+static float _get_ramp_length(const float x, const float u, const mpRamp_t* ramp, float* slope)
+{
+    const float x_2 = x * x;
+    if (_on_plateau(x_2, ramp)) {
+        *slope = ramp->plateau_k * 2 * x * (2 * (x_2 + u) + ramp->dv_plateau);
+        return (ramp->plateau_k * (x_2 + 2 * u) * (x_2 + ramp->dv_plateau));
+    }
+    *slope = ramp->q_recip_2_sqrt_j * (3 * x_2 + 2 * u);
+    return (ramp->q_recip_2_sqrt_j * x * (x_2 + 2 * u));
+}
+
+/*
+ * _get_ramp_meet_velocity() - mp_get_meet_velocity() for head and tail ramps that differ
+ *
+ *  The ramp from m is k_m y (y^2 + 2m) long and the one from n is k_n w (w^2 + 2n), or longer
+ *  past their plateaus. Either way F(y) >= K y^3 + P y with K = k_m + k_n and P = 2 (k_m m + k_n n),
+ *  and F(y) >= F(0) + k_m (y^3 + 2my), so the smaller of the two cube roots is above the root
+ *  and Newton comes straight down from it. Past their plateaus the lengths are a quadratic in
+ *  z = y^2. Its root is never above the real one (the tangent is above the square root), so if
+ *  it is on both plateaus it is the root.
  */
 
-static float _get_meet_velocity(const float          v_0,
-                                const float          v_2,
-                                const float          L,
-                                mpBuf_t*             bf,
-                                mpBlockRuntimeBuf_t* block) 
+static float _get_ramp_meet_velocity(const float          v_0,
+                                     const float          v_2,
+                                     const float          L,
+                                     mpBuf_t*             bf,
+                                     mpBlockRuntimeBuf_t* block)
 {
-    const float q_recip_2_sqrt_j = bf->q_recip_2_sqrt_j;
+    const mpRamp_t* ramp_m = (v_0 > v_2) ? &bf->head : &bf->tail;  // the ramp from the higher velocity
+    const mpRamp_t* ramp_n = (v_0 > v_2) ? &bf->tail : &bf->head;
+    const float m = max(v_0, v_2);
+    const float n = min(v_0, v_2);
+    const float d = m - n;
+    float slope_m;
+    float slope_n;
+
+    bf->meet_iterations = 0;
+
+    const float F_0 = _get_ramp_length(sqrt(d), n, ramp_n, &slope_n);
+    if (F_0 >= L) {
+        // Case (2) - all head or all tail, see mp_get_meet_velocity()
+        block->body_length = 0;
+        if (v_0 < v_2) {
+            block->head_length = L;
+            block->tail_length = 0;
+            return (mp_get_target_velocity(v_0, L, &bf->head));
+        }
+        block->head_length = 0;
+        block->tail_length = L;
+        return (mp_get_target_velocity(v_2, L, &bf->tail));
+    }
 
-    // v_1 can never be smaller than v_0 or v_2, so we keep track of this value
-    const float min_v_1 = max(v_0, v_2);
+    // Case (3) - seed from above, then Newton
+    const float k_m = ramp_m->q_recip_2_sqrt_j;
+    const float k_n = ramp_n->q_recip_2_sqrt_j;
+    const float K = k_m + k_n;
+    float y = min(_cubic_root(2 * (k_m * m + k_n * n) / K, L / K), _cubic_root(2 * m, (L - F_0) / k_m));
+
+    if ((ramp_m->plateau_k > 0) && (ramp_n->plateau_k > 0)) {
+        // plateau lengths in z = y^2: a z^2 + b z + c = L
+        const float a = ramp_m->plateau_k + ramp_n->plateau_k;
+        const float b = ramp_m->plateau_k * (2 * m + ramp_m->dv_plateau) +
+                        ramp_n->plateau_k * (2 * (n + d) + ramp_n->dv_plateau);
+        const float c = ramp_m->plateau_k * 2 * m * ramp_m->dv_plateau +
+                        ramp_n->plateau_k * (d + 2 * n) * (d + ramp_n->dv_plateau) - L;
+        if (c < 0) {
+            const float z = (-2 * c) / (b + sqrt(b * b - 4 * a * c));
+            if ((z >= ramp_m->dv_plateau) && ((z + d) >= ramp_n->dv_plateau)) {
+                y = sqrt(z);                            // both ramps are on their plateaus
+            }
+        }
+    }
 
-    // v_1 is our estimated return value.
-    // We estimate with the speed obtained by L/2 traveled from the highest speed of v_0 or v_2.
-    float v_1 = mp_get_target_velocity(min_v_1, L / 2.0, bf);
-    // var v_1 = min_v_1 + 100;
+    float w = sqrt(y * y + d);
+    while (true) {
+        const float error = _get_ramp_length(y, m, ramp_m, &slope_m) + _get_ramp_length(w, n, ramp_n, &slope_n) - L;
+        if ((fabs(error) <= L * MEET_TOLERANCE) || (bf->meet_iterations >= MEET_ITERATIONS_MAX)) {
+            break;
+        }
+        bf->meet_iterations++;
+        y -= (error * w) / (slope_m * w + slope_n * y);
+        w  = sqrt(y * y + d);
+    }
+
+    const float l_m = _get_ramp_length(y, m, ramp_m, &slope_m);
+    const float l_n = _get_ramp_length(w, n, ramp_n, &slope_n);
+    block->head_length = (v_0 > v_2) ? l_m : l_n;
+    block->tail_length = (v_0 > v_2) ? l_n : l_m;
+    block->body_length = 0;
+
+    const float l_c = (block->head_length + block->tail_length) - L;
+    if (l_c < 0.0) {
+        block->body_length = -l_c;                      // Case (3a)
+    } else {
+        block->tail_length = L - block->head_length;    // Case (3b)
+    }
+    return (m + y * y);
+}
+
+float mp_get_meet_velocity(const float          v_0,
+                           const float          v_2,
+                           const float          L,
+                           mpBuf_t*             bf,
+                           mpBlockRuntimeBuf_t* block)
+{
+    if (bf->ramp_profile == RAMP_SCURVE) {
+        return (_get_ramp_meet_velocity(v_0, v_2, L, bf, block));
+    }
+    const float q_recip_2_sqrt_j = bf->head.q_recip_2_sqrt_j;
 
     if (fp_EQ(v_0, v_2)) {
         // Case (1)
@@ -503,91 +664,71 @@ static float _get_meet_velocity(const float          v_0,
 
         bf->meet_iterations = -1;
 
-        return v_1;
+        return (mp_get_target_velocity(max(v_0, v_2), L / 2.0, &bf->head));
     }
 
-    // Per iteration: 2 sqrt, 2 abs, 6 -, 4 +, 12 *, 3 /
-    int i = 0;          // limit the iterations // 466us - 644us
-    while (i++ < 30) {  // If it fails after 30, something's wrong
-        if (v_1 < min_v_1) {
-            // Case (2)
-            // We have caught a rather nasty problem. There is no meet velocity.
-            // This is due to an inversion in the velocities of very short moves.
-            // We need to compute the head OR tail length, and the body will be the rest.
-            // Yes, that means we're computing a cruise in here.
-
-            v_1 = min_v_1;
-
-            if (v_0 < v_2) {
-                // acceleration - it'll be a head/body
-                block->head_length = mp_get_target_length(v_0, v_2, bf);
-                if (block->head_length > L) {
-                    block->head_length = L;
-                    block->body_length = 0;
-                    v_1                = mp_get_target_velocity(v_0, L, bf);
-                } else {
-                    block->body_length = L - block->head_length;
-                }
-                block->tail_length = 0;
-
-            } else {
-                // deceleration - it'll be tail/body
-                block->tail_length = mp_get_target_length(v_2, v_0, bf);
-                if (block->tail_length > L) {
-                    block->tail_length = L;
-                    block->body_length = 0;
-                    v_1                = mp_get_target_velocity(v_2, L, bf);
-                } else {
-                    block->body_length = L - block->tail_length;
-                }
-                block->head_length = 0;
-            }
-
-            break;
-        }
+    const float m = max(v_0, v_2);
+    const float n = min(v_0, v_2);
+    const float d = m - n;
+    const float T = L * bf->head.sqrt_j * 0.83235829006;   // L/k, where 1/k = 2 sqrt(J) / q
+    const float sqrt_d = sqrt(d);
+    const float F_0 = sqrt_d * (m + n);                 // ramp from n to m, over k
 
-        // Precompute some common chunks -- note that some attempts may have v_1 < v_0 or v_1 < v_2
-        const float sqrt_delta_v_0 = sqrt(fabs(v_1 - v_0));
-        const float sqrt_delta_v_2 = sqrt(fabs(v_1 - v_2));  // 849us
+    bf->meet_iterations = 0;
 
-        // l_c is our total-length calculation with the current v_1 estimate, minus the expected length.
-        // This makes l_c == 0 when v_1 is the correct value.
-
-        // GAMBLE: At the cost of one more multiply per iteration, we will keep the two length calculations seperate.
-        // This allows us to store the resulting head/tail lengths.
-        const float l_h = q_recip_2_sqrt_j * (sqrt_delta_v_0 * (v_1 + v_0));
-        const float l_t = q_recip_2_sqrt_j * (sqrt_delta_v_2 * (v_1 + v_2));
-        const float l_c = (l_h + l_t) - L;
-
-        block->head_length = l_h;
-        block->tail_length = l_t;
+    if (F_0 >= T) {
+        // Case (2)
+        // There is no meet velocity - the move is too short to even ramp from one velocity
+        // to the other. It's all head (or all tail) and ends short of the higher velocity.
         block->body_length = 0;
+        if (v_0 < v_2) {
+            block->head_length = L;
+            block->tail_length = 0;
+            return (mp_get_target_velocity(v_0, L, &bf->head));
+        }
+        block->head_length = 0;
+        block->tail_length = L;
+        return (mp_get_target_velocity(v_2, L, &bf->head));
+    }
 
-        // We need this level of precision, or our length computations fail to match the block length.
-        // What we really want to ensure is that the two lengths down add up to be too much.
-        // We can be a little under (and have a small body).
-
-        // TODO: make these tunable
-        if ((l_c < 0.00001) && (l_c > -1.0)) {  // allow 0.00001 overlap, OR up to a 1mm gap
-            if (l_c < 0.0) {
-                // Case (3a)
-                block->body_length = -l_c;
-            } else {
-                // Case (3b)
-                // fix the overlap
-                block->tail_length = L - block->head_length;
-            }
+    // Case (3) - seed, then Newton
+    const float R = T - F_0;
+    const float a = 1.5 * sqrt_d + n / sqrt_d;
+    float y = R / (m + sqrt(m * m + a * R));            // root of ay^2 + 2my = R without the cancellation
+    if ((y * y) > (m * MEET_CUBIC_SEED)) {
+        y = min(R / (2 * m), _cubic_root(2 * m, R));
+    }
+    float y_2 = y * y;
+    float w   = sqrt(y_2 + d);
+    float w_2 = w * w;
+    while (true) {
+        const float error = y * (y_2 + 2 * m) + w * (w_2 + 2 * n) - T;
+        if ((fabs(error) <= T * MEET_TOLERANCE) || (bf->meet_iterations >= MEET_ITERATIONS_MAX)) {
             break;
         }
-
-        const float v_1x3     = 3 * v_1;
-        const float recip_l_d = (2 * sqrt_delta_v_0 * sqrt_delta_v_2) /
-                                ((sqrt_delta_v_0 * (v_1x3 - v_2) - (v_0 - v_1x3) * sqrt_delta_v_2) * q_recip_2_sqrt_j);
-
-        v_1 = v_1 - (l_c * recip_l_d);
+        bf->meet_iterations++;
+        y  -= (error * w) / (w * (3 * y_2 + 2 * m) + y * (3 * w_2 + 2 * n));
+        y_2 = y * y;
+        w   = sqrt(y_2 + d);
+        w_2 = w * w;
     }
 
-    bf->meet_iterations = i;
+    // The ramp from m is y(y^2 + 2m) long and the one from n is w(w^2 + 2n). What's left
+    // of L is body - or, if the lengths come out a hair long, it's taken off the tail.
+    const float l_m = q_recip_2_sqrt_j * y * (y_2 + 2 * m);
+    const float l_n = q_recip_2_sqrt_j * w * (w_2 + 2 * n);
+    block->head_length = (v_0 > v_2) ? l_m : l_n;
+    block->tail_length = (v_0 > v_2) ? l_n : l_m;
+    block->body_length = 0;
 
-    return v_1;
+    const float l_c = (block->head_length + block->tail_length) - L;
+    if (l_c < 0.0) {
+        // Case (3a)
+        block->body_length = -l_c;
+    } else {
+        // Case (3b)
+        // fix the overlap
+        block->tail_length = L - block->head_length;
+    }
+    return (m + y_2);
 }
@@ -68,6 +68,9 @@
 mpBufferPool_t mb;                  // buffer pool management
 mpMotionPlannerSingleton_t mp;      // context for block planning
 mpMotionRuntimeSingleton_t mr;      // context for block runtime
+#if (PLANNER_BENCHMARK_ENABLED == true)
+mpPlannerBenchmark_t mp_bench;      // benchmark counters
+#endif
 
 #define JSON_COMMAND_BUFFER_SIZE 3
 
@@ -121,10 +124,12 @@ _json_commands_t jc;
 
 // Local Scope Data and Functions
 #define spindle_speed block_time    // local alias for spindle_speed to the time variable
-#define value_vector gm.target      // alias for vector of values
+#define value_vector gm->target     // alias for vector of values
 
 //static void _planner_time_accounting();
+static uint8_t _modal_states_available();
 static void _audit_buffers();
+static bool _lookahead_is_full();
 
 // Execution routines (NB: These are called from the LO interrupt)
 static void _exec_json_command(float *value, bool *flag);
@@ -244,6 +249,7 @@ void mp_set_steps_to_runtime_position()
         mr.position_steps[motor] = step_position[motor];
         mr.commanded_steps[motor] = step_position[motor];
         en_set_encoder_steps(motor, step_position[motor]);  // write steps to encoder register
+        st_pre.mot[motor].step_position = (int32_t)round(step_position[motor]); // whole step, as the encoder
         mr.encoder_steps[motor] = en_read_encoder(motor);
 
         // These must be zero:
@@ -286,9 +292,9 @@ void mp_queue_command(void(*cm_exec)(float[], bool[]), float *value, bool *flag)
     bf->bf_func = _exec_command;      // callback to planner queue exec function
     bf->cm_func = cm_exec;            // callback to canonical machine exec function
 
-    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
-        bf->value_vector[axis] = value[axis];
-        bf->axis_flags[axis] = flag[axis];
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {    // callbacks that take no arguments pass NULL
+        bf->value_vector[axis] = (value != NULL) ? value[axis] : 0;
+        bf->axis_flags[axis] = (flag != NULL) ? flag[axis] : false;
     }
     mp_commit_write_buffer(BLOCK_TYPE_COMMAND);     // must be final operation before exit
 }
@@ -391,7 +397,7 @@ static stat_t _exec_json_wait(mpBuf_t *bf)
     jc.free_buffer();
 
     if (mp_free_run_buffer()) {
-        cm_cycle_end();                                    // free buffer & perform cycle_end if planner is empty
+        st_prep_cycle_end();                               // free buffer & perform cycle_end once the steppers are idle
     }
     return (STAT_OK);
 }
@@ -423,7 +429,7 @@ static stat_t _exec_dwell(mpBuf_t *bf)
 {
     st_prep_dwell((uint32_t)(bf->block_time * 1000000.0));// convert seconds to uSec
     if (mp_free_run_buffer()) {
-        cm_cycle_end();                 // free buffer & perform cycle_end if planner is empty
+        st_prep_cycle_end();            // free buffer & perform cycle_end after the dwell
     }
     return (STAT_OK);
 }
@@ -455,8 +461,17 @@ uint8_t mp_get_planner_buffers()
 
 bool mp_planner_is_full()
 {
-    // We also need to ensure we have room for another JSON command
-    return ((mb.buffers_available < PLANNER_BUFFER_HEADROOM) || (jc.available == 0));
+    // We also need to ensure we have room for another JSON command and Gcode state
+    if ((mb.buffers_available < PLANNER_BUFFER_HEADROOM) || (jc.available == 0) ||
+        (_modal_states_available() < PLANNER_MODAL_HEADROOM)) {
+        return (true);
+    }
+#if (PLANNER_TIME_LOOKAHEAD == true)
+    // queued time only drains while the runtime is moving, so don't wait on it otherwise
+    return (st_runtime_isbusy() && _lookahead_is_full());
+#else
+    return (false);
+#endif
 }
 
 bool mp_has_runnable_buffer()
@@ -472,6 +487,22 @@ bool mp_is_phat_city_time()
     return ((mp.plannable_time <= 0.0) || (PHAT_CITY_TIME < mp.plannable_time));
 }
 
+/*
+ * _lookahead_is_full() - true if PLANNER_LOOKAHEAD_MS of motion is queued (time look-ahead mode)
+ *
+ *  The exec only ever adds to dequeued_usec and the main loop to queued_usec, so the
+ *  difference can be taken without disabling interrupts. Unsigned arithmetic handles wrap.
+ */
+
+static bool _lookahead_is_full()
+{
+#if (PLANNER_TIME_LOOKAHEAD == true)
+    return ((uint32_t)(mp.queued_usec - mp.dequeued_usec) >= (uint32_t)(PLANNER_LOOKAHEAD_MS * 1000));
+#else
+    return (false);
+#endif
+}
+
 /*
  * mp_planner_callback()
  *
@@ -531,7 +562,7 @@ stat_t mp_planner_callback()
         mp.planner_state = PLANNER_STARTUP;
     }
     if (mp.planner_state == PLANNER_STARTUP) {
-        if (!mp_planner_is_full() && !_timed_out) {
+        if (!mp_planner_is_full() && !_lookahead_is_full() && !_timed_out) {
             return (STAT_OK);                       // remain in STARTUP
         }
         mp.planner_state = PLANNER_PRIMING;
@@ -594,6 +625,7 @@ void mp_start_feed_override(const float ramp_time, const float override_factor)
     mp.mfo_active = true;
 
     if (fp_NOT_ZERO(mp.ramp_dvdt)) {    // do these things only if you actually have a ramp to run
+        mp.dirty = NULL;                // replan from mp.c, which priming marks dirty
         mp.p = mp.c;                    // re-position the planner pointer
         mp.ramp_active = true;
         mp.request_planning = true;
@@ -716,8 +748,8 @@ void mp_planner_time_accounting()
 // Also clears unlocked, so the buffer cannot be used
 static inline void _clear_buffer(mpBuf_t *bf)
 {
-    // Note: bf->bf_func is the first address we wish to clear as we must preserve
-    // the pointers and buffer number during interrupts
+    // Note: reset() must preserve the ring and cold state pointers and the buffer number
+    // during interrupts
 
     // We'll have to figure something else out for C, sorry.
     bf->reset();
@@ -735,6 +767,8 @@ void mp_init_buffers(void)
     mb.r = &mb.bf[0];
     pv = &mb.bf[PLANNER_BUFFER_POOL_SIZE-1];
     for (uint8_t i=0; i < PLANNER_BUFFER_POOL_SIZE; i++) {
+        mb.bf[i].gm = &mb.cold[i].gm;               // bind the cold state before clearing it
+        mb.bf[i].arc = &mb.cold[i].arc;
         _clear_buffer(&mb.bf[i]);
         uint8_t nx_i = ((i<(PLANNER_BUFFER_POOL_SIZE-1))?(i+1):0); // buffer incr & wrap
 
@@ -747,6 +781,16 @@ void mp_init_buffers(void)
         pv = &mb.bf[i];
     }
     mb.buffers_available = PLANNER_BUFFER_POOL_SIZE;
+    mp.queued_usec = 0;
+    mp.dequeued_usec = 0;
+    mp.dirty = NULL;
+
+    // flushed blocks no longer hold Gcode states - keep the newest, next to the runtime's
+    if (mp.modal_seq != mr.modal_seq) {
+        uint16_t seq = mr.modal_seq + 1;
+        mp.modal[seq % PLANNER_MODAL_STATES] = mp.modal[mp.modal_seq % PLANNER_MODAL_STATES];
+        mp.modal_seq = seq;
+    }
 
 //    mb.entry_changed = false;
 
@@ -801,10 +845,13 @@ void mp_commit_write_buffer(const blockType block_type)
     mb.w->block_type = block_type;
     mb.w->block_state = BLOCK_INITIAL_ACTION;
 
-    if (block_type == BLOCK_TYPE_ALINE) {
+    if (mp_block_is_move(mb.w)) {
         if (cm.motion_state == MOTION_STOP) {
             cm_set_motion_state(MOTION_PLANNING);
         }
+        mb.w->queued_usec = (uint32_t)(mb.w->block_time * 60000000);   // minutes to microseconds
+        mp.queued_usec += mb.w->queued_usec;
+        BENCH_ADD(length, mb.w->length);
     } else {
         if ((mp.planner_state > PLANNER_STARTUP) && (cm.hold_state == FEEDHOLD_OFF)) {
             // NB: BEWARE! the exec may result in the planner buffer being
@@ -813,6 +860,7 @@ void mp_commit_write_buffer(const blockType block_type)
         }
     }
     mb.w->plannable = true;                     // enable block for planning
+    BENCH_COUNT(blocks);
     mp.request_planning = true;
     mb.w = mb.w->nx;                            // advance write buffer pointer
     mp.block_timeout.set(BLOCK_TIMEOUT_MS);     // reset the block timer
@@ -839,6 +887,7 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
 
     mpBuf_t *r = mb.r;
     mb.r = mb.r->nx;                // advance to next run buffer
+    mp.dequeued_usec += r->queued_usec;
     _clear_buffer(r);               // clear it out (& reset unlocked and set MP_BUFFER_EMPTY)
 
     mb.buffers_available++;
@@ -846,11 +895,60 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
     return (mb.w == mb.r);          // return true if the queue emptied
 }
 
+/************************************************************************************
+ * mp_get_modal_state()       - return the state table entry for the rest of gm, adding one if needed
+ * _modal_state_changed()     - true if gm differs from the entry in anything a block doesn't carry
+ * _modal_states_available()  - free entries in the state table
+ *
+ *  See Gcode state table in planner.h. Entries from mr.modal_seq to mp.modal_seq are in use,
+ *  mr.modal_seq being written by the runtime as it starts each block. Availability is checked
+ *  upstream by mp_planner_is_full(), so running out here is a panic like running out of buffers.
+ */
+
+static bool _modal_state_changed(const GCodeState_t *gm, const GCodeState_t *entry)
+{
+    // parameter (P) is left out - it is only used by the dwell that set it
+    return ((gm->select_plane != entry->select_plane) || (gm->units_mode != entry->units_mode) ||
+            (gm->distance_mode != entry->distance_mode) || (gm->arc_distance_mode != entry->arc_distance_mode) ||
+            (gm->absolute_override != entry->absolute_override) || (gm->coord_system != entry->coord_system) ||
+            (gm->tool_select != entry->tool_select) ||
+            fp_NE(gm->path_tolerance, entry->path_tolerance) || fp_NE(gm->merge_tolerance, entry->merge_tolerance) ||
+            (memcmp(gm->work_offset, entry->work_offset, sizeof(gm->work_offset)) != 0));
+}
+
+static uint8_t _modal_states_available()
+{
+    return (PLANNER_MODAL_STATES - 1 - (uint16_t)(mp.modal_seq - mr.modal_seq));
+}
+
+stat_t mp_get_modal_state(const GCodeState_t *gm, uint16_t *seq)
+{
+    if (_modal_state_changed(gm, &mp.modal[mp.modal_seq % PLANNER_MODAL_STATES])) {
+        if (_modal_states_available() == 0) {
+            return (cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_get_modal_state()"));
+        }
+        mp.modal_seq++;
+        mp.modal[mp.modal_seq % PLANNER_MODAL_STATES] = *gm;
+    }
+    *seq = mp.modal_seq;
+    return (STAT_OK);
+}
+
 /* UNUSED FUNCTIONS - left in for completeness and for reference
 void mp_copy_buffer(mpBuf_t *bf, const mpBuf_t *bp)
 {
-    // copy contents of bp to by while preserving pointers in bp
-    memcpy((void *)(&bf->bf_func), (&bp->bf_func), sizeof(mpBuf_t) - (sizeof(void *) * 2));
+    // copy contents of bp to bf while preserving the links, cold pointers and number of bf
+    mpBuf_t *pv = bf->pv, *nx = bf->nx;
+    mpMotionState_t *gm = bf->gm;
+    mpArcGeometry_t *arc = bf->arc;
+    uint8_t buffer_number = bf->buffer_number;
+
+    *bf = *bp;
+    bf->pv = pv; bf->nx = nx;
+    bf->gm = gm; bf->arc = arc;
+    bf->buffer_number = buffer_number;
+    *bf->gm = *bp->gm;
+    *bf->arc = *bp->arc;
 }
 */
 
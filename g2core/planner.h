@@ -77,13 +77,15 @@
  *
  * The planner is entered by calling one of:
  *  - mp_aline()         - plan and queue a move with acceleration management
+ *  - mp_arc()           - plan and queue an arc or helix as a single move (see plan_arc.cpp)
  *  - mp_dwell()         - plan and queue a pause (dwell) to the planner queue
  *  - mp_queue_command() - queue a canned command
  *  - mp_json_command()  - queue a JSON command for run-time interpretation and execution (M100)  
  *  - mp_json_wait()     - queue a JSON wait for run-time interpretation and execution (M101)
  *  - 
- * In addition, cm_arc_feed() valaidates and sets up a arc paramewters and calls mp_aline() 
- * repeatedly to spool out the arc segments into the planner queue.
+ * In addition, cm_arc_feed() valaidates and sets up a arc paramewters and calls mp_arc(),
+ * or - if the arc can't be run natively - calls mp_aline() repeatedly to spool out the arc
+ * segments into the planner queue.
  *
  * All the above queueing commands other than mp_aline() are relatively trivial; they just
  * post callbacks into the next available planner buffer. Command functions are in 2 parts: 
@@ -182,7 +184,8 @@ typedef enum {                      // bf->buffer_state values in incresing orde
 typedef enum {                      // bf->block_type values
     BLOCK_TYPE_NULL = 0,            // MUST=0  null move - does a no-op
     BLOCK_TYPE_ALINE = 1,           // MUST=1  acceleration planned line
-    BLOCK_TYPE_COMMAND = 2,         // MUST=2  general command
+    BLOCK_TYPE_ARC = 2,             // MUST=2  acceleration planned arc or helix (see mp_arc())
+    BLOCK_TYPE_COMMAND = 3,         // MUST=3  general command. Everything from here on is a command
     BLOCK_TYPE_DWELL,               // Gcode dwell
     BLOCK_TYPE_JSON_WAIT,           // JSON wait command
     BLOCK_TYPE_TOOL,                // T command (T, not M6 tool change)
@@ -241,24 +244,230 @@ typedef enum {
     ZOID_EXIT_3a2
 } zoidExitPoint;
 
+typedef enum {                      // cm.ramp_profile and bf->ramp_profile values - see Ramp profiles
+    RAMP_QUINTIC = 0,               // quintic Bezier velocity - jerk rises and falls smoothly (default)
+    RAMP_SCURVE                     // 7 segment S-curve - constant jerk, optional constant acceleration
+} rampProfile;
+
 /*** Most of these factors are the result of a lot of tweaking. Change with caution.***/
 
+/* Planner look-ahead
+ *
+ *  The planner can only plan as far ahead as the blocks in the queue, so the pool size sets
+ *  the look-ahead. 48 blocks is plenty for long moves, but dense CAM output (sub-millimeter
+ *  segments) fills the pool with only a few milliseconds of motion and the machine slows
+ *  down to be able to stop within what it can see. Boards with RAM to spare can set a larger
+ *  PLANNER_BUFFER_POOL_SIZE in hardware.h.
+ *
+ *  A large pool also lets long moves queue many seconds of motion, which is latency for
+ *  anything that has to replan the queue. With PLANNER_TIME_LOOKAHEAD the planner also
+ *  reports full once PLANNER_LOOKAHEAD_MS of motion is queued, so look-ahead is sized by
+ *  time rather than block count: short segments use as much of the pool as they need, long
+ *  moves stop at the look-ahead time. Motion starts (STARTUP ends) once the look-ahead time
+ *  is queued. The queued time is the sum of each block's minimum time (length / cruise_vmax),
+ *  which includes the running block and underestimates moves that never reach cruise, so
+ *  PLANNER_LOOKAHEAD_MS must be well over the time the machine needs to stop. The posix-sim
+ *  benchmark (--bench, see posix_bench.h) shows the feed rates a setting achieves.
+ */
+#ifndef PLANNER_BUFFER_POOL_SIZE
 #define PLANNER_BUFFER_POOL_SIZE    (48)                // Suggest 12 min. Limit is 255
+#endif
+#if (PLANNER_BUFFER_POOL_SIZE < 12) || (PLANNER_BUFFER_POOL_SIZE > 255)
+#error PLANNER_BUFFER_POOL_SIZE must be between 12 and 255
+#endif
 #define PLANNER_BUFFER_HEADROOM     (4)                 // Buffers to reserve in planner before processing new input line
+
+#ifndef PLANNER_MODAL_STATES
+#define PLANNER_MODAL_STATES        (8)                 // Gcode state table entries - see Gcode state table
+#endif
+#if (PLANNER_MODAL_STATES < 4) || (PLANNER_MODAL_STATES > 128) || (PLANNER_MODAL_STATES & (PLANNER_MODAL_STATES - 1))
+#error PLANNER_MODAL_STATES must be a power of 2 between 4 and 128
+#endif
+#define PLANNER_MODAL_HEADROOM      (2)                 // table entries to reserve before processing new input line
+
+#ifndef PLANNER_TIME_LOOKAHEAD
+#define PLANNER_TIME_LOOKAHEAD      false               // {true, false}
+#endif
+#ifndef PLANNER_LOOKAHEAD_MS
+#define PLANNER_LOOKAHEAD_MS        ((float)2000.0)     // queued motion that fills the planner in time look-ahead mode
+#endif
 #define JERK_MULTIPLIER             ((float)1000000)    // DO NOT CHANGE - must always be 1 million
+#define ACCEL_MULTIPLIER            ((float)1000)       // axis acceleration limits are set in mm/min^2 / 1000
+#define SCURVE_JERK_FACTOR          ((float)1.44337567297) // q^2/4 = 10/(4 sqrt(3)) - see Ramp profiles
+
+#define DECEL_JERK_RATIO_MIN        (0.1)               // minimum allowable setting
+#define DECEL_JERK_RATIO_MAX        (10.0)              // maximum allowable setting
 
 #define JUNCTION_INTEGRATION_MIN    (0.05)              // minimum allowable setting
 #define JUNCTION_INTEGRATION_MAX    (5.00)              // maximum allowable setting
 
+/* Arc curvature junction limit
+ *
+ *  With ARC_CURVATURE_JUNCTION_LIMIT the junctions on either side of an arc block are also
+ *  limited by the step in centripetal acceleration, not just by the change in direction
+ *  (formula 5 in _calculate_junction_vmax()). It is off by default. An arc is already held
+ *  to its centripetal jerk (_calculate_arc_vmax()), and with the extra limit native arcs ran
+ *  slower than the same arcs chopped into lines - 5.4% on the star bench program.
+ */
+#ifndef ARC_CURVATURE_JUNCTION_LIMIT
+#define ARC_CURVATURE_JUNCTION_LIMIT false              // {true, false}
+#endif
+
+#define ARC_JOINT_CHORD_RADIANS     ((float)0.15)       // arc joint lengths are sampled on chords this long
+#define ARC_JOINT_CHORDS_MAX        (24)                // ...but on no more chords than this
+
 #define MIN_SEGMENT_MS              ((float)0.75)       // minimum segment milliseconds
 #define NOM_SEGMENT_MS              ((float)1.5)        // nominal segment ms (at LEAST MIN_SEGMENT_MS * 2)
 #define MIN_BLOCK_MS                ((float)1.5)        // minimum block (whole move) milliseconds
 #define BLOCK_TIMEOUT_MS            ((float)30.0)       // MS before deciding there are no new blocks arriving
 #define PHAT_CITY_MS                ((float)100.0)      // if you have at least this much time in the planner
 
+/* Corner blending
+ *
+ *  In G64 with a P tolerance mp_aline() rounds the corner between two feed lines with a
+ *  tangent arc block that comes no further than P from the corner. The previous line is
+ *  cut back to where the arc starts, and the new line starts where it ends. The arc takes
+ *  no more than half of the new line, and leaves enough of the previous line (whose start
+ *  may already have been blended) to run at the feed rate in MIN_BLOCK_TIME. With the lines
+ *  tangent to the arc their junctions have no change in direction (see Arc curvature
+ *  junction limit), and the arc is limited by its centripetal jerk, so sharp polyline
+ *  corners from CAM run much faster.
+ *
+ *  Only corners in one of the XY, XZ or YZ planes are blended, and only while the previous
+ *  line can still be changed: not running or forward planned, and at least BLEND_MIN_QUEUED
+ *  moves behind the running block so the exec can't reach it while it is being cut back.
+ *  This is checked again right before the line is written (see _line_can_change()). The arc
+ *  is queued before mp_aline() takes the new line, which is always long enough to be queued.
+ *  Corners straighter than BLEND_MIN_ANGLE need no blend; blends shorter than BLEND_MIN_LENGTH
+ *  are not worth a block, and no line is cut shorter than that. Every blend adds a block that
+ *  starts and ends without acceleration, so the arc must be at least BLEND_MIN_GAIN times as
+ *  fast as the corner it replaces (a corner at the feed rate costs nothing).
+ */
+#define BLEND_MIN_QUEUED            (2)                 // unplanned moves between the runtime and a blended line
+#define BLEND_MIN_ANGLE             ((float)0.01)       // radians
+#define BLEND_MIN_LENGTH            ((float)0.01)       // mm
+#define BLEND_MIN_GAIN              ((float)4.0)        // blend arc vmax over corner junction vmax
+
+/* Collinear merging
+ *
+ *  CAM output often has long runs of short, nearly collinear lines. In G64 with a Q (or P)
+ *  tolerance mp_aline() extends the last line queued to the new target instead of queuing
+ *  another block if the corner between them is within Q of the merged line, and the two
+ *  lines have the same feed and Gcode state. Runs merge into one block as long as the sum
+ *  of the deviations stays within Q - a bound on how far any of the merged corners can be
+ *  from the merged line. This saves a planner buffer per line and the planning of a block,
+ *  and makes the look-ahead reach further in the same number of buffers.
+ *
+ *  Merging a curve made of short lines turns it into a coarser polygon with sharper corners.
+ *  So the merged line may only turn away from the first and the last of the lines merged
+ *  by MERGE_TURN_SHARE of what a corner taken at the feed rate may turn.
+ *
+ *  The last line can only be changed while a blend could cut it back (see Corner blending),
+ *  and the same check is repeated before it is written. A merged line is primed and back-
+ *  planned again like a new block. It takes the line number of the last line merged, so the
+ *  line numbers of the lines merged before it are never shown as running in status reports.
+ */
+#define MERGE_TURN_SHARE            ((float)0.5)        // share of a full-feed corner the merged line may turn
+
+/* Jerk cache
+ *
+ *  A block's jerk is set by the axis whose jerk limit is smallest for its share of the move,
+ *  so it depends on the direction of the move and not just on which axes take part. The
+ *  head and tail ramp terms derived from it (see Ramp profiles) cost a divide and a square
+ *  root each on top of a divide per axis. _calculate_jerk() keeps the last set in
+ *  mp.jerk_cache, keyed on the absolute unit vector and the participating axes' jerk limits,
+ *  and copies it if the next block matches. Runs of collinear lines, single axis moves and
+ *  raster passes back and forth hit. Jerk limits changed by homing, probing or jogging simply
+ *  miss. Setting $rp, $jr or an axis acceleration limit empties the cache (mp_reset_jerk_cache()).
+ *  The hit rate and the time saved are reported by the profiler ($profc).
+ */
+
+/* Ramp solvers
+ *
+ *  Ramp lengths are L = k sqrt(|v_1 - v_0|) (v_1 + v_0), with k = q_recip_2_sqrt_j, so the
+ *  velocity reached over a given length is the root of a cubic. Acceleration has a single
+ *  real root and mp_get_target_velocity() solves it in closed form. The other two solvers run a
+ *  fixed, small number of Newton steps from a seed close enough that the count is bounded:
+ *
+ *    - mp_get_decel_velocity() substitutes sigma = sqrt((v_0 - v_1) / v_0), leaving
+ *      sigma^3 - 2 sigma + r = 0 for r = L / (k v_0^1.5) in [0,1). The root is seeded from a 9 entry
+ *      table and DECEL_NEWTON_STEPS steps take it to float precision.
+ *    - mp_get_meet_velocity() (rate-limited moves, ZOID_EXIT_3c) substitutes
+ *      y = sqrt(v_1 - max(v_0,v_2)), which makes the head plus tail length convex and increasing
+ *      in y, so Newton can't diverge or wander below max(v_0,v_2). The seed is a quadratic in y,
+ *      or a depressed cubic (one cube root) where y^2 is more than MEET_CUBIC_SEED times
+ *      max(v_0,v_2). It stops within MEET_TOLERANCE of the length or after MEET_ITERATIONS_MAX
+ *      steps, and leaves the count in bf->meet_iterations.
+ *
+ *  g2core-sim --zoid benchmarks them against the Newton iterations they replace.
+ */
+#define DECEL_NEWTON_STEPS          (2)
+#define MEET_ITERATIONS_MAX         (4)
+#define MEET_TOLERANCE              ((float)0.00001)   // fraction of the move length
+#define MEET_CUBIC_SEED             ((float)1.0)        // y^2 / max(v_0,v_2) above which the seed takes a cube root
+
+/* Ramp profiles
+ *
+ *  A head or tail ramps velocity from v_0 to v_1 along one of two shapes, set by $rp:
+ *
+ *    - RAMP_QUINTIC (0) is a quintic Bezier curve with zero acceleration and jerk at both
+ *      ends (see _init_forward_diffs()). Its peak jerk J is reached only at the ends of the
+ *      ramp, and it takes T = 2 sqrt(dV) k with k = q/(2 sqrt(J)), q = sqrt(10)/3^(1/4).
+ *    - RAMP_SCURVE (1) runs at constant jerk: J up to peak acceleration and -J back down,
+ *      which is the classic 7 segment profile counting the body. It takes T = 2 sqrt(dV/J),
+ *      so it is k = 1/sqrt(J) - the quintic for a jerk of J q^2/4 (SCURVE_JERK_FACTOR) - and
+ *      reaches cruise about 17% sooner for the same axis jerk limits. The tail may use a
+ *      different jerk from the head: $jr times the head's. With axis acceleration limits
+ *      (xac..cac, 0 = none) the acceleration is held at the block's limit A for ramps
+ *      above dV* = A^2/J, the dv_plateau of the ramp.
+ *
+ *  Every ramp is point symmetric about its middle, so it is L = k g(dV) (v_0 + v_1) long and
+ *  takes 2L / (v_0 + v_1), where g(dV) = sqrt(dV) up to dV* and (dV + dV*) / 2 sqrt(dV*)
+ *  above - the tangent of the square root. _calculate_jerk() sets the k, jerk and dV* of the
+ *  head and the tail ramp (bf->head, bf->tail) and the solvers take the ramp they plan.
+ *  With RAMP_QUINTIC both are the same and there is no plateau, and everything runs as it
+ *  always has. Otherwise mp_get_meet_velocity() runs the Newton iteration above on the
+ *  weighted sum of the two ramps, which stays convex, seeded from above. The exec evaluates
+ *  S-curve ramps at each segment's midpoint instead of the forward differences.
+ *
+ *  $rp and $jr are read together as the ramp group ({ramp:n}). They are kept out of sys,
+ *  which is at the limit of what one NV list can hold (see get_grp()).
+ */
+
+/* Adaptive segmentation
+ *
+ *  With ADAPTIVE_SEGMENTS_ENABLED the exec picks the segment time for each section of a move
+ *  instead of always running NOM_SEGMENT_MS segments:
+ *    - Bodies (cruise) run segments up to MAX_SEGMENT_MS long. The velocity is constant so
+ *      longer segments lose nothing, and long straight moves cost far fewer exec interrupts.
+ *      Non-linear kinematics keep NOM_SEGMENT_MS bodies as straight lines bend in joint space.
+ *    - Heads and tails are cut finer (down to MIN_SEGMENT_MS) where the velocity changes by more
+ *      than SEGMENT_VELOCITY_STEP per segment, so high-jerk ramps follow the profile more closely.
+ *
+ *  It is off by default as the long bodies have two costs:
+ *    - DDA_SUBSTEPS is scaled so a MAX_SEGMENT_MS segment can't overflow the accumulator, so
+ *      every segment loses MAX_SEGMENT_MS / NOM_SEGMENT_MS (3.3x) of its phase precision.
+ *    - A feedhold starts decelerating only after the segments already in the prep queue have
+ *      run. That is up to STEP_PREP_QUEUE_SIZE * MAX_SEGMENT_MS (20 ms) instead of 6 ms.
+ *  Turn it on where exec interrupts are the bottleneck and those costs are acceptable.
+ */
+#ifndef ADAPTIVE_SEGMENTS_ENABLED
+#define ADAPTIVE_SEGMENTS_ENABLED   false               // {true, false}
+#endif
+
+#if (ADAPTIVE_SEGMENTS_ENABLED == true)
+#define MAX_SEGMENT_MS              ((float)5.0)        // maximum segment milliseconds (cruise bodies)
+#define SEGMENT_VELOCITY_STEP       ((float)60.0)       // target velocity change per head/tail segment in mm/min
+#else
+#define MAX_SEGMENT_MS              NOM_SEGMENT_MS
+#endif
+
 #define NOM_SEGMENT_TIME            ((float)(NOM_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
 #define NOM_SEGMENT_USEC            ((float)(NOM_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
 #define MIN_SEGMENT_TIME            ((float)(MIN_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
+#define MIN_SEGMENT_USEC            ((float)(MIN_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
+#define MAX_SEGMENT_TIME            ((float)(MAX_SEGMENT_MS / 60000))       // DO NOT CHANGE - time in minutes
+#define MAX_SEGMENT_USEC            ((float)(MAX_SEGMENT_MS * 1000))        // DO NOT CHANGE - time in microseconds
 #define MIN_BLOCK_TIME              ((float)(MIN_BLOCK_MS / 60000))         // DO NOT CHANGE - time in minutes
 #define PHAT_CITY_TIME              ((float)(PHAT_CITY_MS / 60000))         // DO NOT CHANGE - time in minutes
 
@@ -286,6 +495,54 @@ typedef enum {
 #define Veq2_lo 1.0
 #define VELOCITY_ROUGHLY_EQ(v0,v1) ( (v0 > Vthr2) ? fabs(v0-v1) < Veq2_hi : fabs(v0-v1) < Veq2_lo )
 
+/*
+ * Planner benchmark counters
+ *
+ *  Block, segment and starvation counters for the posix-sim benchmark harness
+ *  (board/posix-sim/platform/posix/posix_bench.cpp). Compiled in only if
+ *  PLANNER_BENCHMARK_ENABLED is true. The harness takes _plan_block() and mp_exec_move()
+ *  timing from the profiler's PROF_PLAN_BLOCK and PROF_EXEC_MOVE points (see profiler.h)
+ *  so the hot paths carry one set of timers.
+ */
+
+#ifndef PLANNER_BENCHMARK_ENABLED
+#define PLANNER_BENCHMARK_ENABLED false
+#endif
+
+#if (PLANNER_BENCHMARK_ENABLED == true)
+#define BENCH_COUNT(c) mp_bench.c++;
+#define BENCH_ADD(c, v) mp_bench.c += v;
+#else
+#define BENCH_COUNT(c)
+#define BENCH_ADD(c, v)
+#endif
+
+/*
+ * Trajectory hooks
+ *
+ *  mp_trajectory_block() is called when an aline block starts to execute, after its
+ *  ramps are final (mr.r), and mp_trajectory_segment() after each of its segments has
+ *  been prepped. mp_trajectory_path() is called with each line and native arc as it was
+ *  programmed, before it is merged or blended, and the tolerance it may be run within.
+ *  All are provided by the board - the posix-sim uses them to record and check golden
+ *  trajectories (board/posix-sim/platform/posix/posix_golden.cpp).
+ *  Compiled in only if PLANNER_TRAJECTORY_HOOKS_ENABLED is true.
+ */
+
+#ifndef PLANNER_TRAJECTORY_HOOKS_ENABLED
+#define PLANNER_TRAJECTORY_HOOKS_ENABLED false
+#endif
+
+#if (PLANNER_TRAJECTORY_HOOKS_ENABLED == true)
+#define TRAJECTORY_BLOCK(bf) mp_trajectory_block(bf);
+#define TRAJECTORY_SEGMENT() mp_trajectory_segment();
+#define TRAJECTORY_PATH(start, end, arc, tolerance) mp_trajectory_path(start, end, arc, tolerance);
+#else
+#define TRAJECTORY_BLOCK(bf)
+#define TRAJECTORY_SEGMENT()
+#define TRAJECTORY_PATH(start, end, arc, tolerance)
+#endif
+
 //#define ASCII_ART(s)            xio_writeline(s)
 #define ASCII_ART(s)
 //#define UPDATE_BF_DIAGNOSTICS(bf) { bf->block_time_ms = bf->block_time*60000; bf->plannable_time_ms = bf->plannable_time*60000; }
@@ -300,34 +557,100 @@ typedef enum {
  *    - plan_exec.cpp / mp_exec_aline()
  */
 
-struct mpBuffer_to_clear {
-    // Note: _clear_buffer() zeros all data from this point down
-    stat_t (*bf_func)(struct mpBuffer *bf); // callback to buffer exec function
-    cm_exec_t cm_func;              // callback to canonical machine execution function
+typedef struct mpArcGeometry {      // geometry of a BLOCK_TYPE_ARC block - see mp_arc()
+    uint8_t plane_axis_0;           // arc plane axis 0 - e.g. X for G17
+    uint8_t plane_axis_1;           // arc plane axis 1 - e.g. Y for G17
+    uint8_t linear_axis;            // linear axis (normal to plane)
+    float center_0;                 // center of circle at plane axis 0
+    float center_1;                 // center of circle at plane axis 1
+    float radius;
+    float theta;                    // starting angle of arc (see plan_arc.cpp/_compute_arc())
+    float angular_travel;           // travel along the arc in radians. Positive is clockwise
+    float linear_start;             // linear axis position at the start of the arc
+    float linear_travel;            // travel along linear axis of arc in mm
+    float length;                   // length of the whole arc or helix in mm
+    float offset;                   // length already run before a feedhold restarted the block
+    float exit_unit[AXES];          // unit vector at the end of the arc (bf->unit is the start)
+} mpArcGeometry_t;
+
+/* Buffer layout
+ *
+ *  Back-planning walks backwards from the newest block on every new block, ten or more
+ *  blocks deep on short-segment files, and only reads and writes a handful of fields
+ *  per block (see _plan_block()). Those fields and the ring pointers lead mpBuf_t, so each
+ *  block visited costs one or two cache lines. The block's Gcode state and arc geometry
+ *  are only used when a block is queued, merged, primed and run, so they live in mb.cold[],
+ *  parallel to mb.bf[], and each buffer points at its own entry (bf->gm, bf->arc). The
+ *  pointers are bound once by mp_init_buffers().
+ */
 
-    //+++++ DIAGNOSTICS for easier debugging
-    uint32_t linenum;               // mirror of bf->gm.linenum
-    int iterations;
-    float block_time_ms;
-    float plannable_time_ms;        // time in planner
-    float plannable_length;         // length in planner
-    int8_t meet_iterations;         // iterations needed in _get_meet_velocity
-    //+++++ to here
+/* Gcode state table
+ *
+ *  A block only needs a few fields of the Gcode model to be planned and run: the target, feed
+ *  rate and modes, line number, tool and path control. These are copied into its mpMotionState_t.
+ *  The rest of the model - units, plane, distance modes, coordinate system and offsets, G64
+ *  tolerances - rarely changes, but the runtime model (mr.gm) must still report it. It is kept
+ *  in mp.modal[], a ring of PLANNER_MODAL_STATES full models numbered by sequence. Each block
+ *  holds the sequence number of the entry that was current when it was queued. A new entry is
+ *  only added when one of those fields changes (see mp_get_modal_state()). mp_exec_aline() only
+ *  copies the full entry into mr.gm when the sequence number differs from the one already there.
+ *
+ *  Entries are live from the one the runtime last loaded (mr.modal_seq) to the newest
+ *  (mp.modal_seq). mp_planner_is_full() stops input once fewer than PLANNER_MODAL_HEADROOM
+ *  entries are free, so a program that changes modes on every line runs with a shallower
+ *  queue instead of failing.
+ */
 
+typedef struct mpMotionState {      // Gcode model state carried by a block - see Gcode state table
+    uint32_t linenum;               // Gcode block line number
+    cmMotionMode motion_mode;       // G0, G1, G2, G3...
+    float target[AXES];             // XYZABC where the move should go (command value vector for commands)
+    float feed_rate;                // F - normalized to millimeters/minute or in inverse time mode
+    cmFeedRateMode feed_rate_mode;  // See cmFeedRateMode for settings
+    cmPathControl path_control;     // G61... EXACT_PATH, EXACT_STOP, CONTINUOUS
+    uint8_t tool;                   // M6 tool
+    uint16_t modal;                 // sequence number of the rest of the model in mp.modal[]
+
+    void reset() {
+        linenum = 0;
+        motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE;
+        for (uint8_t i = 0; i< AXES; i++) {
+            target[i] = 0.0;
+        }
+        feed_rate = 0.0;
+        feed_rate_mode = INVERSE_TIME_MODE;
+        path_control = PATH_EXACT_PATH;
+        tool = 1;
+        modal = 0;
+    };
+} mpMotionState_t;
+
+typedef struct mpRamp {             // head or tail ramp of a block - see Ramp profiles
+    float jerk;                     // planning jerk - the quintic jerk with the same ramp lengths
+    float sqrt_j;                   // sqrt(jerk)
+    float q_recip_2_sqrt_j;         // (q/(2 sqrt(jerk))) where q = (sqrt(10)/(3^(1/4))), the k of the ramp length
+    float dv_plateau;               // velocity change above which acceleration is held constant (0 = never)
+    float plateau_k;                // q_recip_2_sqrt_j / (2 sqrt(dv_plateau)), the k above it
+} mpRamp_t;
+
+typedef struct mpBufferCold {       // block state back-planning never reads - see Buffer layout
+    mpMotionState_t gm;             // Gcode model state - passed from model, used by planner and runtime
+    mpArcGeometry_t arc;            // arc geometry (BLOCK_TYPE_ARC only)
+} mpBufCold_t;
+
+typedef struct mpBuffer {           // See Planning Velocity Notes for variable usage and Buffer layout
+
+    // *** CAUTION *** These pointers are not reset by _clear_buffer()
+    struct mpBuffer *pv;            // static pointer to previous buffer
+    struct mpBuffer *nx;            // static pointer to next buffer
+
+    // back-planning reads or writes these on every block it visits - keep them together
     bufferState buffer_state;       // used to manage queuing/dequeuing
     blockType block_type;           // used to dispatch to run routine
-    blockState block_state;         // move state machine sequence
     blockHint hint;                 // hint the block for zoid and other planning operations. Must be accurate or NO_HINT
-
-    // block parameters
-    float unit[AXES];               // unit vector for axis scaling & planning
-    bool axis_flags[AXES];          // set true for axes participating in the move & for command parameters
-
     bool plannable;                 // set true when this block can be used for planning
 
     float length;                   // total length of line or helix in mm
-    float block_time;               // computed move time for entire block (move)
-    float override_factor;          // feed rate or rapid override factor for this block ("override" is a reserved word)
 
     // We are removing all entry_* values.
     // To get the entry_* values, look at pv->exit_* or mr.exit_*
@@ -336,73 +659,89 @@ struct mpBuffer_to_clear {
     float cruise_velocity;          // cruise velocity requested & achieved
     float exit_velocity;            // exit velocity requested for the move
                                     // is also the entry velocity of the *next* move
-
-    float cruise_vset;              // cruise velocity requested for move - prior to overrides
     float cruise_vmax;              // cruise max velocity adjusted for overrides
     float exit_vmax;                // max exit velocity possible for this move
                                     // is also the maximum entry velocity of the next move
+    mpRamp_t tail;                  // deceleration ramp terms (computed and cached)
+    int iterations;                 //+++++ DIAGNOSTIC - back-planning passes over this block
 
-    float absolute_vmax;            // fastest this block can move w/o exceeding constraints
+    // priming and forward planning (once per block)
     float junction_vmax;            // maximum the exit velocity can be to go through the junction
                                     // between the NEXT BLOCK AND THIS ONE
+    float absolute_vmax;            // fastest this block can move w/o exceeding constraints
+    float cruise_vset;              // cruise velocity requested for move - prior to overrides
+    float override_factor;          // feed rate or rapid override factor for this block ("override" is a reserved word)
+    float block_time;               // computed move time for entire block (move)
 
     float jerk;                     // maximum linear jerk term for this move
-    float jerk_sq;                  // Jm^2 is used for planning (computed and cached)
-    float recip_jerk;               // 1/Jm used for planning (computed and cached)
-    float sqrt_j;                   // sqrt(jM) used for planning (computed and cached)
-    float q_recip_2_sqrt_j;         // (q/(2 sqrt(jM))) where q = (sqrt(10)/(3^(1/4))), used in length computations (computed and cached)
+    mpRamp_t head;                  // acceleration ramp terms (computed and cached)
+    rampProfile ramp_profile;       // shape of the head and tail ramps
 
-    GCodeState_t gm;                // Gcode model state - passed from model, used by planner and runtime
+    // block parameters
+    float unit[AXES];               // unit vector for axis scaling & planning
+    bool axis_flags[AXES];          // set true for axes participating in the move & for command parameters
 
-    void reset() {
-        //memset((void *)(this), 0, sizeof(mpBuffer_to_clear));
-        
-        bf_func = nullptr;
-        cm_func = nullptr;
+    blockState block_state;         // move state machine sequence
+    uint32_t queued_usec;           // minimum block time added to mp.queued_usec on commit
 
-        linenum = 0;
-        iterations = 0;
-        block_time_ms = 0;
-        plannable_time_ms = 0;
-        plannable_length = 0;
-        meet_iterations = 0;
+    stat_t (*bf_func)(struct mpBuffer *bf); // callback to buffer exec function
+    cm_exec_t cm_func;              // callback to canonical machine execution function
 
+    // *** CAUTION *** These pointers are bound once by mp_init_buffers() and not reset
+    mpMotionState_t *gm;            // this buffer's Gcode model state in mb.cold[]
+    mpArcGeometry_t *arc;           // this buffer's arc geometry in mb.cold[]
+
+    //+++++ DIAGNOSTICS for easier debugging
+    uint32_t linenum;               // mirror of bf->gm->linenum
+    float block_time_ms;
+    float plannable_time_ms;        // time in planner
+    float plannable_length;         // length in planner
+    int8_t meet_iterations;         // iterations needed in mp_get_meet_velocity
+    uint8_t buffer_number;          // not reset by _clear_buffer()
+    //+++++ to here
+
+    void reset() {                  // clears everything but the links, the cold pointers and the number
         buffer_state = MP_BUFFER_EMPTY;
         block_type = BLOCK_TYPE_NULL;
-        block_state = BLOCK_INACTIVE;
         hint = NO_HINT;
-
-        for (uint8_t i = 0; i< AXES; i++) {
-            unit[i] = 0;
-            axis_flags[i] = 0;
-        }
-
         plannable = false;
+
         length  = 0.0;
-        block_time = 0.0;
-        override_factor = 0.0;
         cruise_velocity = 0.0;
         exit_velocity = 0.0;
-        cruise_vset = 0.0;
         cruise_vmax = 0.0;
         exit_vmax = 0.0;
-        absolute_vmax = 0.0;
+        tail = mpRamp_t();
+        iterations = 0;
+
         junction_vmax = 0.0;
+        absolute_vmax = 0.0;
+        cruise_vset = 0.0;
+        override_factor = 0.0;
+        block_time = 0.0;
         jerk = 0.0;
-        jerk_sq = 0.0;
-        recip_jerk = 0.0;
-        sqrt_j = 0.0;
-        q_recip_2_sqrt_j = 0.0;
-        gm.reset();
-    }
-};
+        head = mpRamp_t();
+        ramp_profile = RAMP_QUINTIC;
 
-typedef struct mpBuffer : mpBuffer_to_clear { // See Planning Velocity Notes for variable usage
+        for (uint8_t i = 0; i< AXES; i++) {
+            unit[i] = 0;
+            axis_flags[i] = 0;
+        }
+        block_state = BLOCK_INACTIVE;
+        queued_usec = 0;
 
-    // *** CAUTION *** These two pointers are not reset by _clear_buffer()
-    struct mpBuffer *pv;            // static pointer to previous buffer
-    struct mpBuffer *nx;            // static pointer to next buffer
-    uint8_t buffer_number;          //+++++ DIAGNOSTIC for easier debugging
+        bf_func = nullptr;
+        cm_func = nullptr;
+
+        gm->reset();
+        *arc = mpArcGeometry_t();
+
+        linenum = 0;
+        block_time_ms = 0;
+        plannable_time_ms = 0;
+        plannable_length = 0;
+        meet_iterations = 0;
+    }
 } mpBuf_t;
 
 typedef struct mpBufferPool {       // ring buffer for sub-moves
@@ -412,10 +751,19 @@ typedef struct mpBufferPool {       // ring buffer for sub-moves
     mpBuf_t *w;                     // write buffer pointer
     uint8_t buffers_available;      // running count of available buffers
     mpBuf_t bf[PLANNER_BUFFER_POOL_SIZE];// buffer storage
+    mpBufCold_t cold[PLANNER_BUFFER_POOL_SIZE];// Gcode state and arc geometry of bf[i] - see Buffer layout
 
     magic_t magic_end;
 } mpBufferPool_t;
 
+typedef struct mpJerkCache {        // key and derived terms of the last jerk computed
+    float unit[AXES];               // key: absolute unit vector (or arc envelope) of the block
+    float axis_jerk[AXES];          // key: jerk limit of each participating axis at the time
+    float jerk;                     // derived terms - copied to bf on a hit
+    mpRamp_t head;
+    mpRamp_t tail;
+} mpJerkCache_t;
+
 typedef struct mpMotionPlannerSingleton {  // common variables for planning (move master)
     magic_t magic_start;            // magic number to test memory integrity
 
@@ -429,6 +777,10 @@ typedef struct mpMotionPlannerSingleton {  // common variables for planning (mov
     // timing variables
     float run_time_remaining;       // time left in runtime (including running block)
     float plannable_time;           // time in planner that can actually be planned
+    uint32_t queued_usec;           // minimum motion time committed to the queue (main loop only)
+    uint32_t dequeued_usec;         // ...and released from it (exec only). See PLANNER_TIME_LOOKAHEAD
+    float merge_deviation;          // summed deviation of the lines merged into the last block (main loop only)
+    float merge_unit[AXES];         // unit vector of the first of those lines
 
     // planner state variables
     plannerState planner_state;     // current state of planner
@@ -443,6 +795,13 @@ typedef struct mpMotionPlannerSingleton {  // common variables for planning (mov
     float ramp_target;
     float ramp_dvdt;
 
+    // jerk terms of the last block that had to compute them - see _calculate_jerk()
+    mpJerkCache_t jerk_cache;
+
+    // Gcode state table - see mp_get_modal_state()
+    GCodeState_t modal[PLANNER_MODAL_STATES];
+    uint16_t modal_seq;             // sequence number of the newest entry
+
     // objects
     Timeout block_timeout;          // Timeout object for block planning
 
@@ -450,6 +809,7 @@ typedef struct mpMotionPlannerSingleton {  // common variables for planning (mov
     mpBuf_t *p;                     // planner buffer pointer
     mpBuf_t *c;                     // pointer to buffer immediately following critical region
     mpBuf_t *planning_return;       // buffer to return to once back-planning is complete
+    mpBuf_t *dirty;                 // earliest block whose constraints changed since the last back-planning pass
 
     magic_t magic_end;
 } mpMotionPlannerSingleton_t;
@@ -482,9 +842,17 @@ typedef struct mpMotionRuntimeSingleton {    // persistent runtime variables
     float position[AXES];               // current move position
     float waypoint[SECTIONS][AXES];     // head/body/tail endpoints for correction
 
+    blockType block_type;               // ALINE or ARC
+    mpArcGeometry_t arc;                // copy of the running arc's geometry
+    float distance;                     // arc length run so far (arcs only)
+    float waypoint_distance[SECTIONS];  // arc length at the head/body/tail endpoints (arcs only)
+    float arc_vector_0;                 // radius vector from the center to the last segment target
+    float arc_vector_1;                 //   (arcs only - see Incremental arc interpolation in plan_arc.h)
+    uint8_t arc_resync_count;           // segments until the next exact resync
+
     float target_steps[MOTORS];         // current MR target (absolute target as steps)
     float position_steps[MOTORS];       // current MR position (target from previous segment)
-    float commanded_steps[MOTORS];      // will align with next encoder sample (target from 2nd previous segment)
+    float commanded_steps[MOTORS];      // commanded position of the last encoder sample (start of the segment last loaded)
     float encoder_steps[MOTORS];        // encoder position in steps - ideally the same as commanded_steps
     float following_error[MOTORS];      // difference between encoder_steps and commanded steps
 
@@ -505,15 +873,40 @@ typedef struct mpMotionRuntimeSingleton {    // persistent runtime variables
     float forward_diff_4;               // forward difference level 4
     float forward_diff_5;               // forward difference level 5
 
+    rampProfile ramp_profile;           // shape of the running block's ramps - see Ramp profiles
+    float ramp_time;                    // S-curve ramps: time of the segment's midpoint, 0 to 1 over the section
+    float ramp_step;                    //   ...advanced by this for each segment
+    float ramp_jerk_share;              //   share of the section at the start (and end) spent jerking
+    float ramp_v_0;                     //   section entry and exit velocities
+    float ramp_v_1;
+    float ramp_curve;                   //   velocity change per time^2 while jerking
+    float ramp_slope;                   //   velocity change per time in the plateau
+
     GCodeState_t gm;                    // gcode model state currently executing
+    uint16_t modal_seq;                 // Gcode state table entry the rest of gm was loaded from
 
     magic_t magic_end;
 } mpMotionRuntimeSingleton_t;
 
+typedef struct mpPlannerBenchmark {     // see PLANNER_BENCHMARK_ENABLED
+    uint32_t blocks;                    // blocks committed to the planner queue
+    uint32_t merges;                    // lines merged into the last block instead of queued
+    uint32_t blends;                    // corners rounded with a blend arc
+    uint32_t jerk_calls;                // _calculate_jerk() calls
+    uint32_t jerk_hits;                 // ...that reused the cached jerk terms
+    uint32_t plan_blocks;               // _plan_block() calls, including replans
+    uint32_t back_plans;                // blocks visited by back-planning
+    double length;                      // total length of the line and arc blocks committed, in mm
+    uint32_t segments;                  // aline segments prepped for the steppers
+    uint32_t starvations;               // exec reached a block that was not yet planned while in motion
+    uint32_t underruns;                 // loader found no prepped segment while in motion
+} mpPlannerBenchmark_t;
+
 // Reference global scope structures
 extern mpBufferPool_t mb;               // buffer pool management
 extern mpMotionPlannerSingleton_t mp;   // context for block planning
 extern mpMotionRuntimeSingleton_t mr;   // context for block runtime
+extern mpPlannerBenchmark_t mp_bench;   // benchmark counters (if PLANNER_BENCHMARK_ENABLED)
 
 /*
  * Global Scope Functions
@@ -565,12 +958,15 @@ void mp_init_buffers(void);
 //mpBuf_t * mp_get_next_buffer(const mpBuf_t *bf);      // Use the following macro instead
 #define mp_get_prev_buffer(b) ((mpBuf_t *)(b->pv))
 #define mp_get_next_buffer(b) ((mpBuf_t *)(b->nx))
+#define mp_block_is_move(b) (((b)->block_type == BLOCK_TYPE_ALINE) || ((b)->block_type == BLOCK_TYPE_ARC))
 
 mpBuf_t * mp_get_write_buffer(void);
 void mp_commit_write_buffer(const blockType block_type);
 mpBuf_t * mp_get_run_buffer(void);
 bool mp_free_run_buffer(void);
 
+stat_t mp_get_modal_state(const GCodeState_t *gm, uint16_t *seq);
+
 // plan_line.c functions
 void mp_zero_segment_velocity(void);                    // getters and setters...
 float mp_get_runtime_velocity(void);
@@ -581,14 +977,17 @@ bool mp_get_runtime_busy(void);
 bool mp_runtime_is_idle(void);
 
 stat_t mp_aline(GCodeState_t *gm_in);                   // line planning...
+stat_t mp_arc(GCodeState_t *gm_in, const mpArcGeometry_t *arc); // ...and arc planning
 void mp_plan_block_list(void);
 void mp_plan_block_forward(mpBuf_t *bf);
+void mp_reset_jerk_cache(void);
 
 // plan_zoid.c functions
 void mp_calculate_ramps(mpBlockRuntimeBuf_t *block, mpBuf_t *bf, const float entry_velocity);
-float mp_get_target_length(const float v_0, const float v_1, const mpBuf_t *bf);
-float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t *bf); // acceleration ONLY
-float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t *bf);  // deceleration ONLY
+float mp_get_target_length(const float v_0, const float v_1, const mpRamp_t *ramp);
+float mp_get_target_velocity(const float v_0, const float L, const mpRamp_t *ramp); // acceleration ONLY
+float mp_get_decel_velocity(const float v_0, const float L, const mpRamp_t *ramp);  // deceleration ONLY
+float mp_get_meet_velocity(const float v_0, const float v_2, const float L, mpBuf_t *bf, mpBlockRuntimeBuf_t *block);
 float mp_find_t(const float v_0, const float v_1, const float L, const float totalL, const float initial_t, const float T);
 
 float mp_calc_v(const float t, const float v_0, const float v_1);                // compute the velocity along the curve accelerating from v_0 to v_1, at position t=[0,1]
@@ -604,4 +1003,9 @@ void mp_exit_hold_state(void);
 
 void mp_dump_planner(mpBuf_t *bf_start);
 
+// trajectory hooks - provided by the board if PLANNER_TRAJECTORY_HOOKS_ENABLED
+void mp_trajectory_block(const mpBuf_t *bf);
+void mp_trajectory_segment(void);
+void mp_trajectory_path(const float start[], const float end[], const mpArcGeometry_t *arc, const float tolerance);
+
 #endif    // End of include Guard: PLANNER_H_ONCE
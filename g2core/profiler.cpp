@@ -0,0 +1,258 @@
+/*
+ * profiler.cpp - hot path execution time profiler
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "profiler.h"
+#include "planner.h"
+#include "text_parser.h"
+#include "util.h"
+#include "xio.h"
+
+#if (PROFILER_ENABLED == true)
+
+/**** Allocate Structures ****/
+
+profProfiler_t prof;
+
+// histogram bucket limits as percentages of NOM_SEGMENT_MS. The last bucket is everything over
+static const uint8_t _bucket_percent[PROF_BUCKETS-1] = { 1, 2, 5, 10, 20, 50, 100 };
+
+// token suffixes of the profiled points, in profPoint order
+static const char _point_tokens[] = "mspbgjhki";
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * prof_init() - start the cycle counter, set up the histogram and clear the statistics
+ */
+
+void prof_init()
+{
+#ifdef PROFILER_USES_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // enable the DWT unit
+#if (__CORTEX_M == 7)
+    *((volatile uint32_t *)DWT_LOCK_ACCESS) = DWT_LOCK_KEY;  // the M7 (SAMS70) powers up with the DWT locked
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;            // start the cycle counter
+#endif
+    for (uint8_t i = 0; i < PROF_BUCKETS-1; i++) {
+        prof.bucket_limit[i] = (uint32_t)(NOM_SEGMENT_USEC * PROFILER_TICKS_PER_US * _bucket_percent[i] / 100);
+    }
+    prof_clear();
+}
+
+/*
+ * prof_clear()  - clear the statistics of all points
+ * _clear_point() - clear the statistics of one point
+ */
+
+static void _clear_point(profStats_t *p)
+{
+    memset(p, 0, sizeof(profStats_t));
+    p->min = 0xFFFFFFFF;
+}
+
+void prof_clear()
+{
+    for (uint8_t i = 0; i < PROF_POINTS; i++) {
+        _clear_point(&prof.point[i]);
+    }
+}
+
+/*
+ * prof_record() - record one call that started at <start> ticks. Called by PROF_END()
+ *
+ *  Called from interrupts - keep it short. Tick arithmetic is unsigned, so the
+ *  counter wrapping between start and end does no harm.
+ */
+
+void prof_record(const profPoint point, const uint32_t start)
+{
+    const uint32_t ticks = PROFILER_TICKS() - start;
+    profStats_t *p = &prof.point[point];
+
+    p->count++;
+    p->total += ticks;
+    if (ticks < p->min) { p->min = ticks; }
+    if (ticks > p->max) { p->max = ticks; }
+
+    uint8_t bucket = 0;
+    while ((bucket < PROF_BUCKETS-1) && (ticks >= prof.bucket_limit[bucket])) {
+        bucket++;
+    }
+    p->hist[bucket]++;
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * _get_point() - return the profPoint for a $prof token, or -1 if it's not a point
+ * _ticks_to_us() - convert ticks to microseconds
+ */
+
+static int8_t _get_point(const nvObj_t *nv)
+{
+    const char *ptr = strchr(_point_tokens, cfgArray[nv->index].token[4]);
+    if ((ptr == NULL) || (*ptr == NUL)) {
+        return (-1);
+    }
+    return (ptr - _point_tokens);
+}
+
+static float _ticks_to_us(const float ticks)
+{
+    return (ticks / PROFILER_TICKS_PER_US);
+}
+
+/*
+ * prof_get_point() - get the statistics of a point as a string
+ * prof_set_point() - clear the statistics of a point. Only 0 is accepted
+ * prof_get_profu() - get worst-case mp_exec_move() time as a percentage of NOM_SEGMENT_MS
+ * prof_set_profu() - clear the statistics of all points. Only 0 is accepted
+ * prof_get_profc() - get the jerk cache hit rate and the time it saved as a string
+ */
+
+stat_t prof_get_point(nvObj_t *nv)
+{
+    int8_t point = _get_point(nv);
+    if (point < 0) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INTERNAL_ERROR);
+    }
+    profStats_t p = prof.point[point];              // take a copy - interrupts may update it
+    char str[NV_MESSAGE_LEN];
+    char *ptr = str;
+
+    if (p.count == 0) {
+        ptr += sprintf(ptr, "0,0,0,0");
+    } else {
+        ptr += sprintf(ptr, "%lu,%0.1f,%0.1f,%0.1f", (unsigned long)p.count,
+                       (double)_ticks_to_us(p.min),
+                       (double)_ticks_to_us((float)p.total / p.count),
+                       (double)_ticks_to_us(p.max));
+    }
+    for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+        ptr += sprintf(ptr, ",%lu", (unsigned long)p.hist[i]);
+    }
+    nv->valuetype = TYPE_STRING;
+    return (nv_copy_string(nv, str));
+}
+
+stat_t prof_set_point(nvObj_t *nv)
+{
+    int8_t point = _get_point(nv);
+    if ((point < 0) || (fp_NOT_ZERO(nv->value))) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    _clear_point(&prof.point[point]);
+    return (prof_get_point(nv));
+}
+
+stat_t prof_get_profu(nvObj_t *nv)
+{
+    nv->value = _ticks_to_us(prof.point[PROF_EXEC_MOVE].max) * 100 / NOM_SEGMENT_USEC;
+    nv->precision = GET_TABLE_WORD(precision);
+    nv->valuetype = TYPE_FLOAT;
+    return (STAT_OK);
+}
+
+stat_t prof_set_profu(nvObj_t *nv)
+{
+    if (fp_NOT_ZERO(nv->value)) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    prof_clear();
+    return (prof_get_profu(nv));
+}
+
+stat_t prof_get_profc(nvObj_t *nv)
+{
+    const profStats_t hit = prof.point[PROF_JERK_HIT];
+    const profStats_t miss = prof.point[PROF_JERK_MISS];
+    float rate = 0;
+    float saved = 0;
+
+    if ((hit.count + miss.count) > 0) {
+        rate = 100.0 * hit.count / (hit.count + miss.count);
+    }
+    if ((hit.count > 0) && (miss.count > 0)) {
+        saved = hit.count * _ticks_to_us((float)miss.total / miss.count - (float)hit.total / hit.count);
+    }
+    char str[NV_MESSAGE_LEN];
+    sprintf(str, "%0.1f,%0.1f", (double)rate, (double)saved);
+    nv->valuetype = TYPE_STRING;
+    return (nv_copy_string(nv, str));
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_profm[] = "[profm] mp_exec_move          %s\n";
+static const char fmt_profs[] = "[profs] _exec_aline_segment   %s\n";
+static const char fmt_profp[] = "[profp] st_prep_line          %s\n";
+static const char fmt_profb[] = "[profb] _plan_block           %s\n";
+static const char fmt_profg[] = "[profg] gcode_parser          %s\n";
+static const char fmt_profj[] = "[profj] json_parser           %s\n";
+static const char fmt_profh[] = "[profh] jerk cache hit        %s\n";
+static const char fmt_profk[] = "[profk] jerk cache miss       %s\n";
+static const char fmt_profi[] = "[profi] kn_inverse_kinematics %s\n";
+static const char fmt_profu[] = "[profu] exec budget used%14.1f%% of segment time (worst case)\n";
+static const char fmt_profc[] = "[profc] jerk cache rate,us saved %s\n";
+
+static const char *const fmt_point[PROF_POINTS] = { fmt_profm, fmt_profs, fmt_profp, fmt_profb, fmt_profg, fmt_profj, fmt_profh, fmt_profk, fmt_profi };
+
+void prof_print_point(nvObj_t *nv)
+{
+    int8_t point = _get_point(nv);
+    if (point >= 0) {
+        text_print(nv, fmt_point[point]);           // TYPE_STRING
+    }
+}
+
+void prof_print_profu(nvObj_t *nv) { text_print(nv, fmt_profu);}   // TYPE_FLOAT
+void prof_print_profc(nvObj_t *nv) { text_print(nv, fmt_profc);}   // TYPE_STRING
+
+#endif // __TEXT_MODE
+
+#else
+
+void prof_init() {}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,165 @@
+/*
+ * profiler.h - hot path execution time profiler
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * PROFILER
+ *
+ *	The profiler times the hot paths of the firmware on the running machine so we can see
+ *	how much of the NOM_SEGMENT_MS budget the exec interrupt actually uses. It is compiled
+ *	in only if PROFILER_ENABLED is true. The ARM boards turn it on in their hardware.h, so
+ *	{prof:n} can be read from a machine while it runs a job; set it false there to drop the
+ *	$prof group and the timers (a call to prof_record() per profiled point) from a build.
+ *
+ *	PROF_START() and PROF_END() are the only timers on the hot paths: the posix-sim
+ *	--bench harness reads its plan and exec timing from PROF_PLAN_BLOCK and PROF_EXEC_MOVE.
+ *	A function that is timed must reach PROF_END() on every return path.
+ *
+ *	Timing uses the Cortex-M DWT cycle counter on ARM boards (SAM3X and SAMS70). It counts
+ *	core clocks and wraps every 51 s at 84 MHz, 14 s at 300 MHz. A board can provide its own
+ *	clock by defining PROFILER_TICKS() (a free-running 32 bit counter) and
+ *	PROFILER_TICKS_PER_US - the posix-sim uses the host's monotonic clock.
+ *
+ *	Profiled points ($prof group, one token each):
+ *
+ *	  profm   mp_exec_move()            exec interrupt
+ *	  profs   _exec_aline_segment()     one aline segment, including kinematics and prep
+ *	  profi   kn_inverse_kinematics()   the $kty transform and motor mapping of one segment
+ *	  profp   st_prep_line()            stepper prep for one segment
+ *	  profb   _plan_block()             back-planning of one block
+ *	  profg   gcode_parser()            one Gcode block, including blank, comment and deleted lines
+ *	  profj   json_parser()             one JSON command, including its response
+ *	  profh   _calculate_jerk()         jerk terms copied from the jerk cache (see planner.h)
+ *	  profk   _calculate_jerk()         jerk terms computed
+ *	  profu   worst-case mp_exec_move() as a percentage of NOM_SEGMENT_MS
+ *	  profc   jerk cache hit rate in percent, and microseconds saved: hits times the
+ *	          difference between the mean miss and the mean hit (string "rate,saved_us")
+ *
+ *	Each point reports a string of comma separated values:
+ *
+ *	  count,min_us,mean_us,max_us,h0,h1,h2,h3,h4,h5,h6,h7
+ *
+ *	where h0..h7 are histogram buckets of the calls that took less than 1%, 2%, 5%, 10%,
+ *	20%, 50% and 100% of NOM_SEGMENT_MS, and (h7) the calls that took longer.
+ *
+ *	{prof:n} reports all points. Setting a point to 0 ({profm:0}) clears it, and setting
+ *	profu to 0 clears all points. The statistics are updated from interrupts without
+ *	locking, so a report taken while the machine is running may be off by a call.
+ */
+
+#ifndef PROFILER_H_ONCE
+#define PROFILER_H_ONCE
+
+#include "hardware.h"   // for board-level overrides
+
+/**** Configs and Constants ****/
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED false              // {true, false}
+#endif
+
+#if (PROFILER_ENABLED == true) && !defined(PROFILER_TICKS)
+#define PROFILER_USES_DWT
+#define PROFILER_TICKS() (DWT->CYCCNT)      // Cortex-M cycle counter - started by prof_init()
+#define PROFILER_TICKS_PER_US (SystemCoreClock / 1000000)
+#define DWT_LOCK_ACCESS 0xE0001FB0          // DWT lock access register - not in every CMSIS core_cm7.h
+#define DWT_LOCK_KEY 0xC5ACCE55
+#endif
+
+typedef enum {
+    PROF_EXEC_MOVE = 0,                     // mp_exec_move()
+    PROF_EXEC_SEGMENT,                      // _exec_aline_segment()
+    PROF_PREP_LINE,                         // st_prep_line()
+    PROF_PLAN_BLOCK,                        // _plan_block()
+    PROF_GCODE_PARSER,                      // gcode_parser()
+    PROF_JSON_PARSER,                       // json_parser()
+    PROF_JERK_HIT,                          // _calculate_jerk() from the jerk cache
+    PROF_JERK_MISS,                         // _calculate_jerk() computed
+    PROF_KINEMATICS,                        // kn_inverse_kinematics()
+    PROF_POINTS                             // count of profiled points
+} profPoint;
+
+#define PROF_BUCKETS 8                      // histogram buckets - see prof_init()
+
+/**** Structures ****/
+
+typedef struct profStats {
+    uint32_t count;                         // calls recorded
+    uint32_t min;                           // ticks
+    uint32_t max;                           // ticks
+    uint64_t total;                         // ticks
+    uint32_t hist[PROF_BUCKETS];
+} profStats_t;
+
+typedef struct profProfiler {
+    uint32_t bucket_limit[PROF_BUCKETS-1];  // upper limits of the histogram buckets, in ticks
+    profStats_t point[PROF_POINTS];
+} profProfiler_t;
+
+extern profProfiler_t prof;
+
+/**** Macros ****/
+// used to keep the profiler out of the hot paths so it can be managed in one place
+
+#if (PROFILER_ENABLED == true)
+
+void prof_record(const profPoint point, const uint32_t start);
+
+#define PROF_START(t) const uint32_t t = PROFILER_TICKS();
+#define PROF_END(t, point) prof_record(point, t);
+
+#else
+
+#define PROF_START(t)
+#define PROF_END(t, point)
+
+#endif // PROFILER_ENABLED
+
+/**** FUNCTION PROTOTYPES ****/
+
+void prof_init(void);
+void prof_clear(void);
+
+stat_t prof_get_point(nvObj_t *nv);
+stat_t prof_set_point(nvObj_t *nv);
+stat_t prof_get_profu(nvObj_t *nv);
+stat_t prof_set_profu(nvObj_t *nv);
+stat_t prof_get_profc(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void prof_print_point(nvObj_t *nv);
+    void prof_print_profu(nvObj_t *nv);
+    void prof_print_profc(nvObj_t *nv);
+
+#else
+
+    #define prof_print_point tx_print_stub
+    #define prof_print_profu tx_print_stub
+    #define prof_print_profc tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: PROFILER_H_ONCE
@@ -71,6 +71,50 @@
 #define CHORDAL_TOLERANCE           0.01    // {ct: chordal tolerance for arcs (in mm)
 #endif
 
+#ifndef RAMP_PROFILE
+#define RAMP_PROFILE                0       // {rp: 0=quintic, 1=s-curve - see Ramp profiles in planner.h
+#endif
+
+#ifndef DECEL_JERK_RATIO
+#define DECEL_JERK_RATIO            1.0     // {jr: s-curve deceleration jerk / acceleration jerk, 0.1 to 10
+#endif
+
+#ifndef KINEMATICS
+#define KINEMATICS                  0       // {kty: 0=cartesian, 1=corexy, 2=delta, 3=scara, 4=polar, 5=trunnion - see kinematics.h
+#endif
+
+#ifndef DELTA_RADIUS
+#define DELTA_RADIUS                100.0   // {kdr: horizontal distance from tower carriages to effector center (mm)
+#endif
+
+#ifndef DELTA_ROD_LENGTH
+#define DELTA_ROD_LENGTH            250.0   // {kdl: delta diagonal rod length (mm)
+#endif
+
+#ifndef SCARA_PROXIMAL_LENGTH
+#define SCARA_PROXIMAL_LENGTH       200.0   // {ksp: SCARA shoulder to elbow length (mm)
+#endif
+
+#ifndef SCARA_DISTAL_LENGTH
+#define SCARA_DISTAL_LENGTH         200.0   // {ksd: SCARA elbow to tool length (mm)
+#endif
+
+#ifndef TRUNNION_TILT_AXIS
+#define TRUNNION_TILT_AXIS          0       // {ktt: 0=A tilts about X, 1=B tilts about Y
+#endif
+
+#ifndef TRUNNION_PIVOT_X
+#define TRUNNION_PIVOT_X            0.0     // {kpx: where the trunnion tilt and table axes cross (mm)
+#endif
+
+#ifndef TRUNNION_PIVOT_Y
+#define TRUNNION_PIVOT_Y            0.0     // {kpy:
+#endif
+
+#ifndef TRUNNION_PIVOT_Z
+#define TRUNNION_PIVOT_Z            0.0     // {kpz:
+#endif
+
 #ifndef MOTOR_POWER_TIMEOUT
 #define MOTOR_POWER_TIMEOUT         2.00    // {mt:  motor power timeout in seconds
 #endif
@@ -389,6 +433,9 @@
 #ifndef X_JERK_HIGH_SPEED
 #define X_JERK_HIGH_SPEED           1000.0                  // {xjh:
 #endif
+#ifndef X_ACCEL_MAX
+#define X_ACCEL_MAX                 0.0                     // {xac:  mm/min^2 / 1000, 0 = no limit (S-curve ramps only)
+#endif
 #ifndef X_HOMING_INPUT
 #define X_HOMING_INPUT              0                       // {xhi:  input used for homing or 0 to disable
 #endif
@@ -430,6 +477,9 @@
 #ifndef Y_JERK_HIGH_SPEED
 #define Y_JERK_HIGH_SPEED           1000.0
 #endif
+#ifndef Y_ACCEL_MAX
+#define Y_ACCEL_MAX                 0.0
+#endif
 #ifndef Y_HOMING_INPUT
 #define Y_HOMING_INPUT              0
 #endif
@@ -471,6 +521,9 @@
 #ifndef Z_JERK_HIGH_SPEED
 #define Z_JERK_HIGH_SPEED           500.0
 #endif
+#ifndef Z_ACCEL_MAX
+#define Z_ACCEL_MAX                 0.0
+#endif
 #ifndef Z_HOMING_INPUT
 #define Z_HOMING_INPUT              0
 #endif
@@ -547,6 +600,9 @@
 #ifndef A_JERK_HIGH_SPEED
 #define A_JERK_HIGH_SPEED           A_JERK_MAX
 #endif
+#ifndef A_ACCEL_MAX
+#define A_ACCEL_MAX                 0.0
+#endif
 #ifndef A_HOMING_INPUT
 #define A_HOMING_INPUT              0
 #endif
@@ -591,6 +647,9 @@
 #ifndef B_JERK_HIGH_SPEED
 #define B_JERK_HIGH_SPEED           B_JERK_MAX
 #endif
+#ifndef B_ACCEL_MAX
+#define B_ACCEL_MAX                 0.0
+#endif
 #ifndef B_HOMING_INPUT
 #define B_HOMING_INPUT              0
 #endif
@@ -635,6 +694,9 @@
 #ifndef C_JERK_HIGH_SPEED
 #define C_JERK_HIGH_SPEED           C_JERK_MAX
 #endif
+#ifndef C_ACCEL_MAX
+#define C_ACCEL_MAX                 0.0
+#endif
 #ifndef C_HOMING_INPUT
 #define C_HOMING_INPUT              0
 #endif
@@ -0,0 +1,228 @@
+/*
+ * step_trace.cpp - deterministic step pulse trace recorder
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "step_trace.h"
+#include "controller.h"
+#include "json_parser.h"
+#include "text_parser.h"
+#include "xio.h"
+
+#if (STEP_TRACE_ENABLED == true)
+
+#ifdef __POSIX_SIM__
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+/**** Allocate Structures ****/
+
+stTrace_t st_trace;
+
+#ifdef __POSIX_SIM__
+static const char *_trace_file = NULL;     // from G2CORE_STEP_TRACE
+static void _write_trace_file(void);
+#endif
+
+/************************************************************************************
+ **** CODE **************************************************************************
+ ************************************************************************************/
+
+/*
+ * st_trace_init() - initialize the trace recorder (off, unless started by the host)
+ */
+
+void st_trace_init()
+{
+    st_trace.mode = TRACE_OFF;
+    st_trace.step_mask = 0;
+    st_trace.tick = 0;
+    st_trace.head = 0;
+
+#ifdef __POSIX_SIM__
+    if ((_trace_file = getenv("G2CORE_STEP_TRACE")) != NULL) {
+        atexit(_write_trace_file);
+        st_trace_start(TRACE_ONE_SHOT);
+    }
+#endif
+}
+
+/*
+ * st_trace_start() - clear the buffer and start recording in the given mode
+ *
+ *  The mode is written last so the DDA never sees a half-reset buffer.
+ */
+
+void st_trace_start(stTraceMode mode)
+{
+    st_trace.mode = TRACE_OFF;
+    st_trace.step_mask = 0;
+    st_trace.tick = 0;
+    st_trace.head = 0;
+    st_trace.mode = mode;
+}
+
+/*
+ * st_trace_count() - number of records currently held in the buffer
+ */
+
+uint32_t st_trace_count()
+{
+    return ((st_trace.head < STEP_TRACE_BUFFER_SIZE) ? st_trace.head : STEP_TRACE_BUFFER_SIZE);
+}
+
+/*
+ * _dump_records() - hex dump the buffer oldest-first, 16 records per line
+ *
+ *  Each record is emitted as its 8 bytes in memory order (little endian fields),
+ *  so the dump can be turned back into the same binary the posix-sim writes.
+ */
+
+static void _dump_records()
+{
+    static const char hex[] = "0123456789abcdef";
+    const uint32_t count = st_trace_count();
+    const uint32_t first = st_trace.head - count;
+    char *out = cs.out_buf;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if ((i & 0x0F) == 0) {
+            out = cs.out_buf;
+            if (js.json_mode != TEXT_MODE) {
+                out += sprintf(out, "{\"trd\":\"");
+            }
+        }
+        const uint8_t *b = (const uint8_t *)&st_trace.buf[(first + i) & STEP_TRACE_BUFFER_MASK];
+        for (uint8_t j = 0; j < sizeof(stTraceRecord_t); j++) {
+            *out++ = hex[b[j] >> 4];
+            *out++ = hex[b[j] & 0x0F];
+        }
+        if (((i & 0x0F) == 0x0F) || (i == count-1)) {
+            if (js.json_mode != TEXT_MODE) {
+                *out++ = '"';
+                *out++ = '}';
+            }
+            *out++ = '\n';
+            *out = NUL;
+            xio_writeline(cs.out_buf);
+        }
+    }
+}
+
+#ifdef __POSIX_SIM__
+static void _write_trace_file()
+{
+    st_trace.mode = TRACE_OFF;
+    FILE *f = fopen(_trace_file, "wb");
+    if (f == NULL) {
+        perror("posix-sim: unable to write step trace");
+        return;
+    }
+    const uint32_t count = st_trace_count();
+    const uint32_t first = st_trace.head - count;
+    for (uint32_t i = 0; i < count; i++) {
+        fwrite(&st_trace.buf[(first + i) & STEP_TRACE_BUFFER_MASK], sizeof(stTraceRecord_t), 1, f);
+    }
+    fclose(f);
+}
+#endif
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * st_trace_get_trc() - get trace mode
+ * st_trace_set_trc() - set trace mode; clears the buffer
+ * st_trace_get_trn() - get number of records in the buffer
+ * st_trace_get_trd() - stop recording and dump the buffer. Returns the record count
+ */
+
+stat_t st_trace_get_trc(nvObj_t *nv)
+{
+    nv->value = (float)st_trace.mode;
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t st_trace_set_trc(nvObj_t *nv)
+{
+    if (nv->value < TRACE_OFF) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (nv->value > TRACE_CONTINUOUS) {
+        nv->valuetype = TYPE_NULL;
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    st_trace_start((stTraceMode)nv->value);
+    return (STAT_OK);
+}
+
+stat_t st_trace_get_trn(nvObj_t *nv)
+{
+    nv->value = (float)st_trace_count();
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+stat_t st_trace_get_trd(nvObj_t *nv)
+{
+    st_trace.mode = TRACE_OFF;      // freeze the buffer while it's read out
+    _dump_records();
+#ifdef __POSIX_SIM__
+    if (_trace_file != NULL) {
+        _write_trace_file();
+    }
+#endif
+    nv->value = (float)st_trace_count();
+    nv->valuetype = TYPE_INT;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_trc[] = "[trc] step trace mode%14d [0=off,1=one-shot,2=continuous]\n";
+static const char fmt_trn[] = "step trace records:%d\n";
+
+void st_trace_print_trc(nvObj_t *nv) { text_print(nv, fmt_trc);}    // TYPE_INT
+void st_trace_print_trn(nvObj_t *nv) { text_print(nv, fmt_trn);}    // TYPE_INT
+
+#endif // __TEXT_MODE
+
+#else
+
+void st_trace_init() {}
+
+#endif // STEP_TRACE_ENABLED
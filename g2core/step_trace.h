@@ -0,0 +1,195 @@
+/*
+ * step_trace.h - deterministic step pulse trace recorder
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * STEP TRACE
+ *
+ *	The step trace records what the DDA actually emits so pulse timing can be checked
+ *	after the fact, and so two builds (or a board and the posix-sim) can be compared
+ *	bit-for-bit on the same Gcode. It is compiled in only if STEP_TRACE_ENABLED is true,
+ *	and costs one test per DDA tick while compiled in but not recording.
+ *
+ *	Records are 8 bytes and go into a power-of-2 ring buffer:
+ *
+ *	  TRACE_SEGMENT     value = dda_ticks of the segment just loaded (aux = block type)
+ *	  TRACE_MOTOR       value = substep_increment (whole steps with DDA_INTEGER_STEPS - see
+ *	                    stepper.h), motor = motor, aux = direction | correction flag
+ *	  TRACE_PHASE       value = substep_accumulator at the segment boundary, before correction
+ *	  TRACE_CORRECTION  value = accumulator_correction (float bits) applied at the boundary
+ *	  TRACE_STEP        value = DDA tick number (since trace start), motor = step bitmask
+ *	  TRACE_DWELL       value = dwell_ticks
+ *
+ *	TRACE_STEP records are only written on ticks that emit at least one step, so the
+ *	tick number carries the pulse timing. Jitter is the spread of the tick deltas;
+ *	phase errors show up as TRACE_PHASE values that do not carry across segments.
+ *
+ *	Modes ($trc):
+ *	  0 = off
+ *	  1 = one-shot - record from the start until the buffer is full, then stop
+ *	  2 = continuous - ring buffer, keeps the most recent STEP_TRACE_BUFFER_SIZE records
+ *
+ *	Writers run at DDA interrupt level (or in _load_move() while the DDA is idle),
+ *	so no locking is done. Setting $trc clears the buffer. Reading $trd stops recording
+ *	and dumps the buffer oldest-first as hex lines. On the posix-sim the buffer is also
+ *	written as raw records to the file named by the G2CORE_STEP_TRACE environment
+ *	variable when the trace is dumped or the simulator exits. Setting that variable
+ *	starts a one-shot trace at power-up.
+ */
+
+#ifndef STEP_TRACE_H_ONCE
+#define STEP_TRACE_H_ONCE
+
+#include "hardware.h"   // for MOTORS and board-level overrides
+
+/**** Configs and Constants ****/
+
+#ifndef STEP_TRACE_ENABLED
+#define STEP_TRACE_ENABLED false            // {true, false}
+#endif
+
+#ifndef STEP_TRACE_BUFFER_SIZE
+#define STEP_TRACE_BUFFER_SIZE 512          // records (8 bytes each). Must be a power of 2
+#endif
+
+#define STEP_TRACE_BUFFER_MASK (STEP_TRACE_BUFFER_SIZE-1)
+
+typedef enum {
+    TRACE_OFF = 0,                          // not recording
+    TRACE_ONE_SHOT,                         // record until full, then stop
+    TRACE_CONTINUOUS                        // overwrite oldest records
+} stTraceMode;
+
+typedef enum {
+    TRACE_SEGMENT = 1,
+    TRACE_MOTOR,
+    TRACE_PHASE,
+    TRACE_CORRECTION,
+    TRACE_STEP,
+    TRACE_DWELL
+} stTraceType;
+
+#define TRACE_DIRECTION_BIT     0x0001      // aux bits for TRACE_MOTOR records
+#define TRACE_CORRECTION_BIT    0x0002
+
+/**** Structures ****/
+
+typedef struct stTraceRecord {              // 8 bytes, little endian on all supported targets
+    uint8_t type;                           // stTraceType
+    uint8_t motor;                          // motor number, or step bitmask for TRACE_STEP
+    uint16_t aux;                           // type-dependent flags
+    uint32_t value;                         // type-dependent value
+} stTraceRecord_t;
+
+typedef struct stTrace {
+    volatile uint8_t mode;                  // stTraceMode
+    uint8_t step_mask;                      // motors stepped in the current DDA tick
+    uint32_t tick;                          // DDA ticks since the trace was started
+    uint32_t head;                          // total records written (wraps modulo 2^32)
+    stTraceRecord_t buf[STEP_TRACE_BUFFER_SIZE];
+} stTrace_t;
+
+extern stTrace_t st_trace;
+
+/**** Macros and inlines ****/
+// used to keep the trace code out of the stepper so it can be managed in one place
+
+#if (STEP_TRACE_ENABLED == true)
+
+inline void st_trace_record(const uint8_t type, const uint8_t motor, const uint16_t aux, const uint32_t value)
+{
+    if (st_trace.mode == TRACE_OFF) {
+        return;
+    }
+    if ((st_trace.mode == TRACE_ONE_SHOT) && (st_trace.head >= STEP_TRACE_BUFFER_SIZE)) {
+        st_trace.mode = TRACE_OFF;
+        return;
+    }
+    stTraceRecord_t *r = &st_trace.buf[st_trace.head++ & STEP_TRACE_BUFFER_MASK];
+    r->type = type;
+    r->motor = motor;
+    r->aux = aux;
+    r->value = value;
+}
+
+inline uint32_t st_trace_float_bits(const float f)
+{
+    union { float f; uint32_t u; } bits;
+    bits.f = f;
+    return (bits.u);
+}
+
+#define TRACE_STEP(m) st_trace.step_mask |= (1<<m);
+#define TRACE_TICK()                                                            \
+    if (st_trace.mode != TRACE_OFF) {                                           \
+        if (st_trace.step_mask) {                                               \
+            st_trace_record(TRACE_STEP, st_trace.step_mask, 0, st_trace.tick);  \
+        }                                                                       \
+        st_trace.tick++;                                                        \
+    }                                                                           \
+    st_trace.step_mask = 0;
+#define TRACE_SEGMENT(ticks, type) st_trace_record(TRACE_SEGMENT, 0, type, ticks);
+#define TRACE_PHASE(m, acc) st_trace_record(TRACE_PHASE, m, 0, (uint32_t)(acc));
+#define TRACE_CORRECTION(m, c) st_trace_record(TRACE_CORRECTION, m, 0, st_trace_float_bits(c));
+#define TRACE_MOTOR(m, inc, dir, corr) \
+    st_trace_record(TRACE_MOTOR, m, ((dir) ? TRACE_DIRECTION_BIT : 0) | ((corr) ? TRACE_CORRECTION_BIT : 0), (uint32_t)(inc));
+#define TRACE_DWELL(ticks) st_trace_record(TRACE_DWELL, 0, 0, ticks);
+
+#else
+
+#define TRACE_STEP(m)
+#define TRACE_TICK()
+#define TRACE_SEGMENT(ticks, type)
+#define TRACE_PHASE(m, acc)
+#define TRACE_CORRECTION(m, c)
+#define TRACE_MOTOR(m, inc, dir, corr)
+#define TRACE_DWELL(ticks)
+
+#endif // STEP_TRACE_ENABLED
+
+/**** FUNCTION PROTOTYPES ****/
+
+void st_trace_init(void);
+void st_trace_start(stTraceMode mode);
+uint32_t st_trace_count(void);
+
+stat_t st_trace_get_trc(nvObj_t *nv);
+stat_t st_trace_set_trc(nvObj_t *nv);
+stat_t st_trace_get_trn(nvObj_t *nv);
+stat_t st_trace_get_trd(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void st_trace_print_trc(nvObj_t *nv);
+    void st_trace_print_trn(nvObj_t *nv);
+
+#else
+
+    #define st_trace_print_trc tx_print_stub
+    #define st_trace_print_trn tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif  // End of include guard: STEP_TRACE_H_ONCE
@@ -33,7 +33,10 @@
 #include "config.h"
 #include "stepper.h"
 #include "encoder.h"
+#include "step_trace.h"
+#include "profiler.h"
 #include "planner.h"
+#include "kinematics.h"
 #include "hardware.h"
 #include "text_parser.h"
 #include "util.h"
@@ -63,6 +66,33 @@ static stRunSingleton_t st_run;
 /**** Static functions ****/
 
 static void _load_move(void);
+static void _prep_sync(void);
+static bool _cycle_end_if_drained(void);
+
+// prep queue helpers. The exec is the only writer of head, the loader the only writer of tail.
+// Both are free running, so head - tail is the number of queued segments.
+#define _prep_queue_count() ((uint8_t)(st_pre.head - st_pre.tail))
+#define _prep_queue_barrier() __asm__ __volatile__ ("" ::: "memory")   // finish slot writes before publishing it
+
+// DDA phase at segment boundaries (see DDA integer steps in stepper.h)
+// CORRECT_PHASE keeps the accumulator phase when the segment time changes, FLIP_PHASE
+// reflects it about its midpoint when the direction changes.
+#if (DDA_INTEGER_STEPS == true)
+#define CORRECT_PHASE(seg, m)                                                           \
+    if (st_run.mot[m].substep_accumulator <= -(int32_t)st_run.dda_ticks_X_substeps) {  \
+        st_run.mot[m].substep_accumulator = 1 - (int32_t)st_run.dda_ticks_X_substeps;   \
+    }
+#define FLIP_PHASE(m) \
+    st_run.mot[m].substep_accumulator = 1 - (int32_t)st_run.dda_ticks_X_substeps - st_run.mot[m].substep_accumulator
+#else
+#define CORRECT_PHASE(seg, m)                                                           \
+    if (seg->mot[m].accumulator_correction_flag == true) {                              \
+        st_run.mot[m].substep_accumulator *= seg->mot[m].accumulator_correction;        \
+        TRACE_CORRECTION(m, seg->mot[m].accumulator_correction);                        \
+    }
+#define FLIP_PHASE(m) \
+    st_run.mot[m].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[m].substep_accumulator)
+#endif
 
 // handy macro
 //#define _f_to_period(f) (uint16_t)((float)F_CPU / (float)f)
@@ -80,7 +110,7 @@ exec_timer_type exec_timer;         // triggers calculation of next+1 stepper se
 fwd_plan_timer_type fwd_plan_timer; // triggers planning of next block
 
 // SystickEvent for handling dweels (must be registered before it is active)
-Motate::SysTickEvent dwell_systick_event {[&] {
+Motate::SysTickEvent dwell_systick_event {[] {
     if (--st_run.dwell_ticks_downcount == 0) {
         SysTickTimer.unregisterEvent(&dwell_systick_event);
         _load_move();       // load the next move at the current interrupt level
@@ -126,7 +156,6 @@ void stepper_init()
 
     // setup software interrupt exec timer & initial condition
     exec_timer.setInterrupts(kInterruptOnSoftwareTrigger | kInterruptPriorityHigh);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;
 
     // setup software interrupt forward plan timer & initial condition
     fwd_plan_timer.setInterrupts(kInterruptOnSoftwareTrigger | kInterruptPriorityMedium);
@@ -151,11 +180,13 @@ void stepper_reset()
     dda_timer.stop();                                   // stop all movement
     st_run.dda_ticks_downcount = 0;                     // signal the runtime is not busy
     st_run.dwell_ticks_downcount = 0;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // set to EXEC or it won't restart
+    st_pre.head = 0;                                    // empty the prep queue or it won't restart
+    st_pre.tail = 0;
+    st_pre.sync_pending = false;
+    st_pre.cycle_end_pending = false;
 
     for (uint8_t motor=0; motor<MOTORS; motor++) {
-        st_pre.mot[motor].prev_direction = STEP_INITIAL_DIRECTION;
-        st_pre.mot[motor].direction = STEP_INITIAL_DIRECTION;
+        st_run.mot[motor].prev_direction = STEP_INITIAL_DIRECTION;
         st_run.mot[motor].substep_accumulator = 0;      // will become max negative during per-motor setup;
         st_pre.mot[motor].corrected_steps = 0;          // diagnostic only - no action effect
     }
@@ -186,17 +217,24 @@ stat_t stepper_test_assertions()
 
 /*
  * st_runtime_isbusy() - return TRUE if runtime is busy:
+ * _runtime_isbusy()   - return TRUE if the DDA or dwell is running (loader's view)
  *
  *  Busy conditions:
  *  - motors are running
  *  - dwell is running
+ *  - segments are waiting in the prep queue
  */
 
-bool st_runtime_isbusy()
+static bool _runtime_isbusy()
 {
     return (st_run.dda_ticks_downcount || st_run.dwell_ticks_downcount);    // returns false if down count is zero
 }
 
+bool st_runtime_isbusy()
+{
+    return (_runtime_isbusy() || (_prep_queue_count() != 0));
+}
+
 /*
  * st_clc() - clear counters
  */
@@ -220,7 +258,6 @@ stat_t st_motor_power_callback()     // called by controller
 
     bool have_actually_stopped = false;
     if ((!st_runtime_isbusy()) &&
-        (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER) &&
         (cm_get_cycle_state() == CYCLE_OFF)
         )
     {    // if there are no moves to load...
@@ -301,17 +338,20 @@ void dda_timer_type::interrupt()
             motor_1.stepStart();        // turn step bit on
             st_run.mot[MOTOR_1].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_1);
+            TRACE_STEP(MOTOR_1);
         }
         if ((st_run.mot[MOTOR_2].substep_accumulator += st_run.mot[MOTOR_2].substep_increment) > 0) {
             motor_2.stepStart();        // turn step bit on
             st_run.mot[MOTOR_2].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_2);
+            TRACE_STEP(MOTOR_2);
         }
 #if MOTORS > 2
         if ((st_run.mot[MOTOR_3].substep_accumulator += st_run.mot[MOTOR_3].substep_increment) > 0) {
             motor_3.stepStart();        // turn step bit on
             st_run.mot[MOTOR_3].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_3);
+            TRACE_STEP(MOTOR_3);
         }
 #endif
 #if MOTORS > 3
@@ -319,6 +359,7 @@ void dda_timer_type::interrupt()
             motor_4.stepStart();        // turn step bit on
             st_run.mot[MOTOR_4].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_4);
+            TRACE_STEP(MOTOR_4);
         }
 #endif
 #if MOTORS > 4
@@ -326,6 +367,7 @@ void dda_timer_type::interrupt()
             motor_5.stepStart();        // turn step bit on
             st_run.mot[MOTOR_5].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_5);
+            TRACE_STEP(MOTOR_5);
         }
 #endif
 #if MOTORS > 5
@@ -333,9 +375,12 @@ void dda_timer_type::interrupt()
             motor_6.stepStart();        // turn step bit on
             st_run.mot[MOTOR_6].substep_accumulator -= st_run.dda_ticks_X_substeps;
             INCREMENT_ENCODER(MOTOR_6);
+            TRACE_STEP(MOTOR_6);
         }
 #endif
 
+    TRACE_TICK();
+
     // Process end of segment. 
     // One more interrupt will occur to turn of any pulses set in this pass.
     if (--st_run.dda_ticks_downcount == 0) {
@@ -362,12 +407,21 @@ namespace Motate {    // Define timer inside Motate namespace
     void exec_timer_type::interrupt()
     {
         exec_timer.getInterruptCause();                    // clears the interrupt condition
-        if (st_pre.buffer_state == PREP_BUFFER_OWNED_BY_EXEC) {
+        if ((_prep_queue_count() < STEP_PREP_QUEUE_SIZE) && (!st_pre.sync_pending)) {
             stepper_debug("E>");
-            if (mp_exec_move() != STAT_NOOP) {
+            uint8_t head = st_pre.head;
+            PROF_START(prof_start);
+            stat_t status = mp_exec_move();
+            PROF_END(prof_start, PROF_EXEC_MOVE);
+            if (status != STAT_NOOP) {
                 stepper_debug("E+\n");
-                st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER; // flip it back
+                if (head == st_pre.head) {                  // state change only - have the loader call us back
+                    _prep_sync();
+                }
                 st_request_load_move();
+                if ((_prep_queue_count() < STEP_PREP_QUEUE_SIZE) && (!st_pre.sync_pending)) {
+                    st_request_exec_move();                 // keep running ahead
+                }
                 return;
             }
             stepper_debug("E-\n");
@@ -408,11 +462,11 @@ namespace Motate {    // Define timer inside Motate namespace
 
 void st_request_load_move()
 {
-    if (st_runtime_isbusy()) {                                      // don't request a load if the runtime is busy
+    if (_runtime_isbusy()) {                                        // don't request a load if the runtime is busy
         return;
     }
     stepper_debug("l");
-    if (st_pre.buffer_state == PREP_BUFFER_OWNED_BY_LOADER) {       // bother interrupting
+    if (_prep_queue_count() != 0) {                                 // bother interrupting
         stepper_debug("_");
         _load_move();
     }
@@ -425,6 +479,8 @@ void st_request_load_move()
  *  higher level as the DDA or dwell ISR. A software interrupt has been
  *  provided to allow a non-ISR to request a load (st_request_load_move())
  *
+ *  Loads the oldest segment in the prep queue and hands its slot back to the exec.
+ *
  *  In aline() code:
  *   - All axes must set steps and compensate for out-of-range pulse phasing.
  *   - If axis has 0 steps the direction setting can be omitted
@@ -435,15 +491,19 @@ static void _load_move()
 {
     // Be aware that dda_ticks_downcount must equal zero for the loader to run.
     // So the initial load must also have this set to zero as part of initialization
-    if (st_runtime_isbusy()) {
+    if (_runtime_isbusy()) {
         return;                                                    // exit if the runtime is busy
     }
-    if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER) {    // if there are no moves to load...
+    if (_prep_queue_count() == 0) {                                // if there are no moves to load...
 
+        if (_cycle_end_if_drained()) {
+            return;                                                // a new block came in - carry on with it
+        }
         if (cm.motion_state == MOTION_RUN)  {
+            BENCH_COUNT(underruns);
 #if IN_DEBUGGER == 1
 //#warning debbugger REQUIRED for running this firmware!
-//            __asm__("BKPT"); // attempted to _load_move with PREP_BUFFER_OWNED_BY_EXEC and cm.motion_state == MOTION_RUN
+//            __asm__("BKPT"); // attempted to _load_move with an empty prep queue and cm.motion_state == MOTION_RUN
 #endif
             st_request_exec_move();
             return;
@@ -470,17 +530,19 @@ static void _load_move()
 #endif
         stepper_debug("•");
         return;
-    } // if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER)
+    } // if (_prep_queue_count() == 0)
 
     stepper_debug("^");
+    const stPrepSegment_t *seg = &st_pre.seg[st_pre.tail & STEP_PREP_QUEUE_MASK];
 
     // handle aline loads first (most common case)  NB: there are no more lines, only alines
-    if (st_pre.block_type == BLOCK_TYPE_ALINE) {
+    if (seg->block_type == BLOCK_TYPE_ALINE) {
 
         //**** setup the new segment ****
 
-        st_run.dda_ticks_downcount = st_pre.dda_ticks;
-        st_run.dda_ticks_X_substeps = st_pre.dda_ticks_X_substeps;
+        st_run.dda_ticks_downcount = seg->dda_ticks;
+        st_run.dda_ticks_X_substeps = seg->dda_ticks_X_substeps;
+        TRACE_SEGMENT(seg->dda_ticks, BLOCK_TYPE_ALINE);
 
         // INLINED VERSION: 4.3us
         //**** MOTOR_1 LOAD ****
@@ -489,152 +551,223 @@ static void _load_move()
         // is supposed to take < 5 uSec (Arm M3 core). Be careful if you mess with this.
 
         // the following if() statement sets the runtime substep increment value or zeroes it
-        if ((st_run.mot[MOTOR_1].substep_increment = st_pre.mot[MOTOR_1].substep_increment) != 0) {
+        if ((st_run.mot[MOTOR_1].substep_increment = seg->mot[MOTOR_1].substep_increment) != 0) {
 
             // NB: If motor has 0 steps the following is all skipped. This ensures that state comparisons
             //     always operate on the last segment actually run by this motor, regardless of how many
             //     segments it may have been inactive in between.
 
+            TRACE_PHASE(MOTOR_1, st_run.mot[MOTOR_1].substep_accumulator);
+            TRACE_MOTOR(MOTOR_1, seg->mot[MOTOR_1].substep_increment, seg->mot[MOTOR_1].direction, seg->mot[MOTOR_1].accumulator_correction_flag);
+
             // Apply accumulator correction if the time base has changed since previous segment
-            if (st_pre.mot[MOTOR_1].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_1].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_1].substep_accumulator *= st_pre.mot[MOTOR_1].accumulator_correction;
-            }
+            CORRECT_PHASE(seg, MOTOR_1);
 
             // Detect direction change and if so:
             //    Set the direction bit in hardware.
             //    Compensate for direction change by flipping substep accumulator value about its midpoint.
 
-            if (st_pre.mot[MOTOR_1].direction != st_pre.mot[MOTOR_1].prev_direction) {
-                st_pre.mot[MOTOR_1].prev_direction = st_pre.mot[MOTOR_1].direction;
-                st_run.mot[MOTOR_1].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_1].substep_accumulator);
-                motor_1.setDirection(st_pre.mot[MOTOR_1].direction);
+            if (seg->mot[MOTOR_1].direction != st_run.mot[MOTOR_1].prev_direction) {
+                st_run.mot[MOTOR_1].prev_direction = seg->mot[MOTOR_1].direction;
+                FLIP_PHASE(MOTOR_1);
+                motor_1.setDirection(seg->mot[MOTOR_1].direction);
             }
 
             // Enable the stepper and start/update motor power management
             motor_1.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_1, st_pre.mot[MOTOR_1].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_1, seg->mot[MOTOR_1].step_sign);
 
         } else {  // Motor has 0 steps; might need to energize motor for power mode processing
             motor_1.motionStopped();
         }
         // accumulate counted steps to the step position and zero out counted steps for the segment currently being loaded
         ACCUMULATE_ENCODER(MOTOR_1);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_1, seg->commanded_steps[MOTOR_1]);
 
 #if (MOTORS >= 2)
-        if ((st_run.mot[MOTOR_2].substep_increment = st_pre.mot[MOTOR_2].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_2].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_2].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_2].substep_accumulator *= st_pre.mot[MOTOR_2].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_2].direction != st_pre.mot[MOTOR_2].prev_direction) {
-                st_pre.mot[MOTOR_2].prev_direction = st_pre.mot[MOTOR_2].direction;
-                st_run.mot[MOTOR_2].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_2].substep_accumulator);
-                motor_2.setDirection(st_pre.mot[MOTOR_2].direction);
+        if ((st_run.mot[MOTOR_2].substep_increment = seg->mot[MOTOR_2].substep_increment) != 0) {
+            TRACE_PHASE(MOTOR_2, st_run.mot[MOTOR_2].substep_accumulator);
+            TRACE_MOTOR(MOTOR_2, seg->mot[MOTOR_2].substep_increment, seg->mot[MOTOR_2].direction, seg->mot[MOTOR_2].accumulator_correction_flag);
+            CORRECT_PHASE(seg, MOTOR_2);
+            if (seg->mot[MOTOR_2].direction != st_run.mot[MOTOR_2].prev_direction) {
+                st_run.mot[MOTOR_2].prev_direction = seg->mot[MOTOR_2].direction;
+                FLIP_PHASE(MOTOR_2);
+                motor_2.setDirection(seg->mot[MOTOR_2].direction);
             }
             motor_2.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_2, st_pre.mot[MOTOR_2].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_2, seg->mot[MOTOR_2].step_sign);
         } else {
             motor_2.motionStopped();
         }
         ACCUMULATE_ENCODER(MOTOR_2);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_2, seg->commanded_steps[MOTOR_2]);
 #endif
 #if (MOTORS >= 3)
-        if ((st_run.mot[MOTOR_3].substep_increment = st_pre.mot[MOTOR_3].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_3].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_3].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_3].substep_accumulator *= st_pre.mot[MOTOR_3].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_3].direction != st_pre.mot[MOTOR_3].prev_direction) {
-                st_pre.mot[MOTOR_3].prev_direction = st_pre.mot[MOTOR_3].direction;
-                st_run.mot[MOTOR_3].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_3].substep_accumulator);
-                motor_3.setDirection(st_pre.mot[MOTOR_3].direction);
+        if ((st_run.mot[MOTOR_3].substep_increment = seg->mot[MOTOR_3].substep_increment) != 0) {
+            TRACE_PHASE(MOTOR_3, st_run.mot[MOTOR_3].substep_accumulator);
+            TRACE_MOTOR(MOTOR_3, seg->mot[MOTOR_3].substep_increment, seg->mot[MOTOR_3].direction, seg->mot[MOTOR_3].accumulator_correction_flag);
+            CORRECT_PHASE(seg, MOTOR_3);
+            if (seg->mot[MOTOR_3].direction != st_run.mot[MOTOR_3].prev_direction) {
+                st_run.mot[MOTOR_3].prev_direction = seg->mot[MOTOR_3].direction;
+                FLIP_PHASE(MOTOR_3);
+                motor_3.setDirection(seg->mot[MOTOR_3].direction);
             }
             motor_3.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_3, st_pre.mot[MOTOR_3].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_3, seg->mot[MOTOR_3].step_sign);
         } else {
             motor_3.motionStopped();
         }
         ACCUMULATE_ENCODER(MOTOR_3);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_3, seg->commanded_steps[MOTOR_3]);
 #endif
 #if (MOTORS >= 4)
-        if ((st_run.mot[MOTOR_4].substep_increment = st_pre.mot[MOTOR_4].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_4].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_4].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_4].substep_accumulator *= st_pre.mot[MOTOR_4].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_4].direction != st_pre.mot[MOTOR_4].prev_direction) {
-                st_pre.mot[MOTOR_4].prev_direction = st_pre.mot[MOTOR_4].direction;
-                st_run.mot[MOTOR_4].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_4].substep_accumulator);
-                motor_4.setDirection(st_pre.mot[MOTOR_4].direction);
+        if ((st_run.mot[MOTOR_4].substep_increment = seg->mot[MOTOR_4].substep_increment) != 0) {
+            TRACE_PHASE(MOTOR_4, st_run.mot[MOTOR_4].substep_accumulator);
+            TRACE_MOTOR(MOTOR_4, seg->mot[MOTOR_4].substep_increment, seg->mot[MOTOR_4].direction, seg->mot[MOTOR_4].accumulator_correction_flag);
+            CORRECT_PHASE(seg, MOTOR_4);
+            if (seg->mot[MOTOR_4].direction != st_run.mot[MOTOR_4].prev_direction) {
+                st_run.mot[MOTOR_4].prev_direction = seg->mot[MOTOR_4].direction;
+                FLIP_PHASE(MOTOR_4);
+                motor_4.setDirection(seg->mot[MOTOR_4].direction);
             }
             motor_4.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_4, st_pre.mot[MOTOR_4].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_4, seg->mot[MOTOR_4].step_sign);
         } else {
             motor_4.motionStopped();
         }
         ACCUMULATE_ENCODER(MOTOR_4);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_4, seg->commanded_steps[MOTOR_4]);
 #endif
 #if (MOTORS >= 5)
-        if ((st_run.mot[MOTOR_5].substep_increment = st_pre.mot[MOTOR_5].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_5].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_5].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_5].substep_accumulator *= st_pre.mot[MOTOR_5].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_5].direction != st_pre.mot[MOTOR_5].prev_direction) {
-                st_pre.mot[MOTOR_5].prev_direction = st_pre.mot[MOTOR_5].direction;
-                st_run.mot[MOTOR_5].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_5].substep_accumulator);
-                motor_5.setDirection(st_pre.mot[MOTOR_5].direction);
+        if ((st_run.mot[MOTOR_5].substep_increment = seg->mot[MOTOR_5].substep_increment) != 0) {
+            TRACE_PHASE(MOTOR_5, st_run.mot[MOTOR_5].substep_accumulator);
+            TRACE_MOTOR(MOTOR_5, seg->mot[MOTOR_5].substep_increment, seg->mot[MOTOR_5].direction, seg->mot[MOTOR_5].accumulator_correction_flag);
+            CORRECT_PHASE(seg, MOTOR_5);
+            if (seg->mot[MOTOR_5].direction != st_run.mot[MOTOR_5].prev_direction) {
+                st_run.mot[MOTOR_5].prev_direction = seg->mot[MOTOR_5].direction;
+                FLIP_PHASE(MOTOR_5);
+                motor_5.setDirection(seg->mot[MOTOR_5].direction);
             }
             motor_5.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_5, st_pre.mot[MOTOR_5].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_5, seg->mot[MOTOR_5].step_sign);
         } else {
             motor_5.motionStopped();
         }
         ACCUMULATE_ENCODER(MOTOR_5);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_5, seg->commanded_steps[MOTOR_5]);
 #endif
 #if (MOTORS >= 6)
-        if ((st_run.mot[MOTOR_6].substep_increment = st_pre.mot[MOTOR_6].substep_increment) != 0) {
-            if (st_pre.mot[MOTOR_6].accumulator_correction_flag == true) {
-                st_pre.mot[MOTOR_6].accumulator_correction_flag = false;
-                st_run.mot[MOTOR_6].substep_accumulator *= st_pre.mot[MOTOR_6].accumulator_correction;
-            }
-            if (st_pre.mot[MOTOR_6].direction != st_pre.mot[MOTOR_6].prev_direction) {
-                st_pre.mot[MOTOR_6].prev_direction = st_pre.mot[MOTOR_6].direction;
-                st_run.mot[MOTOR_6].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_6].substep_accumulator);
-                motor_6.setDirection(st_pre.mot[MOTOR_6].direction);
+        if ((st_run.mot[MOTOR_6].substep_increment = seg->mot[MOTOR_6].substep_increment) != 0) {
+            TRACE_PHASE(MOTOR_6, st_run.mot[MOTOR_6].substep_accumulator);
+            TRACE_MOTOR(MOTOR_6, seg->mot[MOTOR_6].substep_increment, seg->mot[MOTOR_6].direction, seg->mot[MOTOR_6].accumulator_correction_flag);
+            CORRECT_PHASE(seg, MOTOR_6);
+            if (seg->mot[MOTOR_6].direction != st_run.mot[MOTOR_6].prev_direction) {
+                st_run.mot[MOTOR_6].prev_direction = seg->mot[MOTOR_6].direction;
+                FLIP_PHASE(MOTOR_6);
+                motor_6.setDirection(seg->mot[MOTOR_6].direction);
             }
             motor_6.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_6, st_pre.mot[MOTOR_6].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_6, seg->mot[MOTOR_6].step_sign);
         } else {
             motor_6.motionStopped();
         }
         ACCUMULATE_ENCODER(MOTOR_6);
+        SET_ENCODER_COMMANDED_STEPS(MOTOR_6, seg->commanded_steps[MOTOR_6]);
 #endif
 
+        ADVANCE_ENCODER_SAMPLE();                       // encoder and commanded steps now describe this load
+
         //**** do this last ****
 
         dda_timer.start();                              // start the DDA timer if not already running
+        st_pre.tail++;                                  // we are done with the slot - hand it back to the exec
 
     // handle dwells and commands
-    } else if (st_pre.block_type == BLOCK_TYPE_DWELL) {
-        st_run.dwell_ticks_downcount = st_pre.dwell_ticks;
+    } else if (seg->block_type == BLOCK_TYPE_DWELL) {
+        st_run.dwell_ticks_downcount = seg->dwell_ticks;
+        TRACE_DWELL(seg->dwell_ticks);
+        st_pre.tail++;
+        st_pre.sync_pending = false;
 
         // We now use SysTick events to handle dwells
         SysTickTimer.registerEvent(&dwell_systick_event);
 
         // handle synchronous commands
-    } else if (st_pre.block_type == BLOCK_TYPE_COMMAND) {
-        mp_runtime_command(st_pre.bf);
-        
-    } // else null - which is okay in many cases
-
-    // all other cases drop to here (e.g. Null moves after Mcodes skip to here)
-    st_pre.block_type = BLOCK_TYPE_NULL;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // we are done with the prep buffer - flip the flag back
+    } else if (seg->block_type == BLOCK_TYPE_COMMAND) {
+        mpBuf_t *bf = seg->bf;
+        st_pre.tail++;                                  // release the slot first - the command may reset the steppers
+        st_pre.sync_pending = false;
+        mp_runtime_command(bf);
+
+    } else {                                            // null - the exec just wants to be called back
+        st_pre.tail++;
+        st_pre.sync_pending = false;
+        if (_prep_queue_count() == 0) {
+            _cycle_end_if_drained();
+        }
+    }
     st_request_exec_move();                             // exec and prep next move
 }
 
+/*
+ * _cycle_end_if_drained() - end a cycle requested by st_prep_cycle_end()
+ *
+ *  Called by the loader with the DDA idle and the prep queue empty. Returns true if
+ *  the exec has a block to run instead, and has been asked to run it.
+ */
+
+static bool _cycle_end_if_drained()
+{
+    if (!st_pre.cycle_end_pending) {
+        return (false);
+    }
+    st_pre.cycle_end_pending = false;
+    st_pre.sync_pending = false;
+    if (mp_has_runnable_buffer()) {                     // queued after the exec found the planner empty
+        st_request_exec_move();
+        return (true);
+    }
+    cm_cycle_end();
+    return (false);
+}
+
+/***********************************************************************************
+ * _prep_slot()   - return the next free prep queue slot for the exec, or NULL if full
+ * _prep_commit() - publish the slot to the loader
+ */
+
+static stPrepSegment_t *_prep_slot()
+{
+    if (_prep_queue_count() >= STEP_PREP_QUEUE_SIZE) {
+        return (NULL);
+    }
+    return (&st_pre.seg[st_pre.head & STEP_PREP_QUEUE_MASK]);
+}
+
+static void _prep_commit()
+{
+    _prep_queue_barrier();
+    st_pre.head++;
+}
+
+/*
+ * _prep_sync() - queue a null segment. Used when the exec changed state without prepping anything
+ *
+ *  The loader calls the exec back once it gets to the null, which is after everything
+ *  queued ahead of it has been loaded - e.g. so a feedhold can see the steppers stop.
+ */
+
+static void _prep_sync()
+{
+    stPrepSegment_t *seg = _prep_slot();
+    if (seg == NULL) {                                      // never supposed to happen
+        return;
+    }
+    seg->block_type = BLOCK_TYPE_NULL;
+    st_pre.sync_pending = true;
+    _prep_commit();
+}
+
 /***********************************************************************************
  * st_prep_line() - Prepare the next move for the loader
  *
@@ -645,11 +778,16 @@ static void _load_move()
  *  floats and converted to their appropriate integer types for the loader.
  *
  * Args:
+ *    - commanded_steps[] is the step position the segment starts from. The loader
+ *      hands it to the encoder so the following error lines up with the segment
+ *      actually being run, however deep the prep queue is.
+ *
  *    - travel_steps[] are signed relative motion in steps for each motor. Steps are
  *      floats that typically have fractional values (fractional steps). The sign
  *      indicates direction. Motors that are not in the move should be 0 steps on input.
  *
  *    - following_error[] is a vector of measured errors to the step count. Used for correction.
+ *      Integer steps (see stepper.h) have no error to correct and ignore it.
  *
  *    - segment_time - how many minutes the segment should run. If timing is not
  *      100% accurate this will affect the move velocity, but not the distance traveled.
@@ -659,12 +797,14 @@ static void _load_move()
  *          dda_ticks_X_substeps = (int32_t)((microseconds/1000000) * f_dda * dda_substeps);
  */
 
-stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time)
+stat_t st_prep_line(const float commanded_steps[], float travel_steps[], float following_error[], float segment_time)
 {
     stepper_debug("😶");
+    stPrepSegment_t *seg = _prep_slot();
+
     // trap assertion failures and other conditions that would prevent queuing the line
-    if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_EXEC) {     // never supposed to happen
-        return (cm_panic(STAT_INTERNAL_ERROR, "st_prep_line() prep sync error"));
+    if (seg == NULL) {                                          // never supposed to happen
+        return (cm_panic(STAT_INTERNAL_ERROR, "st_prep_line() prep queue overflow"));
     } else if (isinf(segment_time)) {                           // never supposed to happen
         return (cm_panic(STAT_PREP_LINE_MOVE_TIME_IS_INFINITE, "st_prep_line()"));
     } else if (isnan(segment_time)) {                           // never supposed to happen
@@ -672,22 +812,54 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
 //    } else if (segment_time < EPSILON) {
 //        return (STAT_MINIMUM_TIME_MOVE);
     }
+    PROF_START(prof_start);                                     // timed from here - the traps above panic
     // setup segment parameters
     // - dda_ticks is the integer number of DDA clock ticks needed to play out the segment
     // - ticks_X_substeps is the maximum depth of the DDA accumulator (as a negative number)
 
-    //st_pre.dda_period = _f_to_period(FREQUENCY_DDA);                // FYI: this is a constant
-    st_pre.dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);// NB: converts minutes to seconds
-    st_pre.dda_ticks_X_substeps = st_pre.dda_ticks * DDA_SUBSTEPS;
+    //seg->dda_period = _f_to_period(FREQUENCY_DDA);                  // FYI: this is a constant
+    seg->dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);    // NB: converts minutes to seconds
+
+#if (DDA_INTEGER_STEPS == true)
+    seg->dda_ticks_X_substeps = seg->dda_ticks;             // the depth is the ticks - see DDA integer steps
+
+    // setup motor parameters. The step count is the segment's end rounded to a whole step,
+    // less the whole step the last segment ended on, so fractions carry in the position.
+
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        seg->commanded_steps[motor] = commanded_steps[motor];
+        seg->mot[motor].accumulator_correction_flag = false;
+
+        int32_t steps = (int32_t)lround(commanded_steps[motor] + travel_steps[motor]) - st_pre.mot[motor].step_position;
+        if (steps == 0) {
+            seg->mot[motor].substep_increment = 0;          // substep increment also acts as a motor flag
+            continue;
+        }
+        st_pre.mot[motor].step_position += steps;
+
+        if (steps > 0) {                                    // positive direction
+            seg->mot[motor].direction = DIRECTION_CW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = 1;
+            seg->mot[motor].substep_increment = steps;
+        } else {
+            seg->mot[motor].direction = DIRECTION_CCW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = -1;
+            seg->mot[motor].substep_increment = -steps;
+        }
+    }
+#else
+    seg->dda_ticks_X_substeps = seg->dda_ticks * DDA_SUBSTEPS;
 
     // setup motor parameters
 
     float correction_steps;
     for (uint8_t motor=0; motor<MOTORS; motor++) {          // remind us that this is motors, not axes
 
+        seg->commanded_steps[motor] = commanded_steps[motor];
+
         // Skip this motor if there are no new steps. Leave all other values intact.
         if (fp_ZERO(travel_steps[motor])) {
-            st_pre.mot[motor].substep_increment = 0;        // substep increment also acts as a motor flag
+            seg->mot[motor].substep_increment = 0;          // substep increment also acts as a motor flag
             continue;
         }
 
@@ -695,21 +867,22 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
         // Set the step_sign which is used by the stepper ISR to accumulate step position
 
         if (travel_steps[motor] >= 0) {                    // positive direction
-            st_pre.mot[motor].direction = DIRECTION_CW ^ st_cfg.mot[motor].polarity;
-            st_pre.mot[motor].step_sign = 1;
+            seg->mot[motor].direction = DIRECTION_CW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = 1;
         } else {
-            st_pre.mot[motor].direction = DIRECTION_CCW ^ st_cfg.mot[motor].polarity;
-            st_pre.mot[motor].step_sign = -1;
+            seg->mot[motor].direction = DIRECTION_CCW ^ st_cfg.mot[motor].polarity;
+            seg->mot[motor].step_sign = -1;
         }
 
         // Detect segment time changes and setup the accumulator correction factor and flag.
         // Putting this here computes the correct factor even if the motor was dormant for some
         // number of previous moves. Correction is computed based on the last segment time actually used.
 
+        seg->mot[motor].accumulator_correction_flag = false;
         if (fabs(segment_time - st_pre.mot[motor].prev_segment_time) > 0.0000001) { // highly tuned FP != compare
             if (fp_NOT_ZERO(st_pre.mot[motor].prev_segment_time)) {                    // special case to skip first move
-                st_pre.mot[motor].accumulator_correction_flag = true;
-                st_pre.mot[motor].accumulator_correction = segment_time / st_pre.mot[motor].prev_segment_time;
+                seg->mot[motor].accumulator_correction_flag = true;
+                seg->mot[motor].accumulator_correction = segment_time / st_pre.mot[motor].prev_segment_time;
             }
             st_pre.mot[motor].prev_segment_time = segment_time;
         }
@@ -736,33 +909,44 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
         // Rounding is performed to eliminate a negative bias in the uint32 conversion
         // that results in long-term negative drift. (fabs/round order doesn't matter)
 
-        st_pre.mot[motor].substep_increment = round(fabs(travel_steps[motor] * DDA_SUBSTEPS));
+        seg->mot[motor].substep_increment = round(fabs(travel_steps[motor] * DDA_SUBSTEPS));
     }
-    st_pre.block_type = BLOCK_TYPE_ALINE;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+#endif // DDA_INTEGER_STEPS
+    seg->block_type = BLOCK_TYPE_ALINE;
+    _prep_commit();                                         // signal that the segment is ready
     stepper_debug("👍🏻");
+    PROF_END(prof_start, PROF_PREP_LINE);
     return (STAT_OK);
 }
 
 /*
  * st_prep_null() - Keeps the loader happy. Otherwise performs no action
+ *
+ *  Nothing is queued - an empty prep queue is what tells the loader there is nothing to run.
  */
 
 void st_prep_null()
 {
-    st_pre.block_type = BLOCK_TYPE_NULL;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_EXEC;    // signal that prep buffer is empty
 }
 
 /*
  * st_prep_command() - Stage command to execution
+ *
+ *  Commands are sync points. The exec does not run ahead of them as the loader
+ *  runs the command and frees its planner buffer.
  */
 
 void st_prep_command(void *bf)
 {
-    st_pre.block_type = BLOCK_TYPE_COMMAND;
-    st_pre.bf = (mpBuf_t *)bf;
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    stPrepSegment_t *seg = _prep_slot();
+    if (seg == NULL) {                                      // never supposed to happen
+        cm_panic(STAT_INTERNAL_ERROR, "st_prep_command() prep queue overflow");
+        return;
+    }
+    seg->block_type = BLOCK_TYPE_COMMAND;
+    seg->bf = (mpBuf_t *)bf;
+    st_pre.sync_pending = true;
+    _prep_commit();                                         // signal that the command is ready
 }
 
 /*
@@ -771,10 +955,31 @@ void st_prep_command(void *bf)
 
 void st_prep_dwell(float microseconds)
 {
-    st_pre.block_type = BLOCK_TYPE_DWELL;
+    stPrepSegment_t *seg = _prep_slot();
+    if (seg == NULL) {                                      // never supposed to happen
+        cm_panic(STAT_INTERNAL_ERROR, "st_prep_dwell() prep queue overflow");
+        return;
+    }
+    seg->block_type = BLOCK_TYPE_DWELL;
     // we need dwell_ticks to be at least 1
-    st_pre.dwell_ticks = std::max((uint32_t)((microseconds/1000000) * FREQUENCY_DWELL), 1UL);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
+    seg->dwell_ticks = std::max((uint32_t)((microseconds/1000000) * FREQUENCY_DWELL), (uint32_t)1);
+    st_pre.sync_pending = true;
+    _prep_commit();                                         // signal that the dwell is ready
+}
+
+/*
+ * st_prep_cycle_end() - end the cycle once the steppers have run everything prepped so far
+ *
+ *  The exec finds the planner empty as soon as it has prepped the last segment, which is
+ *  up to STEP_PREP_QUEUE_SIZE segments before the steppers run it. So instead of ending
+ *  the cycle it holds itself like a sync point, and the loader ends the cycle when it
+ *  finds the queue drained and the DDA idle - unless a new block arrived in the meantime.
+ */
+
+void st_prep_cycle_end()
+{
+    st_pre.cycle_end_pending = true;
+    st_pre.sync_pending = true;                             // don't prep a new block until then
 }
 
 /*
@@ -785,7 +990,6 @@ void st_prep_dwell(float microseconds)
 void st_request_out_of_band_dwell(float microseconds)
 {
     st_prep_dwell(microseconds);
-    st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
     st_request_load_move();
 }
 
@@ -823,7 +1027,7 @@ static int8_t _get_motor(const index_t index)
 }
 
 /*
- * _set_motor_steps_per_unit() - what it says
+ * _set_motor_steps_per_unit() - what it says, and rebuild the kinematics motor map
  * This function will need to be rethought if microstep morphing is implemented
  */
 
@@ -832,6 +1036,7 @@ static void _set_motor_steps_per_unit(nvObj_t *nv)
     uint8_t m = _get_motor(nv->index);
     st_cfg.mot[m].units_per_step = (st_cfg.mot[m].travel_rev * st_cfg.mot[m].step_angle) / (360 * st_cfg.mot[m].microsteps);
     st_cfg.mot[m].steps_per_unit = 1/st_cfg.mot[m].units_per_step;
+    kn_map_motors();
 }
 
 /* PER-MOTOR FUNCTIONS
@@ -855,6 +1060,7 @@ stat_t st_set_ma(nvObj_t *nv)            // map motor to axis
         return (STAT_INPUT_EXCEEDS_MAX_VALUE);
     }
     set_ui8(nv);
+    kn_map_motors();
     return(STAT_OK);
 }
 
@@ -929,6 +1135,7 @@ stat_t st_set_su(nvObj_t *nv)			// motor steps per unit (direct)
     } 
     set_flt(nv);
     st_cfg.mot[m].units_per_step = 1.0/st_cfg.mot[m].steps_per_unit;
+    kn_map_motors();
 
     // Scale TR so all the other values make sense
     // You could scale any one of the other values, but TR makes the most sense
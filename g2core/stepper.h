@@ -160,7 +160,7 @@
  *    the "segment", usually ~1ms worth of pulses
  *
  *  - When the current segment is finished the stepper interrupt LOADs the next segment
- *    from the prep buffer, reloads the timers, and starts the next segment. At the end
+ *    from the prep queue, reloads the timers, and starts the next segment. At the end
  *    of the load the stepper interrupt routine requests an "exec" of the next move in
  *    order to prepare for the next load operation. It does this by calling the exec
  *    using a software interrupt (actually a timer, since that's all we've got).
@@ -177,7 +177,8 @@
  *
  *  - Once the segment has been computed the exec handler finishes up by running the
  *    PREP routine in stepper.cpp. This computes the DDA values and gets the segment
- *    into the prep buffer - and ready for the next LOAD operation.
+ *    into the prep queue - and ready for a later LOAD operation. The exec keeps going
+ *    until the queue is full, so several segments are normally waiting to be loaded.
  *
  *  - The main loop runs in background to receive gcode blocks, parse them, and send
  *    them to the planner in order to keep the planner queue full so that when the
@@ -217,7 +218,9 @@
  *      be needed to run the move - in this example st_prep_line().
  *
  *   7  st_prep_line() generates the timer and DDA values and stages these into
- *      the prep structure (sp) - ready for loading into the stepper runtime struct
+ *      the next free slot of the prep queue (st_pre) - ready for loading into the
+ *      stepper runtime struct. If there is still room in the queue the exec is
+ *      requested again right away, so it runs ahead of the loader (see below).
  *
  *   8  stepper.st_prep_line() returns back to planner.mp_exec_move(), which
  *      frees the planning buffer (bf) back to the planner buffer pool if the
@@ -236,6 +239,30 @@
  *  Note: For this to work you have to be really careful about what structures
  *  are modified at what level, and use volatiles where necessary.
  */
+/* The prep queue
+ *
+ *  The prep queue is a single-producer single-consumer ring of STEP_PREP_QUEUE_SIZE
+ *  prepped segments between the exec (producer, MED ISR) and the loader (consumer,
+ *  HI ISR). The exec only writes the head index and the loader only writes the tail
+ *  index, so no locking is needed. Keeping several segments ready lets the exec absorb
+ *  the occasional late run (kinematics, planning in a lower interrupt, serial) without
+ *  the DDA running dry.
+ *
+ *  Commands and dwells are sync points: the exec does not run ahead of them. Commands
+ *  are executed by the loader and free their own planner buffer, so the exec must not
+ *  see that buffer again until the loader has run it. So is the null entry the exec
+ *  queues when it changed state without prepping anything (e.g. the steps of a
+ *  feedhold) - it gets called back once everything ahead of it has loaded.
+ *
+ *  The end of a cycle is held the same way. The exec finds the planner empty up to
+ *  STEP_PREP_QUEUE_SIZE segments before the steppers run the last one, so it leaves
+ *  the cycle end to the loader, which reports it once the queue has drained and the
+ *  DDA is idle - see st_prep_cycle_end().
+ *
+ *  Because the DDA now runs several segments behind the exec, the following error is
+ *  measured against the commanded step position of the segment the loader last loaded
+ *  - see en_read_following_error() - not against the exec's previous segment.
+ */
 /* Partial steps and phase angle compensation
  *
  *  The DDA accepts partial steps as input. Fractional steps are managed by the
@@ -261,10 +288,10 @@
  *********************************/
 //See hardware.h for platform specific stepper definitions
 
-typedef enum {
-    PREP_BUFFER_OWNED_BY_LOADER = 0,    // staging buffer is ready for load
-    PREP_BUFFER_OWNED_BY_EXEC           // staging buffer is being loaded
-} prepBufferState;
+#ifndef STEP_PREP_QUEUE_SIZE
+#define STEP_PREP_QUEUE_SIZE 4          // prepped segments the exec can run ahead. Must be a power of 2
+#endif
+#define STEP_PREP_QUEUE_MASK (STEP_PREP_QUEUE_SIZE-1)
 
 typedef enum {                          // used w/start and stop flags to sequence motor power
     MOTOR_OFF = 0,                      // motor is stopped and deenergized
@@ -307,21 +334,51 @@ typedef enum {
  *
  *    MAX_LONG == 2^31, maximum signed long (depth of accumulator. NB: accumulator values are negative)
  *    FREQUENCY_DDA == DDA clock rate in Hz.
- *    NOM_SEGMENT_TIME == upper bound of segment time in minutes
+ *    MAX_SEGMENT_TIME == upper bound of segment time in minutes
  *    0.90 == a safety factor used to reduce the result from theoretical maximum
  *
  *  The number is about 8.5 million for the Xmega running a 50 KHz DDA with 5 millisecond segments
  *  The ARM is roughly the same as the DDA clock rate is 4x higher but the segment time is ~1/5
  *  Decreasing the nominal segment time increases the number precision.
+ *
+ *  MAX_SEGMENT_TIME is NOM_SEGMENT_MS unless ADAPTIVE_SEGMENTS_ENABLED lengthens cruise
+ *  segments (see planner.h), which costs every segment the same factor in substeps.
+ */
+#define DDA_SUBSTEPS ((MAX_LONG * 0.90) / (FREQUENCY_DDA * (MAX_SEGMENT_TIME * 60)))
+
+/* DDA integer steps
+ *
+ *  With DDA_INTEGER_STEPS true the DDA runs a plain integer Bresenham instead of substepping.
+ *  st_prep_line() rounds each segment's end position to a whole step and sends the difference
+ *  from the step the last segment ended on, so the fraction is carried in the absolute position
+ *  rather than in the DDA accumulator. The loader uses that count as the increment and the
+ *  segment's DDA ticks as the accumulator depth:
+ *
+ *    - A segment of n steps always emits exactly n steps, whatever phase it starts from, as long
+ *      as the accumulator starts inside (-dda_ticks, 0]. The loader clamps it into that range
+ *      when the segment time shrinks and flips it about the midpoint on a direction change,
+ *      instead of the float accumulator_correction.
+ *    - The motors end every move on the rounded commanded position, so there is no long-term
+ *      drift and no following error to correct: the 'nudge' correction is compiled out.
+ *    - st_prep_line() loses the substep multiply, the correction factor divide and the nudge.
+ *      The load loses a float multiply per motor whenever the segment time changes.
+ *
+ *  The cost is pulse timing where the segment time changes. Substepping rescales the accumulator
+ *  so the next step keeps its place; the integer DDA carries it unscaled (or clamped), so the
+ *  first step after the change can come early or late by up to one step period. Counts are
+ *  unaffected. The pulse rate ceiling is the same - one step per DDA tick either way.
+ *  Set it in hardware.h or on the compiler command line.
  */
-#define DDA_SUBSTEPS ((MAX_LONG * 0.90) / (FREQUENCY_DDA * (NOM_SEGMENT_TIME * 60)))
+#ifndef DDA_INTEGER_STEPS
+#define DDA_INTEGER_STEPS false             // {true, false}
+#endif
 
 /* Step correction settings
  *
  *  Step correction settings determine how the encoder error is fed back to correct position errors.
- *  Since the following_error is running 2 segments behind the current segment you have to be careful
- *  not to overcompensate. The threshold determines if a correction should be applied, and the factor
- *  is how much. The holdoff is how many segments to wait before applying another correction. If threshold
+ *  Since the following_error is running up to STEP_PREP_QUEUE_SIZE+1 segments behind the current segment
+ *  you have to be careful not to overcompensate. The threshold determines if a correction should be applied,
+ *  and the factor is how much. The holdoff is how many segments to wait before applying another correction. If threshold
  *  is too small and/or amount too large and/or holdoff is too small you may get a runaway correction
  *  and error will grow instead of shrink (or oscillate).
  */
@@ -330,6 +387,10 @@ typedef enum {
 #define STEP_CORRECTION_MAX         (float)0.60     // max step correction allowed in a single segment
 #define STEP_CORRECTION_HOLDOFF            5        // minimum number of segments to wait between error correction
 
+#if (STEP_CORRECTION_HOLDOFF <= STEP_PREP_QUEUE_SIZE)
+#error STEP_CORRECTION_HOLDOFF must be longer than the prep queue or corrections are applied twice
+#endif
+
 /*
  * Stepper control structures
  *
@@ -339,7 +400,7 @@ typedef enum {
  *    mpBuffer planning buffers (bf)    planner.c       main loop
  *    mrRuntimeSingleton (mr)           planner.c      MED ISR
  *    stConfig (st_cfg)                 stepper.c      write=bkgd, read=ISRs
- *    stPrepSingleton (st_pre)          stepper.c      MED ISR
+ *    stPrepSingleton (st_pre)          stepper.c      MED ISR (queue slots read by HI ISR)
  *    stRunSingleton (st_run)           tepper.c       HI ISR
  *
  *  Care has been taken to isolate actions on these structures to the execution level
@@ -375,6 +436,7 @@ typedef struct stRunMotor {                 // one per controlled motor
     uint32_t substep_increment;             // total steps in axis times substeps factor
     int32_t substep_accumulator;            // DDA phase angle accumulator
     bool motor_flag;                        // true if motor is participating in this move
+    uint8_t prev_direction;                 // travel direction of the last segment loaded for this motor
     uint32_t power_systick;                 // sys_tick for next motor power state transition
     float power_level_dynamic;              // power level for this segment of idle
 } stRunMotor_t;
@@ -388,37 +450,48 @@ typedef struct stRunSingleton {             // Stepper static values and axis pa
     magic_t magic_end;
 } stRunSingleton_t;
 
-// Motor prep structure. Used by exec/prep ISR (MED) and read-only during load
-// Must be careful about volatiles in this one
+// Prep queue structures. Slots are written by exec/prep ISR (MED) and read-only during load
 
-typedef struct stPrepMotor {
+typedef struct stPrepSegmentMotor {         // one per controlled motor in each queue slot
     uint32_t substep_increment;             // total steps in axis times substep factor
-    bool motor_flag;                        // true if motor is participating in this move
-
-    // direction and direction change
     uint8_t direction;                      // travel direction corrected for polarity (CW==0. CCW==1)
-    uint8_t prev_direction;                 // travel direction from previous segment run for this motor
     int8_t step_sign;                       // set to +1 or -1 for encoders
+    uint8_t accumulator_correction_flag;    // signals accumulator needs correction
+    float accumulator_correction;           // factor for adjusting accumulator between segments
+} stPrepSegmentMotor_t;
+
+typedef struct stPrepSegment {              // one prep queue slot
+    blockType block_type;                   // move type (requires planner.h)
+    struct mpBuffer *bf;                    // static pointer to relevant buffer (commands)
+
+    uint32_t dda_ticks;                     // DDA ticks for the move
+    uint32_t dwell_ticks;                   // dwell ticks remaining
+    uint32_t dda_ticks_X_substeps;          // DDA ticks scaled by substep factor
+    float commanded_steps[MOTORS];          // step position the segment starts from (for the following error)
+    stPrepSegmentMotor_t mot[MOTORS];
+} stPrepSegment_t;
+
+// Motor prep state carried from segment to segment. Used by exec/prep ISR (MED) only
 
+typedef struct stPrepMotor {
     // following error correction
     int32_t correction_holdoff;             // count down segments between corrections
     float corrected_steps;                  // accumulated correction steps for the cycle (for diagnostic display only)
 
     // accumulator phase correction
-    float prev_segment_time;                // segment time from previous segment run for this motor
-    float accumulator_correction;           // factor for adjusting accumulator between segments
-    uint8_t accumulator_correction_flag;    // signals accumulator needs correction
+    float prev_segment_time;                // segment time from previous segment prepped for this motor
+
+    // integer steps (see DDA integer steps)
+    int32_t step_position;                  // whole step the last prepped segment ends on
 } stPrepMotor_t;
 
 typedef struct stPrepSingleton {
     magic_t magic_start;                    // magic number to test memory integrity
-    volatile prepBufferState buffer_state;  // prep buffer state - owned by exec or loader
-    struct mpBuffer *bf;                    // static pointer to relevant buffer
-    blockType block_type;                   // move type (requires planner.h)
-
-    uint32_t dda_ticks;                     // DDA ticks for the move
-    uint32_t dwell_ticks;                   // dwell ticks remaining
-    uint32_t dda_ticks_X_substeps;          // DDA ticks scaled by substep factor
+    volatile uint8_t head;                  // next slot the exec writes  (written by exec only)
+    volatile uint8_t tail;                  // next slot the loader reads (written by loader only)
+    volatile bool sync_pending;             // a command or dwell is queued - don't run the exec ahead of it
+    volatile bool cycle_end_pending;        // end the cycle once the queue drains - see st_prep_cycle_end()
+    stPrepSegment_t seg[STEP_PREP_QUEUE_SIZE]; // the prep queue
     stPrepMotor_t mot[MOTORS];              // prep time motor structs
     magic_t magic_end;
 } stPrepSingleton_t;
@@ -575,9 +648,9 @@ void st_request_load_move(void);
 void st_prep_null(void);
 void st_prep_command(void *bf);        // use a void pointer since we don't know about mpBuf_t yet)
 void st_prep_dwell(float microseconds);
+void st_prep_cycle_end(void);
 void st_request_out_of_band_dwell(float microseconds);
-//stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time);
-stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time);
+stat_t st_prep_line(const float commanded_steps[], float travel_steps[], float following_error[], float segment_time);
 
 stat_t st_set_ma(nvObj_t *nv);
 stat_t st_set_sa(nvObj_t *nv);
@@ -113,7 +113,9 @@ using std::max;
 template <typename T>
 inline T square(const T x) { return (x)*(x); }        /* UNSAFE */
 
+#ifndef __POSIX_SIM__              // the host C++ library already provides abs(float)
 inline float abs(const float a) { return fabs(a); }
+#endif
 
 #ifndef avg
 template <typename T>